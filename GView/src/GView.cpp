@@ -1,5 +1,8 @@
 #include "../GViewCore/include/GView.hpp"
+#include <atomic>
+#include <iomanip>
 #include <iostream>
+#include <thread>
 
 enum class CommandID
 {
@@ -8,7 +11,8 @@ enum class CommandID
     Open,
     Reset,
     ListTypes,
-    UpdateConfig
+    UpdateConfig,
+    Analyze
 };
 
 struct CommandInfo
@@ -37,6 +41,7 @@ CommandInfo commands[] = {
     { CommandID::Reset, _U("reset") },
     { CommandID::ListTypes, _U("list-types") },
     { CommandID::UpdateConfig, _U("updateconfig") },
+    { CommandID::Analyze, _U("analyze") },
 };
 
 std::string_view help = R"HELP(
@@ -61,11 +66,22 @@ Where <command> is on of:
 
    list-types             List all available types (as loaded from gview.ini).
                           Ex: 'GView list-types' 
+                          Use '--timings [files]' to load all plugins and show how
+                          long each one takes to load and to validate the given
+                          files (type identification cost).
+                          Ex: 'GView list-types --timings a.exe b.zip' 
+
+   analyze [fileName|path] Identifies and parses one or multiple files (folders
+                          are scanned recursively) without starting the user
+                          interface and prints their properties.
+                          Ex: 'GView analyze a.exe samples/ --json'
 And <options> are:
    --type:<type>          Specify the type of the file (if knwon)
                           Ex: 'GView open a.temp --type:PE'    
    --selectType           Specify the type of the file should be manually selected
                           Ex: 'GView open a.temp --selectType'   
+   --json                 (analyze) Print the results as a JSON array
+   --threads:<count>      (analyze) Number of worker threads (default: one per CPU core)
 )HELP";
 
 void ShowHelp()
@@ -90,18 +106,287 @@ CommandID GetCommandID(T name)
     return CommandID::Unknown;
 }
 
-bool ListTypes()
+void ShowPluginTimings()
+{
+    std::vector<GView::App::PluginTimings> types, generics;
+    types.resize(GView::App::GetTypePluginsCount());
+    for (auto index = 0U; index < types.size(); index++)
+        GView::App::GetTypePluginTimings(index, types[index]);
+    generics.resize(GView::App::GetGenericPluginsCount());
+    for (auto index = 0U; index < generics.size(); index++)
+        GView::App::GetGenericPluginTimings(index, generics[index]);
+
+    // most expensive plugins first
+    const auto Cost = [](const GView::App::PluginTimings& t) { return t.loadTime + t.validateTime; };
+    std::sort(types.begin(), types.end(), [&](const auto& a, const auto& b) { return Cost(a) > Cost(b); });
+    std::sort(generics.begin(), generics.end(), [&](const auto& a, const auto& b) { return Cost(a) > Cost(b); });
+
+    const auto PrintTime = [](uint64 microseconds) { std::cout << std::right << std::setw(12) << std::fixed << std::setprecision(3) << (microseconds / 1000.0); };
+    std::cout << "Types : " << types.size() << std::endl;
+    std::cout << " " << std::left << std::setw(15) << "Name" << std::right << std::setw(12) << "Load (ms)" << std::setw(16) << "Validate (ms)"
+              << std::setw(8) << "Calls" << std::endl;
+    for (const auto& t : types)
+    {
+        std::cout << " " << std::left << std::setw(15) << t.name;
+        if (!t.loaded)
+        {
+            std::cout << std::right << std::setw(12) << "failed" << std::endl;
+            continue;
+        }
+        PrintTime(t.loadTime);
+        std::cout << "    ";
+        PrintTime(t.validateTime);
+        std::cout << std::right << std::setw(8) << t.validateCalls << std::endl;
+    }
+    std::cout << "Generic plugins : " << generics.size() << std::endl;
+    for (const auto& t : generics)
+    {
+        std::cout << " " << std::left << std::setw(15) << t.name;
+        if (!t.loaded)
+        {
+            std::cout << std::right << std::setw(12) << "failed" << std::endl;
+            continue;
+        }
+        PrintTime(t.loadTime);
+        std::cout << std::endl;
+    }
+}
+
+template <typename T>
+int ListTypes(int argc, T** argv, int startIndex)
+{
+    LocalString<128> tempString;
+    auto timings = false;
+    std::vector<std::filesystem::path> samples;
+    for (auto start = startIndex; start < argc; start++)
+    {
+        if (argv[start][0] != '-')
+        {
+            samples.emplace_back(argv[start]);
+            continue;
+        }
+        // options are always in ASCII format
+        tempString.Clear();
+        const T* p = argv[start];
+        while ((*p))
+        {
+            tempString.AddChar(static_cast<char>(*p));
+            p++;
+        }
+        if (tempString.Equals("--timings", true))
+        {
+            timings = true;
+            continue;
+        }
+        std::cout << "Unknwon option: " << tempString.ToStringView() << std::endl;
+        return 1;
+    }
+
+    // the list of types is printed on the console => no need for the user interface
+    CHECK(GView::App::InitHeadless(), 1, "");
+    if (!timings)
+    {
+        auto cnt = GView::App::GetTypePluginsCount();
+        std::cout << "Types : " << cnt << std::endl;
+        for (auto index = 0U; index < cnt; index++)
+        {
+            auto name = GView::App::GetTypePluginName(index);
+            auto desc = GView::App::GetTypePluginDescription(index);
+            std::cout << " " << std::left << std::setw(15) << name << desc << std::endl;
+        }
+        return 0;
+    }
+
+    CHECK(GView::App::PreloadPlugins(), 1, "");
+    for (const auto& sample : samples)
+    {
+        if (!GView::App::ValidateWithAllTypePlugins(sample))
+            std::cout << "Unable to read: " << sample.string() << std::endl;
+    }
+    ShowPluginTimings();
+    return 0;
+}
+
+void WriteJSONString(std::ostream& out, std::string_view text)
+{
+    out << '"';
+    for (auto ch : text)
+    {
+        switch (ch)
+        {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\r':
+            out << "\\r";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if (static_cast<uint8>(ch) < 0x20)
+            {
+                LocalString<8> tmp;
+                out << tmp.Format("\\u%04X", static_cast<uint8>(ch));
+            }
+            else
+                out << ch;
+            break;
+        }
+    }
+    out << '"';
+}
+
+void WriteAnalysisReport(std::ostream& out, const std::filesystem::path& path, const GView::App::AnalysisReport& report, bool json)
 {
-    CHECK(GView::App::Init(), false, "");
-    auto cnt = GView::App::GetTypePluginsCount();
-    std::cout << "Types : " << cnt << std::endl;
-    for (auto index = 0U; index < cnt; index++)
+    const auto u8path = path.u8string();
+    const std::string_view fileName{ reinterpret_cast<const char*>(u8path.data()), u8path.size() };
+    if (!json)
+    {
+        out << fileName << std::endl;
+        out << "   " << std::left << std::setw(24) << "Type" << report.type << std::endl;
+        out << "   " << std::left << std::setw(24) << "Size" << report.size << std::endl;
+        for (const auto& [name, value] : report.properties)
+            out << "   " << std::left << std::setw(24) << name << value << std::endl;
+        if (!report.error.empty())
+            out << "   " << std::left << std::setw(24) << "Error" << report.error << std::endl;
+        return;
+    }
+    out << "{\"file\":";
+    WriteJSONString(out, fileName);
+    out << ",\"type\":";
+    WriteJSONString(out, report.type);
+    out << ",\"size\":" << report.size << ",\"properties\":{";
+    for (size_t idx = 0; idx < report.properties.size(); idx++)
     {
-        auto name = GView::App::GetTypePluginName(index);
-        auto desc = GView::App::GetTypePluginDescription(index);
-        std::cout << " " << std::left << std::setw(15) << name << desc << std::endl;
+        if (idx > 0)
+            out << ",";
+        WriteJSONString(out, report.properties[idx].first);
+        out << ":";
+        WriteJSONString(out, report.properties[idx].second);
     }
-    return true;
+    out << "}";
+    if (!report.error.empty())
+    {
+        out << ",\"error\":";
+        WriteJSONString(out, report.error);
+    }
+    out << "}";
+}
+
+template <typename T>
+int ProcessAnalyzeCommand(int argc, T** argv, int startIndex)
+{
+    LocalString<128> tempString;
+    LocalString<16> type;
+    auto json    = false;
+    auto workers = std::max<uint32>(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::filesystem::path> files;
+
+    for (auto start = startIndex; start < argc; start++)
+    {
+        if (argv[start][0] != '-')
+        {
+            // folders are expanded (recursively) into the list of files to analyze
+            std::error_code ec;
+            const std::filesystem::path path{ argv[start] };
+            if (std::filesystem::is_directory(path, ec))
+            {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(path, std::filesystem::directory_options::skip_permission_denied, ec))
+                {
+                    if (entry.is_regular_file(ec))
+                        files.push_back(entry.path());
+                }
+            }
+            else
+            {
+                files.push_back(path);
+            }
+            continue;
+        }
+        // options are always in ASCII format
+        tempString.Clear();
+        const T* p = argv[start];
+        while ((*p))
+        {
+            tempString.AddChar(static_cast<char>(*p));
+            p++;
+        }
+        if (tempString.StartsWith("--type:", true))
+        {
+            type.Set(tempString.ToStringView().substr(7));
+            continue;
+        }
+        if (tempString.Equals("--json", true))
+        {
+            json = true;
+            continue;
+        }
+        if (tempString.StartsWith("--threads:", true))
+        {
+            auto value = Number::ToUInt32(tempString.ToStringView().substr(10));
+            if (!value.has_value() || value.value() == 0)
+            {
+                std::cout << "Invalid number of threads: " << tempString.ToStringView() << std::endl;
+                return 1;
+            }
+            workers = value.value();
+            continue;
+        }
+        std::cout << "Unknwon option: " << tempString.ToStringView() << std::endl;
+        std::cout << "Type 'GView help' for a detailed list of available options" << std::endl;
+        return 1;
+    }
+    if (files.empty())
+    {
+        std::cout << "No files to analyze !" << std::endl;
+        return 1;
+    }
+    if (!GView::App::InitHeadless())
+    {
+        std::cout << "Fail to initialize GView (check the configuration file or use 'GView reset')" << std::endl;
+        return 1;
+    }
+
+    // every worker picks the next file from the list, results are printed in the original order
+    std::vector<GView::App::AnalysisReport> reports(files.size());
+    std::atomic<size_t> next{ 0 };
+    std::atomic<uint32> failed{ 0 };
+    const auto typeName = std::string{ type.ToStringView() };
+    const auto Worker   = [&]()
+    {
+        for (auto idx = next++; idx < files.size(); idx = next++)
+        {
+            if (!GView::App::Analyze(files[idx], reports[idx], typeName))
+                failed++;
+        }
+    };
+    workers = std::min<uint32>(workers, static_cast<uint32>(files.size()));
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (auto idx = 0U; idx < workers; idx++)
+        pool.emplace_back(Worker);
+    for (auto& t : pool)
+        t.join();
+
+    if (json)
+        std::cout << "[";
+    for (size_t idx = 0; idx < files.size(); idx++)
+    {
+        if (json && idx > 0)
+            std::cout << ",";
+        WriteAnalysisReport(std::cout, files[idx], reports[idx], json);
+    }
+    if (json)
+        std::cout << "]" << std::endl;
+
+    return failed > 0 ? 2 : 0;
 }
 
 template <typename T>
@@ -179,10 +464,11 @@ int main(int argc, const char** argv)
         GView::App::ResetConfiguration();
         return 0;
     case CommandID::ListTypes:
-        ListTypes();
-        return 0;
+        return ListTypes(argc, argv, 2);
     case CommandID::Open:
         return ProcessOpenCommand(argc, argv, 2);
+    case CommandID::Analyze:
+        return ProcessAnalyzeCommand(argc, argv, 2);
     case CommandID::Unknown:
         return ProcessOpenCommand(argc, argv, 1);
     default:
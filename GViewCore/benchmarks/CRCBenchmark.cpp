@@ -0,0 +1,109 @@
+#include "../src/Hashes/CRC.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Compares the throughput of the CRC kernels (bytewise, slice-by-N and carry-less multiplication) and checks that all of
+// them produce the same CRC. Usage: CRCBenchmark [size in MB] [iterations]
+using namespace GView::Hashes;
+
+constexpr size_t DEFAULT_SIZE_MB    = 64;
+constexpr uint32 DEFAULT_ITERATIONS = 5;
+constexpr uint32 CHECK_ROUNDS       = 2000; // random (size, alignment) pairs used by the correctness check
+constexpr size_t CHECK_MAX_SIZE     = 4096;
+
+struct KernelInfo {
+    CRC::Kernel kernel;
+    const char* name;
+};
+constexpr KernelInfo KERNELS[] = {
+    { CRC::Kernel::Bytewise, "bytewise" },
+    { CRC::Kernel::SliceBy, "slice-by-N" },
+    { CRC::Kernel::CarrylessMultiply, "pclmul" },
+};
+
+template <typename T>
+using UpdateFunction = T (*)(CRC::Kernel kernel, T crc, const uint8* input, size_t length);
+
+template <typename T>
+bool CheckKernels(const char* name, UpdateFunction<T> update, const std::vector<uint8>& data, std::mt19937_64& rng)
+{
+    std::uniform_int_distribution<size_t> sizes(0, CHECK_MAX_SIZE), offsets(0, 63);
+    for (uint32 round = 0; round < CHECK_ROUNDS; round++)
+    {
+        const auto* p    = data.data() + offsets(rng);
+        const auto size  = sizes(rng);
+        const auto split = size / 3; // a second update must continue from the first one
+        const T expected = update(CRC::Kernel::Bytewise, update(CRC::Kernel::Bytewise, 0, p, split), p + split, size - split);
+        for (const auto& k : KERNELS)
+        {
+            const T crc = update(k.kernel, update(k.kernel, 0, p, split), p + split, size - split);
+            if (crc != expected)
+            {
+                printf("%s: %s kernel mismatch for %zu bytes (0x%llX instead of 0x%llX)\n",
+                       name,
+                       k.name,
+                       size,
+                       (unsigned long long) crc,
+                       (unsigned long long) expected);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool Benchmark(const char* name, UpdateFunction<T> update, const std::vector<uint8>& data, uint32 iterations)
+{
+    T reference = 0;
+    for (const auto& k : KERNELS)
+    {
+        T crc     = 0;
+        auto best = std::chrono::duration<double>::max();
+        for (uint32 i = 0; i < iterations; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            crc              = update(k.kernel, 0, data.data(), data.size());
+            best             = std::min<>(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start));
+        }
+        if (k.kernel == CRC::Kernel::Bytewise)
+            reference = crc;
+        printf("%-6s %-12s %8.2f GB/s  CRC: 0x%.16llX%s\n",
+               name,
+               k.name,
+               static_cast<double>(data.size()) / best.count() / 1e9,
+               (unsigned long long) crc,
+               crc == reference ? "" : "  MISMATCH");
+        if (crc != reference)
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    const auto sizeMB     = argc > 1 ? static_cast<size_t>(std::max<>(atoi(argv[1]), 1)) : DEFAULT_SIZE_MB;
+    const auto iterations = argc > 2 ? static_cast<uint32>(std::max<>(atoi(argv[2]), 1)) : DEFAULT_ITERATIONS;
+
+    std::mt19937_64 rng(0x47566965);
+    std::vector<uint8> data(sizeMB << 20);
+    for (auto& b : data)
+        b = static_cast<uint8>(rng());
+
+    printf("Carry-less multiplication: %s\n", CRC::HasCarrylessMultiply() ? "supported" : "not supported (slice-by-N is used)");
+    auto ok = CheckKernels<uint16>("CRC16", CRC::Update16, data, rng) && CheckKernels<uint32>("CRC32", CRC::Update32, data, rng) &&
+              CheckKernels<uint64>("CRC64", CRC::Update64, data, rng);
+    printf("Kernels agree on %u random inputs: %s\n\n", CHECK_ROUNDS, ok ? "yes" : "no");
+
+    printf("%zu MB, best of %u iterations\n", sizeMB, iterations);
+    ok &= Benchmark<uint16>("CRC16", CRC::Update16, data, iterations);
+    ok &= Benchmark<uint32>("CRC32", CRC::Update32, data, iterations);
+    ok &= Benchmark<uint64>("CRC64", CRC::Update64, data, iterations);
+
+    return ok ? 0 : 1;
+}
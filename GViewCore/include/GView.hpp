@@ -4,6 +4,7 @@
 #define GVIEW_VERSION "0.360.0"
 
 #include <AppCUI/include/AppCUI.hpp>
+#include <functional>
 
 using namespace AppCUI::Controls;
 using namespace AppCUI::Utils;
@@ -62,6 +63,18 @@ struct CORE_EXPORT TypeInterface {
         return { 0, 0 };
     }
 
+    // used by the headless mode ('GView analyze') where no window/panel is created: parse the object and
+    // append its properties as (name, value) pairs. Returns false if the object could not be parsed.
+    // Types that implement 'Analyze' must also override 'IsAnalyzeSupported' (by default nothing is parsed).
+    virtual bool Analyze(std::vector<std::pair<std::string, std::string>>& /*properties*/)
+    {
+        return false;
+    }
+    virtual bool IsAnalyzeSupported() const
+    {
+        return false;
+    }
+
     template <typename T>
     Reference<T> To()
     {
@@ -96,40 +109,81 @@ namespace Utils
     };
     class CORE_EXPORT DataCache
     {
+      public:
+        struct Statistics {
+            uint64 hits;      // requests served from already cached pages
+            uint64 misses;    // requests that required a read from the data object
+            uint64 bytesRead; // total amount of bytes read from the data object
+            uint64 readAhead; // bytes that were served from the read-ahead buffers (instead of a blocking read)
+        };
+
+      private:
         AppCUI::OS::DataObject* fileObj;
         uint64 fileSize, start, end, currentPos;
-        uint8* cache;
+        uint8* cache;         // storage for all pages (pagesCount * PAGE_SIZE bytes)
+        const uint8* window;  // contiguous run of pages that holds [start, end) (or the entire mapped file)
+        void* pageTable;      // page descriptors and page index -> slot map
+        void* mapping;        // OS specific handles for a memory mapped file (nullptr in buffered mode)
         uint32 cacheSize;
+        Statistics stats;
 
         bool CopyObject(void* buffer, uint64 offset, uint32 requestedSize);
+        bool InitObject(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize);
+        bool AllocatePages();
+        bool MapFile(const std::filesystem::path& path);
+        bool ReadFromObject(uint64 offset, uint8* buffer, uint32 size);
 
       public:
+        static constexpr uint32 PAGE_SIZE = 0x10000; // 64 K
+
         DataCache();
         DataCache(DataCache&& obj);
         ~DataCache();
 
         bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize);
+        // same as above, but tries to memory map 'path' first (falls back to the buffered mode if mapping fails)
+        bool Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 cacheSize, const std::filesystem::path& path);
         BufferView Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead);
         inline BufferView GetEntireFile()
         {
+            if (mapping)
+                return BufferView(window, (size_t) fileSize);
             return fileSize < 0xFFFFFFFF ? Get(0, (uint32) fileSize, true) : BufferView();
         }
 
-        Buffer CopyToBuffer(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead = true);
+        // Reads [offset, offset + size) (clipped to the end of the file) as successive chunks of at most 'chunkSize' bytes
+        // (0 means half of the cache size) and calls 'callback' for each of them. The iteration stops when the callback
+        // returns false. Returns false only if a chunk could not be read.
+        using ChunkCallback = std::function<bool(uint64 chunkOffset, BufferView chunk)>;
+        bool ForEachChunk(uint64 offset, uint64 size, const ChunkCallback& callback, uint32 chunkSize = 0);
+
+        Buffer CopyToBuffer(uint64 offset, uint64 requestedSize, bool failIfRequestedSizeCanNotBeRead = true);
         inline Buffer CopyEntireFile(bool failIfRequestedSizeCanNotBeRead = true)
         {
-            return CopyToBuffer(0, (uint32) fileSize, failIfRequestedSizeCanNotBeRead);
+            return CopyToBuffer(0, fileSize, failIfRequestedSizeCanNotBeRead);
         }
         inline uint8 GetFromCache(uint64 offset, uint8 defaultValue = 0) const
         {
             if ((offset >= start) && (offset < end))
-                return cache[offset - start];
+                return window[offset - start];
             return defaultValue;
         }
         inline uint32 GetCacheSize() const
         {
             return cacheSize;
         }
+        inline bool IsMemoryMapped() const
+        {
+            return mapping != nullptr;
+        }
+        inline const Statistics& GetStatistics() const
+        {
+            return stats;
+        }
+        inline void ResetStatistics()
+        {
+            stats = {};
+        }
 
         inline uint64 GetSize() const
         {
@@ -150,7 +204,30 @@ namespace Utils
             return CopyObject(&object, offset, sizeof(T));
         }
 
-        bool WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint32 size);
+        bool WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint64 size);
+
+        // Read-ahead mode for sequential scans: while active, every miss also schedules the read of the data that follows
+        // it on a background thread (double buffered), so processing chunk N overlaps with reading chunk N+1.
+        // Calls can be nested (the mode stays active until the last StopReadAhead).
+        void StartReadAhead();
+        void StopReadAhead();
+
+        class ReadAheadScope
+        {
+            DataCache& cache;
+
+          public:
+            ReadAheadScope(DataCache& c) : cache(c)
+            {
+                cache.StartReadAhead();
+            }
+            ~ReadAheadScope()
+            {
+                cache.StopReadAhead();
+            }
+            ReadAheadScope(const ReadAheadScope&)            = delete;
+            ReadAheadScope& operator=(const ReadAheadScope&) = delete;
+        };
     };
 
     enum class DemangleKind : uint8 {
@@ -190,17 +267,79 @@ namespace Utils
 
       public:
         ZonesList();
+        ZonesList(const ZonesList& other);
+        ZonesList& operator=(const ZonesList& other);
         ~ZonesList();
 
         bool Add(uint64 start, uint64 end, AppCUI::Graphics::ColorPair c, std::string_view txt);
         bool Add(const Zone& zone);
+        // lookups rebuild the segment index after Add and cache the last hit => not safe to call from multiple threads
         std::optional<Zone> OffsetToZone(uint64 offset) const;
+        // reports (in order) every part of the interval that is covered by a zone, with the zone that paints it
+        bool ForEachInInterval(const Zone::Interval& interval, const std::function<bool(uint64 low, uint64 high, const Zone& zone)>& callback) const;
         bool SetCache(const Zone::Interval& interval);
         void Clear();
         uint32 GetCount() const;
         std::optional<Zone> GetZone(uint32 index) const;
     };
 
+    // Finds runs of ASCII / UTF-16LE characters that belong to a 256 entries character mask. Bytes are classified a block
+    // at a time (SSE2 range compares when the mask is made of a few intervals, a lookup table otherwise) and runs are
+    // measured on the resulting bitmaps, so this is the shared kernel for string highlighting, string dumps and filters.
+    class CORE_EXPORT StringsExtractor
+    {
+      public:
+        static constexpr uint32 MAX_RANGES = 4;
+        enum class StringType : uint8 {
+            Ascii,
+            Unicode
+        };
+        // [start, end) are absolute offsets (bytes); return false to stop the search
+        using RunCallback = std::function<bool(uint64 start, uint64 end, StringType type)>;
+
+      private:
+        bool mask[256];
+        uint8 ranges[MAX_RANGES][2];
+        uint32 rangesCount; // 0 => mask can not be expressed as MAX_RANGES intervals (use the table)
+
+      public:
+        StringsExtractor(); // printable ASCII (0x20 - 0x7E) and TAB
+        void SetMask(const bool newMask[256]);
+        void SetMask(uint8 from, uint8 to);
+        inline bool IsStringChar(uint8 ch) const
+        {
+            return mask[ch];
+        }
+
+        // number of consecutive bytes (from the start of the buffer) that are part of the mask
+        uint32 GetAsciiLength(BufferView buffer, uint32 maxLength = 0xFFFFFFFF) const;
+        // number of consecutive UTF-16LE characters (mask character followed by 0) from the start of the buffer
+        uint32 GetUnicodeLength(BufferView buffer, uint32 maxLength = 0xFFFFFFFF) const;
+
+        // reports every run of at least minLength characters (maxLength == 0 => no limit, longer runs are split).
+        // At a position an ASCII run is preferred over an UTF-16 one. If 'pending' is not null, runs (or partial
+        // candidates) that reach the end of the buffer are not reported and 'pending' receives the offset where the
+        // search must be resumed once more data is available. Returns false if the callback stopped the search.
+        bool Find(
+              BufferView buffer,
+              uint64 bufferOffset,
+              uint32 minLength,
+              uint32 maxLength,
+              bool ascii,
+              bool unicode,
+              const RunCallback& callback,
+              uint64* pending = nullptr) const;
+        bool Find(
+              GView::Utils::DataCache& cache,
+              uint64 offset,
+              uint64 size,
+              uint32 minLength,
+              uint32 maxLength,
+              bool ascii,
+              bool unicode,
+              const RunCallback& callback) const;
+    };
+
     struct CORE_EXPORT ObjectHighlightingZonesInterface {
         virtual uint32 GetObjectsZonesCount() const                    = 0;
         virtual std::optional<Zone> GetObjectsZone(uint32 index) const = 0;
@@ -630,6 +769,7 @@ namespace Decoding
     {
         CORE_EXPORT bool Decompress(const Buffer& input, uint64 inputSize, Buffer& output, uint64 outputSize);
         CORE_EXPORT bool DecompressStream(const BufferView& input, Buffer& output, String& message, uint64& sizeConsumed);
+        CORE_EXPORT bool DecompressStream(Utils::DataCache& cache, uint64 offset, uint64 size, Buffer& output, String& message, uint64& sizeConsumed);
     } // namespace ZLIB
 
     namespace ZIP
@@ -660,6 +800,7 @@ namespace Decoding
             bool GetEntry(uint32 index, Entry& entry) const;
             bool Decompress(Buffer& output, uint32 index, const std::string& password) const;
             bool Decompress(const BufferView& input, Buffer& output, uint32 index, const std::string& password) const;
+            bool Decompress(Utils::DataCache& cache, Buffer& output, uint32 index, const std::string& password) const;
 
             Info();
             ~Info();
@@ -799,6 +940,7 @@ namespace Regex
         ~Matcher();
 
         bool Match(BufferView buffer, uint64& start, uint64& end);
+        bool IsValid() const;
     };
 } // namespace Regex
 
@@ -806,6 +948,56 @@ namespace Entropy
 {
     CORE_EXPORT double ShannonEntropy(const BufferView& buffer);
     CORE_EXPORT double RenyiEntropy(const BufferView& buffer, double alpha);
+
+    // byte frequencies (64 bit counters) - Shannon and Renyi entropies are computed from the same counting pass
+    class CORE_EXPORT Histogram
+    {
+        uint64 counts[256];
+        uint64 total;
+
+      public:
+        Histogram();
+        void Reset();
+        void Add(const BufferView& buffer);
+        void Add(const Histogram& other); // merge (the histogram of two adjacent blocks)
+        inline void Add(uint8 value)
+        {
+            counts[value]++;
+            total++;
+        }
+        inline uint64 GetCount(uint8 value) const
+        {
+            return counts[value];
+        }
+        inline uint64 GetTotal() const
+        {
+            return total;
+        }
+        double ShannonEntropy() const;
+        double RenyiEntropy(double alpha) const;
+    };
+
+    // entropy of the last 'windowSize' bytes that were pushed; every byte that enters (and the one that leaves) the window
+    // updates both the Shannon and the Renyi (for the alpha given at construction) values in O(1)
+    class CORE_EXPORT SlidingWindow
+    {
+        void* context{ nullptr };
+
+      public:
+        SlidingWindow(uint32 windowSize, double renyiAlpha = 2.0);
+        SlidingWindow(const SlidingWindow&)            = delete;
+        SlidingWindow& operator=(const SlidingWindow&) = delete;
+        ~SlidingWindow();
+
+        void Reset();
+        void Push(uint8 value);
+        void Push(const BufferView& buffer);
+
+        uint32 GetWindowSize() const;
+        uint32 GetLength() const; // bytes currently in the window (less than windowSize until the window fills up)
+        double ShannonEntropy() const;
+        double RenyiEntropy() const;
+    };
 } // namespace Entropy
 
 /*
@@ -963,8 +1155,22 @@ namespace View
 
         struct CORE_EXPORT PositionToColorInterface {
             virtual bool GetColorForBuffer(uint64 offset, BufferView buf, BufferColor& result) = 0;
+
+            // Colors [offset, offset + size) at once: 'buf' starts at 'offset' and may hold a few more bytes (look-ahead).
+            // The colored spans are appended to 'spans' in order, without overlapping (a span may end after the range).
+            // Returns false if the range variant is not supported => GetColorForBuffer is called for every byte.
+            virtual bool GetColorsForRange(uint64 /*offset*/, uint64 /*size*/, BufferView /*buf*/, std::vector<BufferColor>& /*spans*/)
+            {
+                return false;
+            }
         };
 
+        // GetColorsForRange helper for the executable formats: walks [offset, offset + size) once, along with the 'zones'
+        // ([start, end) file offsets) that intersect it, and calls 'colorOpcode' for every position that may be colored.
+        // Positions outside the zones are checked (with executable = false) only if 'checkHeaders' is set.
+        using OpcodeColorCallback = std::function<bool(uint64 offset, BufferView buf, bool executable, BufferColor& result)>;
+        CORE_EXPORT void ColorRangeByZones(uint64 offset, uint64 size, BufferView buf, const std::vector<std::pair<uint64, uint64>>& zones, bool checkHeaders, const OpcodeColorCallback& colorOpcode, std::vector<BufferColor>& spans);
+
         struct CORE_EXPORT OffsetTranslateInterface {
             virtual uint64_t TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex) = 0;
             virtual uint64_t TranslateFromFileOffset(uint64 value, uint32 toTranslationIndex) = 0;
@@ -1522,6 +1728,30 @@ namespace App
     std::string_view CORE_EXPORT GetTypePluginDescription(uint32 index);
     uint32 CORE_EXPORT GetTypePluginsCount();
 
+    // headless mode (no terminal is initialized) - 'Analyze' can be called from multiple threads
+    struct AnalysisReport {
+        std::string type;  // name of the type plugin that was used
+        uint64 size{ 0 };  // size of the file
+        std::vector<std::pair<std::string, std::string>> properties;
+        std::string error; // empty if the analysis succeeded
+    };
+    bool CORE_EXPORT InitHeadless();
+    bool CORE_EXPORT Analyze(const std::filesystem::path& path, AnalysisReport& report, std::string_view typeName = "");
+
+    // plugin load/validation costs (all times are in microseconds)
+    struct PluginTimings {
+        std::string_view name;
+        uint64 loadTime{ 0 };
+        uint64 validateTime{ 0 }; // total time spent in 'Validate' (type plugins only)
+        uint32 validateCalls{ 0 };
+        bool loaded{ false };
+    };
+    bool CORE_EXPORT PreloadPlugins();
+    bool CORE_EXPORT ValidateWithAllTypePlugins(const std::filesystem::path& path);
+    bool CORE_EXPORT GetTypePluginTimings(uint32 index, PluginTimings& timings);
+    bool CORE_EXPORT GetGenericPluginTimings(uint32 index, PluginTimings& timings);
+    uint32 CORE_EXPORT GetGenericPluginsCount();
+
 }; // namespace App
 }; // namespace GView
 
@@ -80,7 +80,7 @@ Reference<GView::Object> FileWindow::GetObject()
 
 void FileWindow::ShowFilePropertiesDialog()
 {
-    FileWindowProperties dlg(view);
+    FileWindowProperties dlg(view, obj.get());
     dlg.Show();
 }
 void FileWindow::ShowGoToDialog()
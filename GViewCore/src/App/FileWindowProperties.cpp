@@ -6,11 +6,27 @@ using namespace GView::View;
 constexpr int32 BUTTON_ID_CLOSE = 1;
 constexpr int32 BUTTON_ID_GOTO  = 2;
 
-FileWindowProperties::FileWindowProperties(Reference<Tab> viewContainer) : Window("Properties", "d:c,w:78,h:24", WindowFlags::None)
+FileWindowProperties::FileWindowProperties(Reference<Tab> viewContainer, Reference<GView::Object> obj)
+    : Window("Properties", "d:c,w:78,h:24", WindowFlags::None)
 {
     auto t = Factory::Tab::Create(this, "l:1,t:1,r:1,b:3", TabFlags::LeftTabs | TabFlags::TabsBar);
 
-    Factory::TabPage::Create(t, "General");
+    auto tp_general = Factory::TabPage::Create(t, "General");
+    auto lv = Factory::ListView::Create(tp_general, "d:c", { "n:Field,w:16", "n:Value,w:100" }, ListViewFlags::HideSearchBar);
+
+    LocalString<128> tmp;
+    NumericFormatter n;
+    auto& cache       = obj->GetData();
+    const auto& stats = cache.GetStatistics();
+    lv->AddItem({ "Size", tmp.Format("%s bytes", n.ToString(cache.GetSize(), { NumericFormatFlags::None, 10, 3, ',' }).data()) });
+    lv->AddItem("Cache").SetType(ListViewItem::Type::Category);
+    lv->AddItem({ "Mode", cache.IsMemoryMapped() ? "Memory mapped" : "Buffered" });
+    lv->AddItem({ "Size", tmp.Format("%s bytes", n.ToString((uint64) cache.GetCacheSize(), { NumericFormatFlags::None, 10, 3, ',' }).data()) });
+    lv->AddItem({ "Page size", tmp.Format("%s bytes", n.ToString((uint64) GView::Utils::DataCache::PAGE_SIZE, { NumericFormatFlags::None, 10, 3, ',' }).data()) });
+    lv->AddItem({ "Hits", n.ToString(stats.hits, { NumericFormatFlags::None, 10, 3, ',' }) });
+    lv->AddItem({ "Misses", n.ToString(stats.misses, { NumericFormatFlags::None, 10, 3, ',' }) });
+    lv->AddItem({ "Bytes read", tmp.Format("%s bytes", n.ToString(stats.bytesRead, { NumericFormatFlags::None, 10, 3, ',' }).data()) });
+    lv->AddItem({ "Read ahead", tmp.Format("%s bytes", n.ToString(stats.readAhead, { NumericFormatFlags::None, 10, 3, ',' }).data()) });
 
     // process all view modes
     for (uint32 idx = 0; idx < viewContainer->GetChildrenCount(); idx++)
@@ -54,6 +54,47 @@ bool GView::App::Init()
     }
     return true;
 }
+bool GView::App::InitHeadless()
+{
+    gviewAppInstance = new GView::App::Instance();
+    if (!gviewAppInstance->InitHeadless())
+    {
+        delete gviewAppInstance;
+        gviewAppInstance = nullptr;
+        RETURNERROR(false, "Fail to initialize GView (headless mode)");
+    }
+    return true;
+}
+bool GView::App::Analyze(const std::filesystem::path& path, AnalysisReport& report, std::string_view typeName)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->Analyze(path, typeName, report);
+}
+bool GView::App::PreloadPlugins()
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->PreloadPlugins();
+}
+bool GView::App::ValidateWithAllTypePlugins(const std::filesystem::path& path)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->ValidateWithAllTypePlugins(path);
+}
+bool GView::App::GetTypePluginTimings(uint32 index, PluginTimings& timings)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->GetTypePluginTimings(index, timings);
+}
+bool GView::App::GetGenericPluginTimings(uint32 index, PluginTimings& timings)
+{
+    CHECK(gviewAppInstance, false, "GView was not initialized !");
+    return gviewAppInstance->GetGenericPluginTimings(index, timings);
+}
+uint32 GView::App::GetGenericPluginsCount()
+{
+    CHECK(gviewAppInstance, 0, "GView was not initialized !");
+    return gviewAppInstance->GetGenericPluginsCount();
+}
 void GView::App::Run()
 {
     if (gviewAppInstance)
@@ -97,7 +138,9 @@ bool GView::App::ResetConfiguration()
     }
 
     // generic GView settings
-    ini["GView"]["CacheSize"]        = DEFAULT_CACHE_SIZE;
+    ini["GView"]["CacheSize"]         = DEFAULT_CACHE_SIZE;
+    ini["GView"]["MemoryMappedFiles"] = true;
+    ini["GView"]["PreloadPlugins"]    = false;
 
     const std::array<std::reference_wrapper<KeyboardControl>, 6> localKeys = {
         InstanceCommands::INSTANCE_CHANGE_VIEW,     InstanceCommands::INSTANCE_SWITCH_TO_VIEW, InstanceCommands::INSTANCE_COMMAND_GOTO,
@@ -1,5 +1,7 @@
 #include "Internal.hpp"
 #include <array>
+#include <atomic>
+#include <thread>
 
 using namespace GView::App;
 using namespace GView::App::InstanceCommands;
@@ -68,14 +70,15 @@ bool AddMenuCommands(Menu* mnu, const GViewMenuCommand* list, size_t count)
 Instance::Instance()
 {
     this->defaultCacheSize         = DEFAULT_CACHE_SIZE;
+    this->memoryMappedFiles        = true;
+    this->preloadPlugins           = false;
     this->mnuWindow                = nullptr;
     this->mnuHelp                  = nullptr;
     this->mnuFile                  = nullptr;
     this->lastOpenedFolderLocation = ".";
 }
-bool Instance::LoadSettings()
+bool Instance::LoadSettings(AppCUI::Utils::IniObject* ini)
 {
-    auto ini = AppCUI::Application::GetAppSettings();
     CHECK(ini, false, "");
     CHECK(ini->GetSectionsCount() > 0, false, "");
     // check plugins
@@ -102,9 +105,17 @@ bool Instance::LoadSettings()
     // sort all plugins based on their priority
     std::sort(this->typePlugins.begin(), this->typePlugins.end());
 
+    // build the identification index (plugins are referred by their position in the sorted vector)
+    this->typePluginsIndex.Clear();
+    for (uint32 idx = 0; idx < static_cast<uint32>(this->typePlugins.size()); idx++) {
+        this->typePlugins[idx].AddToIndex(this->typePluginsIndex, idx);
+    }
+
     // read instance settings
     auto sect                                  = ini->GetSection("GView");
     this->defaultCacheSize                     = std::max<>(sect.GetValue("CacheSize").ToUInt32(DEFAULT_CACHE_SIZE), MIN_CACHE_SIZE);
+    this->memoryMappedFiles                    = sect.GetValue("MemoryMappedFiles").ToBool(true);
+    this->preloadPlugins                       = sect.GetValue("PreloadPlugins").ToBool(false);
 
     const std::array<std::reference_wrapper<KeyboardControl>, 6> localKeys = {
         InstanceCommands::INSTANCE_CHANGE_VIEW,     InstanceCommands::INSTANCE_SWITCH_TO_VIEW, InstanceCommands::INSTANCE_COMMAND_GOTO,
@@ -155,7 +166,7 @@ bool Instance::Init()
     CHECK(AppCUI::Application::Init(initData), false, "Fail to initialize AppCUI framework !");
     // reserve some space fo type
     this->typePlugins.reserve(128);
-    if (!LoadSettings()) {
+    if (!LoadSettings(AppCUI::Application::GetAppSettings())) {
         auto preservedSettingsNewPath = settingsPath;
         preservedSettingsNewPath.replace_extension(".ini.bak");
         std::filesystem::rename(settingsPath, preservedSettingsNewPath);
@@ -174,6 +185,9 @@ bool Instance::Init()
 
     CHECK(BuildMainMenus(), false, "Fail to create bundle menus !");
     this->defaultPlugin.Init();
+    if (this->preloadPlugins) {
+        this->pluginsPreload = std::async(std::launch::async, [this]() { LoadAllPlugins(); });
+    }
 
     // set up handlers
     auto dsk                 = AppCUI::Application::GetDesktop();
@@ -181,6 +195,95 @@ bool Instance::Init()
     dsk->Handlers()->OnStart = this;
     return true;
 }
+bool Instance::InitHeadless()
+{
+    const auto settingsPath = AppCUI::Application::GetAppSettingsFile();
+    if (!std::filesystem::exists(settingsPath)) {
+        CHECK(GView::App::ResetConfiguration(), false, "");
+    }
+    // the settings are read directly (AppCUI is not initialized in this mode)
+    AppCUI::Utils::IniObject ini;
+    CHECK(ini.CreateFromFile(settingsPath), false, "Fail to load settings from: %s", settingsPath.string().c_str());
+    this->typePlugins.reserve(128);
+    CHECK(LoadSettings(&ini), false, "Invalid configuration file (use 'GView reset' to create a new one)");
+    this->defaultPlugin.Init();
+    if (this->preloadPlugins) {
+        this->pluginsPreload = std::async(std::launch::async, [this]() { LoadAllPlugins(); });
+    }
+    return true;
+}
+bool Instance::Analyze(const std::filesystem::path& path, std::string_view typeName, AnalysisReport& report)
+{
+    report = {};
+    auto f = std::make_unique<AppCUI::OS::File>();
+    if (f->OpenRead(path) == false) {
+        report.error = "Fail to open file";
+        RETURNERROR(false, "Fail to open file: %s", path.u8string().c_str());
+    }
+
+    const auto filePath = path.u16string();
+    const auto fileName = path.filename().u16string();
+    GView::Utils::DataCache cache;
+    if (this->memoryMappedFiles) {
+        CHECK(cache.Init(std::move(f), this->defaultCacheSize, path), false, "Fail to instantiate cache object");
+    } else {
+        CHECK(cache.Init(std::move(f), this->defaultCacheSize), false, "Fail to instantiate cache object");
+    }
+    report.size = cache.GetSize();
+
+    const auto ext     = path.extension().u16string();
+    const auto extHash = GView::Type::Plugin::ExtensionToHash(std::u16string_view{ ext });
+
+    Reference<GView::Type::Plugin> plg;
+    {
+        // plugins are loaded (and marked as loaded/invalid) during identification
+        std::lock_guard<std::mutex> lock(this->identifyLock);
+        WaitForPluginsPreload();
+        if (typeName.empty()) {
+            std::u16string newName{ fileName };
+            plg = IdentifyTypePlugin(std::u16string_view{ fileName }, std::u16string_view{ filePath }, cache, extHash, OpenMethod::FirstMatch, "", newName);
+        } else {
+            auto buf    = cache.Get(0, 0x8800, false);
+            auto bomLen = 0U;
+            auto enc    = GView::Utils::CharacterEncoding::AnalyzeBufferForEncoding(buf, true, bomLen);
+            auto text   = enc != GView::Utils::CharacterEncoding::Encoding::Binary ? GView::Utils::CharacterEncoding::ConvertToUnicode16(buf)
+                                                                                  : GView::Utils::UnicodeString();
+            auto tp     = GView::Type::Matcher::TextParser(text.text, text.size);
+            for (auto& pType : this->typePlugins) {
+                if ((pType.GetName().size() == typeName.size()) && (AppCUI::Utils::String::StartsWith(pType.GetName(), typeName, true))) {
+                    if (pType.IsOfType(buf, tp))
+                        plg = &pType;
+                    break;
+                }
+            }
+        }
+    }
+    if (plg.IsValid() == false) {
+        report.error = "File can not be matched with the requested type";
+        RETURNERROR(false, "Unable to match %s with type: %.*s", path.u8string().c_str(), (int) typeName.size(), typeName.data());
+    }
+    report.type = plg->GetName();
+
+    auto contentType = plg->CreateInstance();
+    if (contentType == nullptr) {
+        report.error = "'CreateInstance' returned a null pointer to a content type object";
+        RETURNERROR(false, "'CreateInstance' returned a null pointer to a content type object !");
+    }
+    if (contentType->IsAnalyzeSupported() == false) {
+        delete contentType;
+        report.error = "Headless analysis is not supported by this type";
+        RETURNERROR(false, "Type %.*s does not support headless analysis", (int) report.type.size(), report.type.data());
+    }
+    bool result;
+    {
+        GView::Object obj(GView::Object::Type::File, std::move(cache), contentType, std::u16string_view{ fileName }, std::u16string_view{ filePath }, 0);
+        result = contentType->Analyze(report.properties);
+    }
+    delete contentType;
+    if (!result)
+        report.error = "Fail to parse the file";
+    return result;
+}
 Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_WithSelectedType(
       const AppCUI::Utils::ConstString& name,
       const AppCUI::Utils::ConstString& path,
@@ -246,20 +349,20 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_FirstMatch(
 {
     // check for extension first
     if (extensionHash != 0) {
-        for (auto& pType : this->typePlugins) {
-            if (pType.MatchExtension(extensionHash)) {
-                if (pType.IsOfType(buf, textParser, extension))
-                    return &pType;
-            }
+        for (auto idx : this->typePluginsIndex.GetExtensionCandidates(extensionHash)) {
+            auto& pType = this->typePlugins[idx];
+            if (pType.IsOfType(buf, textParser, extension))
+                return &pType;
         }
     }
 
     // check the content
-    for (auto& pType : this->typePlugins) {
-        if (pType.MatchContent(buf, textParser)) {
-            if (pType.IsOfType(buf, textParser))
-                return &pType;
-        }
+    std::vector<uint32> candidates;
+    this->typePluginsIndex.GetContentCandidates(buf, textParser, this->typePlugins, candidates);
+    for (auto idx : candidates) {
+        auto& pType = this->typePlugins[idx];
+        if (pType.IsOfType(buf, textParser))
+            return &pType;
     }
 
     // nothing matched => return the default plugin
@@ -277,21 +380,8 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_BestMatch(
     auto plg   = &this->defaultPlugin;
     auto count = 0;
     if (extensionHash != 0) {
-        for (auto& pType : this->typePlugins) {
-            if (pType.MatchExtension(extensionHash)) {
-                if (pType.IsOfType(buf, textParser)) {
-                    count++;
-                    plg = &pType;
-                    if (count > 1) // at least two options
-                        return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash, newName);
-                }
-            }
-        }
-    }
-
-    // check the content
-    for (auto& pType : this->typePlugins) {
-        if (pType.MatchContent(buf, textParser)) {
+        for (auto idx : this->typePluginsIndex.GetExtensionCandidates(extensionHash)) {
+            auto& pType = this->typePlugins[idx];
             if (pType.IsOfType(buf, textParser)) {
                 count++;
                 plg = &pType;
@@ -301,6 +391,19 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin_BestMatch(
         }
     }
 
+    // check the content
+    std::vector<uint32> candidates;
+    this->typePluginsIndex.GetContentCandidates(buf, textParser, this->typePlugins, candidates);
+    for (auto idx : candidates) {
+        auto& pType = this->typePlugins[idx];
+        if (pType.IsOfType(buf, textParser)) {
+            count++;
+            plg = &pType;
+            if (count > 1) // at least two options
+                return IdentifyTypePlugin_Select(name, path, dataSize, buf, textParser, extensionHash, newName);
+        }
+    }
+
     // nothing matched => return the default plugin
     return plg;
 }
@@ -313,6 +416,7 @@ Reference<GView::Type::Plugin> Instance::IdentifyTypePlugin(
       std::string_view typeName,
       std::u16string& newName)
 {
+    WaitForPluginsPreload();
     auto buf    = cache.Get(0, 0x8800, false);
     auto bomLen = 0U;
     auto enc    = GView::Utils::CharacterEncoding::AnalyzeBufferForEncoding(buf, true, bomLen);
@@ -369,12 +473,19 @@ bool Instance::Add(
         }
     }
 
-    GView::Utils::DataCache cache;
-    CHECK(cache.Init(std::move(data), this->defaultCacheSize), false, "Fail to instantiate cache object");
-
     // extract extension
     LocalUnicodeStringBuilder<256> temp;
     CHECK(temp.Set(path), false, "Fail to get path object");
+
+    GView::Utils::DataCache cache;
+    if ((objType == GView::Object::Type::File) && (this->memoryMappedFiles)) {
+        // local files are memory mapped (the cache falls back to buffered reads if mapping is not possible)
+        const std::filesystem::path filePath{ std::u16string{ temp.ToStringView() } };
+        CHECK(cache.Init(std::move(data), this->defaultCacheSize, filePath), false, "Fail to instantiate cache object");
+    } else {
+        CHECK(cache.Init(std::move(data), this->defaultCacheSize), false, "Fail to instantiate cache object");
+    }
+
     // search for the last "."
     auto pos = temp.ToStringView().find_last_of('.');
     auto extHash =
@@ -530,6 +641,86 @@ std::string_view Instance::GetTypePluginDescription(uint32 index)
         return "";
     return this->typePlugins[index].GetDescription();
 }
+void Instance::LoadAllPlugins()
+{
+    // every plugin is loaded by exactly one worker (the plugin objects are not shared between threads)
+    const auto typesCount = this->typePlugins.size();
+    const auto count      = typesCount + this->genericPlugins.size();
+    std::atomic<size_t> next{ 0 };
+    const auto Worker = [&]() {
+        for (auto idx = next++; idx < count; idx = next++) {
+            if (idx < typesCount)
+                this->typePlugins[idx].Load();
+            else
+                this->genericPlugins[idx - typesCount].Load();
+        }
+    };
+    const auto workers = std::min<size_t>(std::max<size_t>(std::thread::hardware_concurrency(), 1), count);
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (size_t idx = 0; idx < workers; idx++)
+        pool.emplace_back(Worker);
+    for (auto& t : pool)
+        t.join();
+}
+void Instance::WaitForPluginsPreload()
+{
+    if (this->pluginsPreload.valid())
+        this->pluginsPreload.get();
+}
+bool Instance::PreloadPlugins()
+{
+    WaitForPluginsPreload();
+    LoadAllPlugins();
+    return true;
+}
+bool Instance::ValidateWithAllTypePlugins(const std::filesystem::path& path)
+{
+    WaitForPluginsPreload();
+    auto f = std::make_unique<AppCUI::OS::File>();
+    CHECK(f->OpenRead(path), false, "Fail to open file: %s", path.u8string().c_str());
+    GView::Utils::DataCache cache;
+    CHECK(cache.Init(std::move(f), this->defaultCacheSize), false, "Fail to instantiate cache object");
+
+    // same buffer/text that is used during identification
+    auto buf    = cache.Get(0, 0x8800, false);
+    auto bomLen = 0U;
+    auto enc    = GView::Utils::CharacterEncoding::AnalyzeBufferForEncoding(buf, true, bomLen);
+    auto text =
+          enc != GView::Utils::CharacterEncoding::Encoding::Binary ? GView::Utils::CharacterEncoding::ConvertToUnicode16(buf) : GView::Utils::UnicodeString();
+    auto tp        = GView::Type::Matcher::TextParser(text.text, text.size);
+    auto extension = path.extension().string();
+    for (auto& pType : this->typePlugins) {
+        pType.IsOfType(buf, tp, extension);
+    }
+    return true;
+}
+bool Instance::GetTypePluginTimings(uint32 index, PluginTimings& timings)
+{
+    CHECK(index < this->typePlugins.size(), false, "Invalid type plugin index: %u", index);
+    const auto& p         = this->typePlugins[index];
+    timings.name          = p.GetName();
+    timings.loaded        = p.IsLoaded();
+    timings.loadTime      = p.GetLoadTime();
+    timings.validateTime  = p.GetValidateTime();
+    timings.validateCalls = p.GetValidateCalls();
+    return true;
+}
+bool Instance::GetGenericPluginTimings(uint32 index, PluginTimings& timings)
+{
+    CHECK(index < this->genericPlugins.size(), false, "Invalid generic plugin index: %u", index);
+    const auto& p         = this->genericPlugins[index];
+    timings.name          = p.GetName();
+    timings.loaded        = p.IsLoaded();
+    timings.loadTime      = p.GetLoadTime();
+    timings.validateTime  = 0;
+    timings.validateCalls = 0;
+    return true;
+}
+uint32 Instance::GetGenericPluginsCount()
+{
+    return static_cast<uint32>(this->genericPlugins.size());
+}
 
 //===============================[APPCUI HANDLERS]==============================
 bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
@@ -567,7 +758,7 @@ bool Instance::OnEvent(Reference<Control> control, Event eventType, int ID)
         if ((ID >= GENERIC_PLUGINS_CMDID) && (ID < GENERIC_PLUGINS_CMDID + GENERIC_PLUGINS_FRAME * 1000)) {
             auto packedValue = ((uint32) ID) - GENERIC_PLUGINS_CMDID;
             // get current focused object
-
+            WaitForPluginsPreload();
             this->genericPlugins[packedValue / GENERIC_PLUGINS_FRAME].Run(packedValue % GENERIC_PLUGINS_FRAME, this->GetCurrentObject());
             return true;
         }
@@ -122,9 +122,123 @@ void ConvertZipFileInfoToEntry(const mz_zip_entry* zipFile, _Entry& entry)
     }
 }
 
+// read only minizip stream over a DataCache - lets the reader seek through the archive without
+// having the entire file in memory (and without the 4GB limit of mz_zip_reader_open_buffer)
+struct CacheStream
+{
+    mz_stream stream; // must be the first member (minizip casts the handle to mz_stream*)
+    Utils::DataCache* cache;
+    int64_t position;
+    bool opened;
+};
+
+static int32_t CacheStreamOpen(void* stream, const char* /*path*/, int32_t mode)
+{
+    auto cs = reinterpret_cast<CacheStream*>(stream);
+    if ((mode & MZ_OPEN_MODE_WRITE) || cs->cache == nullptr)
+        return MZ_OPEN_ERROR;
+    cs->position = 0;
+    cs->opened   = true;
+    return MZ_OK;
+}
+
+static int32_t CacheStreamIsOpen(void* stream)
+{
+    return reinterpret_cast<CacheStream*>(stream)->opened ? MZ_OK : MZ_OPEN_ERROR;
+}
+
+static int32_t CacheStreamRead(void* stream, void* buf, int32_t size)
+{
+    auto cs = reinterpret_cast<CacheStream*>(stream);
+    CHECK(size >= 0, MZ_PARAM_ERROR, "");
+
+    const auto fileSize = cs->cache->GetSize();
+    if ((uint64) cs->position >= fileSize || size == 0)
+        return 0;
+
+    const auto toRead = (uint64) std::min<uint64>((uint64) size, fileSize - cs->position);
+    auto p            = reinterpret_cast<uint8*>(buf);
+    CHECK(cs->cache->ForEachChunk(
+                (uint64) cs->position,
+                toRead,
+                [&p](uint64, BufferView chunk)
+                {
+                    memcpy(p, chunk.GetData(), chunk.GetLength());
+                    p += chunk.GetLength();
+                    return true;
+                }),
+          MZ_READ_ERROR,
+          "");
+
+    cs->position += toRead;
+    return (int32_t) toRead;
+}
+
+static int32_t CacheStreamWrite(void* /*stream*/, const void* /*buf*/, int32_t /*size*/)
+{
+    return MZ_WRITE_ERROR;
+}
+
+static int64_t CacheStreamTell(void* stream)
+{
+    return reinterpret_cast<CacheStream*>(stream)->position;
+}
+
+static int32_t CacheStreamSeek(void* stream, int64_t offset, int32_t origin)
+{
+    auto cs           = reinterpret_cast<CacheStream*>(stream);
+    const auto size   = (int64_t) cs->cache->GetSize();
+    int64_t newOffset = 0;
+
+    switch (origin)
+    {
+    case MZ_SEEK_SET:
+        newOffset = offset;
+        break;
+    case MZ_SEEK_CUR:
+        newOffset = cs->position + offset;
+        break;
+    case MZ_SEEK_END:
+        newOffset = size + offset;
+        break;
+    default:
+        return MZ_SEEK_ERROR;
+    }
+    CHECK(newOffset >= 0 && newOffset <= size, MZ_SEEK_ERROR, "");
+
+    cs->position = newOffset;
+    return MZ_OK;
+}
+
+static int32_t CacheStreamClose(void* stream)
+{
+    reinterpret_cast<CacheStream*>(stream)->opened = false;
+    return MZ_OK;
+}
+
+static int32_t CacheStreamError(void* /*stream*/)
+{
+    return MZ_OK;
+}
+
+// create/destroy are not needed (the stream is owned by _Info)
+static mz_stream_vtbl cacheStreamVtbl = { CacheStreamOpen, CacheStreamIsOpen, CacheStreamRead, CacheStreamWrite, CacheStreamTell, CacheStreamSeek,
+                                          CacheStreamClose, CacheStreamError, nullptr, nullptr, nullptr, nullptr };
+
+static bool OpenReaderOverCache(void* reader, CacheStream& cs, Utils::DataCache& cache)
+{
+    cs              = {};
+    cs.stream.vtbl  = &cacheStreamVtbl;
+    cs.cache        = &cache;
+    CHECK(CacheStreamOpen(&cs, nullptr, MZ_OPEN_MODE_READ) == MZ_OK, false, "");
+    CHECK(mz_zip_reader_open(reader, &cs) == MZ_OK, false, "");
+    return true;
+}
+
 struct _Info
 {
     std::string path;
+    CacheStream stream{}; // must outlive the reader (declared before it => destroyed after it)
     mz_zip_reader_create_ptr reader{};
     std::vector<_Entry> entries;
 };
@@ -355,6 +469,31 @@ bool Info::Decompress(const BufferView& input, Buffer& output, uint32 index, con
     return true;
 }
 
+bool Info::Decompress(Utils::DataCache& cache, Buffer& output, uint32 index, const std::string& password) const
+{
+    CHECK(context != nullptr, false, "");
+    auto info = reinterpret_cast<_Info*>(context);
+
+    CHECK(index < info->entries.size(), false, "");
+    auto& entry = info->entries.at(index);
+    CHECK(entry.type == EntryType::File, false, "");
+
+    CacheStream cs{};
+    mz_zip_reader_create_ptr reader{ mz_zip_reader_create() };
+    mz_zip_reader_set_password(reader.value, password.c_str());
+    mz_zip_reader_set_pattern(reader.value, (char*) entry.filename.data(), 0);
+
+    CHECK(OpenReaderOverCache(reader.value, cs, cache), false, "");
+
+    output.Reserve(entry.uncompressed_size);
+
+    CHECK(mz_zip_reader_entry_save_buffer(reader.value, output.GetData(), (int32_t) entry.uncompressed_size) == MZ_OK, false, "");
+
+    output.Resize(entry.uncompressed_size);
+
+    return true;
+}
+
 bool GetInfo(std::u16string_view path, Info& info)
 {
     auto internalInfo = reinterpret_cast<_Info*>(info.context);
@@ -429,18 +568,9 @@ bool GetInfo(Utils::DataCache& cache, Info& info)
     // mz_zip_reader_set_password(reader, password.c_str()); // do we want to try a password?
     // mz_zip_reader_set_encoding(reader.get(), 0);
 
-    // not the best option.. you might want to stream this or drop it on the disk as a temp file
-    // every option has its downsides
-    auto buffer = cache.GetEntireFile();
-    CHECK(buffer.IsValid(), false, "");
-
-    CHECK(mz_zip_reader_open_buffer(
-                internalInfo->reader.value,
-                const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(buffer.GetData())),
-                static_cast<uint32>(buffer.GetLength()), // max 4GB
-                /* don't copy */ 0) == MZ_OK,
-          false,
-          "");
+    // the archive is read through the cache (no 4GB limit, no copy of the entire file)
+    internalInfo->entries.clear();
+    CHECK(OpenReaderOverCache(internalInfo->reader.value, internalInfo->stream, cache), false, "");
     CHECK(mz_zip_reader_goto_first_entry(internalInfo->reader.value) == MZ_OK, false, "");
 
     do
@@ -66,4 +66,70 @@ bool DecompressStream(const BufferView& input, Buffer& output, String& message,
 
     return true;
 }
+bool DecompressStream(Utils::DataCache& cache, uint64 offset, uint64 size, Buffer& output, String& message, uint64& sizeConsumed)
+{
+    sizeConsumed = 0;
+    if ((size == 0) || (offset >= cache.GetSize())) {
+        message.Format("Invalid range: offset %llu, size %llu (object size: %llu)", offset, size, cache.GetSize());
+        RETURNERROR(false, "%s", message.GetText());
+    }
+    size = std::min<uint64>(size, cache.GetSize() - offset);
+
+    // total_in / total_out are 32 bits wide on some platforms => keep our own 64 bits counters
+    uint64 produced = 0;
+    output.Resize((size_t) std::max<uint64>(std::min<uint64>(size * 2, 0x4000000), 0x10000));
+
+    z_stream stream;
+    memset(&stream, Z_NULL, sizeof(stream));
+
+    int ret = inflateInit(&stream);
+    if (ret != Z_OK) {
+        message.Format("inflateInit failed with return code: %d", ret);
+        RETURNERROR(false, "%s", message.GetText());
+    }
+
+    struct ZWrapper {
+        z_stream& z;
+
+        ZWrapper(z_stream& z) : z(z)
+        {
+        }
+        ~ZWrapper()
+        {
+            inflateEnd(&z);
+        }
+    } zWrapper(stream);
+
+    const auto readOk = cache.ForEachChunk(
+          offset,
+          size,
+          [&](uint64, BufferView chunk)
+          {
+              stream.next_in  = const_cast<Bytef*>(chunk.GetData());
+              stream.avail_in = static_cast<uInt>(chunk.GetLength());
+
+              do {
+                  if (produced == output.GetLength()) {
+                      output.Resize((size_t) (produced * 2));
+                  }
+                  const auto available = static_cast<uInt>(std::min<uint64>(output.GetLength() - produced, 0x40000000));
+                  stream.next_out      = reinterpret_cast<Bytef*>(output.GetData() + produced);
+                  stream.avail_out     = available;
+
+                  ret = inflate(&stream, Z_NO_FLUSH);
+                  produced += available - stream.avail_out;
+              } while ((ret == Z_OK || ret == Z_BUF_ERROR) && (stream.avail_in > 0 || stream.avail_out == 0));
+
+              sizeConsumed += chunk.GetLength() - stream.avail_in;
+              return ret == Z_OK || ret == Z_BUF_ERROR; // stop on Z_STREAM_END or on errors
+          });
+
+    output.Resize((size_t) produced);
+    message.Format("Return code: %d with msg: %s", ret, stream.msg);
+
+    CHECK(readOk, false, "");
+    CHECK(ret == Z_OK || ret == Z_STREAM_END, false, "");
+
+    return true;
+}
 } // namespace GView::ZLIB
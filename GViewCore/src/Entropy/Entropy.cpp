@@ -1,18 +1,53 @@
 #include "Internal.hpp"
 
 #include <math.h>
-#include <array>
+#include <vector>
 
 constexpr uint32 MAX_NUMBER_OF_BYTES = 256;
+constexpr uint32 HISTOGRAM_LANES     = 4;
+constexpr size_t LANES_MIN_SIZE      = 1024;       // smaller buffers are counted directly
+constexpr size_t LANES_CHUNK_SIZE    = 0x40000000; // a lane (uint32) can not overflow inside a chunk
+constexpr double SHANNON_SCALE       = 16777216.0; // sum(c * log2(c)) is kept as a 2^24 fixed point value
+constexpr uint32 TERMS_TABLE_SIZE    = 0x10000;    // c * log2(c) and c ^ alpha are precomputed for small counts
+constexpr double RENYI_MIN_RELATIVE  = 1e-6;       // sum(c^α) vs. the largest term it was updated with
 
 namespace GView::Entropy
 {
-void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+void SetFrequencies(const BufferView& buffer, uint64 frequency[MAX_NUMBER_OF_BYTES])
 {
-    // Count frequency of each byte in the buffer
-    for (uint32 i = 0; i < buffer.GetLength(); i++) {
-        const auto c = buffer[i];
-        frequency[c]++;
+    const auto* data = buffer.GetData();
+    auto left        = buffer.GetLength();
+
+    if (left < LANES_MIN_SIZE) {
+        for (size_t i = 0; i < left; i++) {
+            frequency[data[i]]++;
+        }
+        return;
+    }
+
+    // Count frequency of each byte in the buffer using interleaved sub-histograms, so that runs of the same byte do not
+    // serialize on a single counter
+    uint32 lanes[HISTOGRAM_LANES][MAX_NUMBER_OF_BYTES];
+    while (left > 0) {
+        memset(lanes, 0, sizeof(lanes));
+        const auto size = std::min<size_t>(left, LANES_CHUNK_SIZE);
+
+        size_t i = 0;
+        for (; i + HISTOGRAM_LANES <= size; i += HISTOGRAM_LANES) {
+            lanes[0][data[i]]++;
+            lanes[1][data[i + 1]]++;
+            lanes[2][data[i + 2]]++;
+            lanes[3][data[i + 3]]++;
+        }
+        for (; i < size; i++) {
+            lanes[0][data[i]]++;
+        }
+
+        for (uint32 j = 0; j < MAX_NUMBER_OF_BYTES; j++) {
+            frequency[j] += static_cast<uint64>(lanes[0][j]) + lanes[1][j] + lanes[2][j] + lanes[3][j];
+        }
+        data += size;
+        left -= size;
     }
 }
 
@@ -27,27 +62,20 @@ void SetFrequencies(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYT
     The joint entropy of variables X_1, ..., X_n is then defined by
     H(X_1, ..., X_n) congruent - sum_(x_1) ... sum_(x_n) P(x_1, ..., x_n) log_2[P(x_1, ..., x_n)].
 */
-double ShannonEntropy_private(const BufferView& buffer, std::array<char, MAX_NUMBER_OF_BYTES>& frequency)
+double ShannonEntropy_private(const uint64 frequency[MAX_NUMBER_OF_BYTES], uint64 total)
 {
     double entropy = 0.0;
-    for (auto f : frequency) {
-        if (f == 0) {
+    for (uint32 i = 0; i < MAX_NUMBER_OF_BYTES; i++) {
+        if (frequency[i] == 0) {
             continue;
         }
-        double probability = static_cast<double>(f) / buffer.GetLength();
+        double probability = static_cast<double>(frequency[i]) / total;
         entropy -= probability * log2(probability);
     }
 
     return entropy; // max log2(n) = 8 (the entire sum)
 }
 
-double ShannonEntropy(const BufferView& buffer)
-{
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-    return ShannonEntropy_private(buffer, frequency);
-}
-
 /*
     Rényi entropy is defined as:
     H_α(p_1, p_2, ..., p_n) = 1/(1 - α) ln( sum_(i = 1)^n p_i^α), where α>0, α!=1.
@@ -56,19 +84,16 @@ double ShannonEntropy(const BufferView& buffer)
     H_α(p_1, p_2, ..., p_n)<=H_α'(p_1, p_2, ..., p_n)
     for α<=α'.
 */
-double RenyiEntropy(const BufferView& buffer, double alpha)
+double RenyiEntropy_private(const uint64 frequency[MAX_NUMBER_OF_BYTES], uint64 total, double alpha)
 {
-    std::array<char, MAX_NUMBER_OF_BYTES> frequency{};
-    SetFrequencies(buffer, frequency);
-
     if (alpha == 1.0) {
-        return ShannonEntropy_private(buffer, frequency);
+        return ShannonEntropy_private(frequency, total);
     }
 
     double sum = 0.0;
-    for (auto f : frequency) {
-        if (f > 0) {
-            const double probability = static_cast<double>(f) / buffer.GetLength();
+    for (uint32 i = 0; i < MAX_NUMBER_OF_BYTES; i++) {
+        if (frequency[i] > 0) {
+            const double probability = static_cast<double>(frequency[i]) / total;
             sum += pow(probability, alpha);
         }
     }
@@ -77,4 +102,219 @@ double RenyiEntropy(const BufferView& buffer, double alpha)
     // return std::max(((1.0 / (1.0 - alpha)) * log(sum)) / log(2), 0.0);
     return ((1.0 / (1.0 - alpha)) * log(sum)) / log(2);
 }
+
+double ShannonEntropy(const BufferView& buffer)
+{
+    Histogram histogram;
+    histogram.Add(buffer);
+    return histogram.ShannonEntropy();
+}
+
+double RenyiEntropy(const BufferView& buffer, double alpha)
+{
+    Histogram histogram;
+    histogram.Add(buffer);
+    return histogram.RenyiEntropy(alpha);
+}
+
+Histogram::Histogram()
+{
+    Reset();
+}
+void Histogram::Reset()
+{
+    memset(counts, 0, sizeof(counts));
+    total = 0;
+}
+void Histogram::Add(const BufferView& buffer)
+{
+    SetFrequencies(buffer, counts);
+    total += buffer.GetLength();
+}
+void Histogram::Add(const Histogram& other)
+{
+    for (uint32 i = 0; i < MAX_NUMBER_OF_BYTES; i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+}
+double Histogram::ShannonEntropy() const
+{
+    if (total == 0) {
+        return 0.0;
+    }
+    return ShannonEntropy_private(counts, total);
+}
+double Histogram::RenyiEntropy(double alpha) const
+{
+    if (total == 0) {
+        return 0.0;
+    }
+    return RenyiEntropy_private(counts, total, alpha);
+}
+
+/*
+    With N bytes in the window and c_i occurrences of byte i:
+    H = -sum (c_i / N) log2(c_i / N) = log2(N) - (1 / N) * sum c_i * log2(c_i)
+    H_α = (log2(sum c_i^α) - α * log2(N)) / (1 - α)
+    A byte that enters/leaves the window changes a single c_i, so only one term of each sum has to be updated.
+    sum c_i * log2(c_i) is kept in fixed point, so adding and removing the same term cancels exactly (no drift);
+    sum c_i^α is a double and is recomputed from the counters once in a while, or sooner if it becomes much smaller than
+    the terms it was updated with (cancellation - e.g. for α < 0 the terms of rare bytes dominate).
+*/
+struct SlidingWindowContext {
+    std::vector<uint8> window; // ring buffer with the last 'windowSize' bytes
+    uint32 windowSize{ 1 };
+    uint32 position{ 0 };
+    uint32 length{ 0 };
+    uint32 counts[MAX_NUMBER_OF_BYTES]{};
+
+    double alpha{ 2.0 };
+    int64 shannonSum{ 0 };
+    double renyiSum{ 0.0 };
+    double renyiScale{ 0.0 }; // largest term used since the last recomputation
+    uint64 renyiUpdates{ 0 };
+    std::vector<int64> shannonTerms;
+    std::vector<double> renyiTerms;
+
+    SlidingWindowContext(uint32 size, double renyiAlpha) : window(std::max<uint32>(size, 1)), windowSize(std::max<uint32>(size, 1)), alpha(renyiAlpha)
+    {
+        const auto tableSize = std::min<uint32>(windowSize, TERMS_TABLE_SIZE) + 1;
+        shannonTerms.resize(tableSize);
+        renyiTerms.resize(tableSize);
+        for (uint32 c = 0; c < tableSize; c++) {
+            shannonTerms[c] = ComputeShannonTerm(c);
+            renyiTerms[c]   = ComputeRenyiTerm(c);
+        }
+    }
+
+    static int64 ComputeShannonTerm(uint32 c)
+    {
+        return c < 2 ? 0 : llround(c * log2(static_cast<double>(c)) * SHANNON_SCALE);
+    }
+    double ComputeRenyiTerm(uint32 c) const
+    {
+        return c == 0 ? 0.0 : pow(static_cast<double>(c), alpha);
+    }
+    inline int64 ShannonTerm(uint32 c) const
+    {
+        return c < shannonTerms.size() ? shannonTerms[c] : ComputeShannonTerm(c);
+    }
+    inline double RenyiTerm(uint32 c) const
+    {
+        return c < renyiTerms.size() ? renyiTerms[c] : ComputeRenyiTerm(c);
+    }
+
+    inline void Update(uint8 value, uint32 newCount)
+    {
+        auto& c = counts[value];
+        shannonSum += ShannonTerm(newCount) - ShannonTerm(c);
+        if (alpha != 1.0) {
+            const auto oldTerm = RenyiTerm(c);
+            const auto newTerm = RenyiTerm(newCount);
+            renyiSum += newTerm - oldTerm;
+            renyiScale = std::max<>(renyiScale, std::max<>(oldTerm, newTerm));
+        }
+        c = newCount;
+    }
+
+    void Push(uint8 value)
+    {
+        if (length == windowSize) {
+            const auto old = window[position];
+            Update(old, counts[old] - 1);
+        } else {
+            length++;
+        }
+        window[position] = value;
+        Update(value, counts[value] + 1);
+        if (++position == windowSize) {
+            position = 0;
+        }
+
+        if (alpha != 1.0) {
+            renyiUpdates++;
+            if ((renyiUpdates >= std::max<uint32>(windowSize, MAX_NUMBER_OF_BYTES)) || (renyiSum < renyiScale * RENYI_MIN_RELATIVE)) {
+                RecomputeRenyiSum();
+            }
+        }
+    }
+
+    void RecomputeRenyiSum()
+    {
+        // get rid of the accumulated floating point error
+        renyiUpdates = 0;
+        renyiSum     = 0.0;
+        renyiScale   = 0.0;
+        for (auto count : counts) {
+            const auto term = RenyiTerm(count);
+            renyiSum += term;
+            renyiScale = std::max<>(renyiScale, term);
+        }
+    }
+
+    void Reset()
+    {
+        position     = 0;
+        length       = 0;
+        shannonSum   = 0;
+        renyiSum     = 0.0;
+        renyiScale   = 0.0;
+        renyiUpdates = 0;
+        memset(counts, 0, sizeof(counts));
+    }
+};
+
+SlidingWindow::SlidingWindow(uint32 windowSize, double renyiAlpha)
+{
+    this->context = new SlidingWindowContext(windowSize, renyiAlpha);
+}
+SlidingWindow::~SlidingWindow()
+{
+    delete reinterpret_cast<SlidingWindowContext*>(this->context);
+    this->context = nullptr;
+}
+void SlidingWindow::Reset()
+{
+    reinterpret_cast<SlidingWindowContext*>(this->context)->Reset();
+}
+void SlidingWindow::Push(uint8 value)
+{
+    reinterpret_cast<SlidingWindowContext*>(this->context)->Push(value);
+}
+void SlidingWindow::Push(const BufferView& buffer)
+{
+    auto* ctx = reinterpret_cast<SlidingWindowContext*>(this->context);
+    for (size_t i = 0; i < buffer.GetLength(); i++) {
+        ctx->Push(buffer[i]);
+    }
+}
+uint32 SlidingWindow::GetWindowSize() const
+{
+    return reinterpret_cast<SlidingWindowContext*>(this->context)->windowSize;
+}
+uint32 SlidingWindow::GetLength() const
+{
+    return reinterpret_cast<SlidingWindowContext*>(this->context)->length;
+}
+double SlidingWindow::ShannonEntropy() const
+{
+    const auto* ctx = reinterpret_cast<SlidingWindowContext*>(this->context);
+    if (ctx->length == 0) {
+        return 0.0;
+    }
+    const double n = ctx->length;
+    return std::max<>(log2(n) - static_cast<double>(ctx->shannonSum) / (SHANNON_SCALE * n), 0.0);
+}
+double SlidingWindow::RenyiEntropy() const
+{
+    const auto* ctx = reinterpret_cast<SlidingWindowContext*>(this->context);
+    if (ctx->alpha == 1.0) {
+        return ShannonEntropy();
+    }
+    if ((ctx->length == 0) || (ctx->renyiSum <= 0.0)) {
+        return 0.0;
+    }
+    return (log2(ctx->renyiSum) - ctx->alpha * log2(static_cast<double>(ctx->length))) / (1.0 - ctx->alpha);
+}
 } // namespace GView::Entropy
@@ -10,6 +10,7 @@ namespace GView::Generic
 Plugin::Plugin()
 {
     this->CommandsCount = 0;
+    this->loadTime      = 0;
     this->fnRun         = nullptr;
 }
 bool Plugin::Init(AppCUI::Utils::IniSection section)
@@ -36,34 +37,32 @@ bool Plugin::Init(AppCUI::Utils::IniSection section)
 
     return true;
 }
+bool Plugin::Load()
+{
+    if (this->fnRun)
+        return true;
+    const auto start = std::chrono::steady_clock::now();
+    AppCUI::OS::Library lib;
+    auto path = AppCUI::OS::GetCurrentApplicationPath();
+    path.remove_filename();
+    path /= "GenericPlugins";
+    path /= "lib";
+    path += (std::string_view) this->Name;
+    path += ".gpl";
+    CHECK(lib.Load(path), false, "Fail to load library: %s", path.generic_string().c_str());
+    this->fnRun    = lib.GetFunction<decltype(this->fnRun)>("Run");
+    this->loadTime = static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    CHECK(this->fnRun, false, "Unable to find `Run` export in : %s", path.generic_string().c_str());
+    return true;
+}
 void Plugin::Run(uint32 commandIndex, Reference<GView::Object> currentObject)
 {
-    if (!this->fnRun)
+    if (!Load())
     {
-        // we need to load the library
-        AppCUI::OS::Library lib;
-        auto path = AppCUI::OS::GetCurrentApplicationPath();
-        path.remove_filename();
-        path /= "GenericPlugins";
-        path /= "lib";
-        path += (std::string_view) this->Name;
-        path += ".gpl";
-        if (lib.Load(path)==false)
-        {
-            LocalString<1024> info;
-            info.Format("Fail to load library: %s", path.generic_string().c_str());
-            AppCUI::Dialogs::MessageBox::ShowError("Error", info);
-            return;
-        }
-
-        this->fnRun            = lib.GetFunction<decltype(this->fnRun)>("Run");
-        if (!this->fnRun)
-        {
-            LocalString<1024> info;
-            info.Format("Unable to find `Run` export in : %s", path.generic_string().c_str());
-            AppCUI::Dialogs::MessageBox::ShowError("Error", info);
-            return;
-        }
+        LocalString<1024> info;
+        info.Format("Fail to load generic plugin `%s` (missing library or `Run` export) !", this->Name.GetText());
+        AppCUI::Dialogs::MessageBox::ShowError("Error", info);
+        return;
     }
     // all good -> is loaded ==> try to run
     if (!this->fnRun(this->Commands[commandIndex].Name, currentObject))
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Internal.hpp"
+
+#include <array>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#    include <immintrin.h>
+#    if defined(_MSC_VER) && !defined(__clang__)
+#        include <intrin.h>
+#        define GVIEW_CRC_TARGET
+#    else
+#        define GVIEW_CRC_TARGET __attribute__((target("pclmul,ssse3")))
+#    endif
+#    define GVIEW_CRC_CLMUL
+#endif
+
+namespace GView::Hashes::CRC
+{
+constexpr uint32 SLICE_SIZE      = 16;  // bytes consumed by an iteration of the slice-by-16 loops
+constexpr uint32 CLMUL_FOLD_SIZE = 64;  // bytes folded by an iteration of the carry-less multiplication loops
+constexpr uint32 CLMUL_MIN_SIZE  = 256; // below this, the table driven loops are faster than the setup of the folding
+
+// tables[k][b] = the CRC of byte 'b' followed by 'k' bytes of 0 (so that 'k + 1' bytes can be processed at once)
+template <typename T, uint32 Count, bool Reflected>
+constexpr std::array<std::array<T, 256>, Count> MakeSliceTables(const T (&table)[256])
+{
+    constexpr uint32 shift = sizeof(T) * 8 - 8;
+    std::array<std::array<T, 256>, Count> tables{};
+    for (uint32 b = 0; b < 256; b++)
+        tables[0][b] = table[b];
+    for (uint32 k = 1; k < Count; k++)
+    {
+        for (uint32 b = 0; b < 256; b++)
+        {
+            const T prev = tables[k - 1][b];
+            if constexpr (Reflected)
+                tables[k][b] = static_cast<T>((prev >> 8) ^ table[prev & 0xFF]);
+            else
+                tables[k][b] = static_cast<T>((prev << 8) ^ table[(prev >> shift) & 0xFF]);
+        }
+    }
+    return tables;
+}
+
+// x^n mod P (P has an implicit x^width term), coefficient of x^i in bit i
+template <typename T>
+constexpr T XPowModP(uint32 n, T poly)
+{
+    constexpr uint32 width = sizeof(T) * 8;
+    T result               = 1;
+    for (uint32 idx = 0; idx < n; idx++)
+    {
+        const bool carry = (result >> (width - 1)) & 1;
+        result           = static_cast<T>(result << 1);
+        if (carry)
+            result ^= poly;
+    }
+    return result;
+}
+
+constexpr uint64 Reflect64(uint64 value)
+{
+    uint64 result = 0;
+    for (uint32 idx = 0; idx < 64; idx++)
+        result |= ((value >> idx) & 1) << (63 - idx);
+    return result;
+}
+
+#ifdef GVIEW_CRC_CLMUL
+inline bool HasCarrylessMultiply()
+{
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    // ECX: bit 1 = PCLMULQDQ, bit 9 = SSSE3
+    return ((info[2] & (1 << 1)) != 0) && ((info[2] & (1 << 9)) != 0);
+#    else
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+#    endif
+}
+#else
+inline bool HasCarrylessMultiply()
+{
+    return false;
+}
+#endif
+
+// The kernels behind the CRC classes (exposed so that they can be compared by the CRC micro-benchmark). CarrylessMultiply
+// folds the inputs of at least CLMUL_MIN_SIZE bytes if the CPU supports it (the rest is processed by the slice-by-N loop);
+// CRC16 has no carry-less kernel and always uses the slice-by-8 loop for it.
+enum class Kernel : uint8
+{
+    Bytewise,
+    SliceBy,
+    CarrylessMultiply
+};
+uint16 Update16(Kernel kernel, uint16 crc, const uint8* input, size_t length);
+uint32 Update32(Kernel kernel, uint32 crc, const uint8* input, size_t length);
+uint64 Update64(Kernel kernel, uint64 crc, const uint8* input, size_t length);
+} // namespace GView::Hashes::CRC
@@ -1,8 +1,8 @@
-#include "Internal.hpp"
+#include "CRC.hpp"
 
 namespace GView::Hashes
 {
-static const uint32 CRC32Table[] = {
+static constexpr uint32 CRC32Table[256] = {
     0x00000000L, 0x77073096L, 0xee0e612cL, 0x990951baL, 0x076dc419L, 0x706af48fL, 0xe963a535L, 0x9e6495a3L, 0x0edb8832L, 0x79dcb8a4L,
     0xe0d5e91eL, 0x97d2d988L, 0x09b64c2bL, 0x7eb17cbdL, 0xe7b82d07L, 0x90bf1d91L, 0x1db71064L, 0x6ab020f2L, 0xf3b97148L, 0x84be41deL,
     0x1adad47dL, 0x6ddde4ebL, 0xf4d4b551L, 0x83d385c7L, 0x136c9856L, 0x646ba8c0L, 0xfd62f97aL, 0x8a65c9ecL, 0x14015c4fL, 0x63066cd9L,
@@ -31,6 +31,77 @@ static const uint32 CRC32Table[] = {
     0x5d681b02L, 0x2a6f2b94L, 0xb40bbe37L, 0xc30c8ea1L, 0x5a05df1bL, 0x2d02ef8dL
 };
 
+static constexpr auto CRC32Tables = CRC::MakeSliceTables<uint32, CRC::SLICE_SIZE, true>(CRC32Table);
+
+static inline uint32 UpdateBytewise(uint32 crc, const uint8* input, size_t length)
+{
+    while (length--)
+    {
+        crc = CRC32Table[(crc & 0xff) ^ *input++] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static inline uint32 UpdateSliceBy16(uint32 crc, const uint8* input, size_t length)
+{
+    const auto& t = CRC32Tables;
+    for (; length >= CRC::SLICE_SIZE; length -= CRC::SLICE_SIZE, input += CRC::SLICE_SIZE)
+    {
+        crc = t[15][input[0] ^ (crc & 0xff)] ^ t[14][input[1] ^ ((crc >> 8) & 0xff)] ^ t[13][input[2] ^ ((crc >> 16) & 0xff)] ^
+              t[12][input[3] ^ (crc >> 24)] ^ t[11][input[4]] ^ t[10][input[5]] ^ t[9][input[6]] ^ t[8][input[7]] ^ t[7][input[8]] ^
+              t[6][input[9]] ^ t[5][input[10]] ^ t[4][input[11]] ^ t[3][input[12]] ^ t[2][input[13]] ^ t[1][input[14]] ^ t[0][input[15]];
+    }
+    return UpdateBytewise(crc, input, length);
+}
+
+#ifdef GVIEW_CRC_CLMUL
+/*
+    Folding with carry-less multiplications (PCLMULQDQ) - the input is seen as a polynomial, and a 128 bit lane X
+    that is followed by T more bits is replaced by X * x^T mod P (same CRC) and added to the lane found T bits later.
+    The CRC is bit reflected: bit 0 of a lane is its highest coefficient (x^127), and the product of two reflected 64 bit
+    values is one bit short => the constants are x^(n - 1) mod P so that the result is already aligned.
+*/
+constexpr uint32 CRC32_POLY = 0x04C11DB7;
+
+static constexpr uint64 FoldConstant32(uint32 n)
+{
+    return CRC::Reflect64(CRC::XPowModP<uint32>(n - 1, CRC32_POLY));
+}
+
+GVIEW_CRC_TARGET static inline __m128i Fold32(__m128i lane, __m128i constants, __m128i next)
+{
+    const auto low  = _mm_clmulepi64_si128(lane, constants, 0x00);
+    const auto high = _mm_clmulepi64_si128(lane, constants, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(low, high), next);
+}
+
+// 'length' is a multiple of CLMUL_FOLD_SIZE
+GVIEW_CRC_TARGET static uint32 UpdateFolding(uint32 crc, const uint8* input, size_t length)
+{
+    const auto by4 = _mm_set_epi64x(FoldConstant32(512), FoldConstant32(512 + 64));
+    const auto by1 = _mm_set_epi64x(FoldConstant32(128), FoldConstant32(128 + 64));
+    const auto* p  = reinterpret_cast<const __m128i*>(input);
+
+    auto x0 = _mm_xor_si128(_mm_loadu_si128(p), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    auto x1 = _mm_loadu_si128(p + 1);
+    auto x2 = _mm_loadu_si128(p + 2);
+    auto x3 = _mm_loadu_si128(p + 3);
+    for (p += 4, length -= CRC::CLMUL_FOLD_SIZE; length > 0; p += 4, length -= CRC::CLMUL_FOLD_SIZE)
+    {
+        x0 = Fold32(x0, by4, _mm_loadu_si128(p));
+        x1 = Fold32(x1, by4, _mm_loadu_si128(p + 1));
+        x2 = Fold32(x2, by4, _mm_loadu_si128(p + 2));
+        x3 = Fold32(x3, by4, _mm_loadu_si128(p + 3));
+    }
+    x0 = Fold32(Fold32(Fold32(x0, by1, x1), by1, x2), by1, x3);
+
+    // the remaining 128 bits have the same CRC as the entire input
+    uint8 rest[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rest), x0);
+    return UpdateSliceBy16(0, rest, sizeof(rest));
+}
+#endif
+
 bool CRC32::Init(CRC32Type type)
 {
     this->type = type;
@@ -40,18 +111,27 @@ bool CRC32::Init(CRC32Type type)
     return true;
 }
 
-bool CRC32::Update(const unsigned char* input, uint32 length)
+uint32 CRC::Update32(Kernel kernel, uint32 crc, const uint8* input, size_t length)
 {
-    CHECK(input != nullptr, false, "");
-    uint32 crc = value;
-
-    while (length--)
+    if (kernel == Kernel::Bytewise)
+        return UpdateBytewise(crc, input, length);
+#ifdef GVIEW_CRC_CLMUL
+    static const bool hasCarrylessMultiply = HasCarrylessMultiply();
+    if ((kernel == Kernel::CarrylessMultiply) && (length >= CLMUL_MIN_SIZE) && hasCarrylessMultiply)
     {
-        crc = CRC32Table[(crc & 0xff) ^ *input++] ^ (crc >> 8);
+        const auto size = length & ~static_cast<size_t>(CLMUL_FOLD_SIZE - 1);
+        crc             = UpdateFolding(crc, input, size);
+        input += size;
+        length -= size;
     }
+#endif
+    return UpdateSliceBy16(crc, input, length);
+}
 
-    value = crc;
-
+bool CRC32::Update(const unsigned char* input, uint32 length)
+{
+    CHECK(input != nullptr, false, "");
+    value = CRC::Update32(CRC::Kernel::CarrylessMultiply, value, input, length);
     return true;
 }
 
@@ -1,8 +1,8 @@
-#include "Internal.hpp"
+#include "CRC.hpp"
 
 namespace GView::Hashes
 {
-static const uint64 CRC64Table[256] = {
+static constexpr uint64 CRC64Table[256] = {
     0x0000000000000000, 0x42F0E1EBA9EA3693, 0x85E1C3D753D46D26, 0xC711223CFA3E5BB5, 0x493366450E42ECDF, 0x0BC387AEA7A8DA4C,
     0xCCD2A5925D9681F9, 0x8E224479F47CB76A, 0x9266CC8A1C85D9BE, 0xD0962D61B56FEF2D, 0x17870F5D4F51B498, 0x5577EEB6E6BB820B,
     0xDB55AACF12C73561, 0x99A54B24BB2D03F2, 0x5EB4691841135847, 0x1C4488F3E8F96ED4, 0x663D78FF90E185EF, 0x24CD9914390BB37C,
@@ -48,6 +48,79 @@ static const uint64 CRC64Table[256] = {
     0x5DEDC41A34BBEEB2, 0x1F1D25F19D51D821, 0xD80C07CD676F8394, 0x9AFCE626CE85B507
 };
 
+static constexpr auto CRC64Tables = CRC::MakeSliceTables<uint64, CRC::SLICE_SIZE, false>(CRC64Table);
+
+static inline uint64 UpdateBytewise(uint64 crc, const uint8* input, size_t length)
+{
+    while (length--)
+    {
+        uint64 i = ((uint64) (crc >> 56) ^ *input++) & 0xFF;
+        crc      = CRC64Table[i] ^ (crc << 8);
+    }
+    return crc;
+}
+
+static inline uint64 UpdateSliceBy16(uint64 crc, const uint8* input, size_t length)
+{
+    const auto& t = CRC64Tables;
+    for (; length >= CRC::SLICE_SIZE; length -= CRC::SLICE_SIZE, input += CRC::SLICE_SIZE)
+    {
+        crc = t[15][input[0] ^ (crc >> 56)] ^ t[14][input[1] ^ ((crc >> 48) & 0xFF)] ^ t[13][input[2] ^ ((crc >> 40) & 0xFF)] ^
+              t[12][input[3] ^ ((crc >> 32) & 0xFF)] ^ t[11][input[4] ^ ((crc >> 24) & 0xFF)] ^ t[10][input[5] ^ ((crc >> 16) & 0xFF)] ^
+              t[9][input[6] ^ ((crc >> 8) & 0xFF)] ^ t[8][input[7] ^ (crc & 0xFF)] ^ t[7][input[8]] ^ t[6][input[9]] ^ t[5][input[10]] ^
+              t[4][input[11]] ^ t[3][input[12]] ^ t[2][input[13]] ^ t[1][input[14]] ^ t[0][input[15]];
+    }
+    return UpdateBytewise(crc, input, length);
+}
+
+#ifdef GVIEW_CRC_CLMUL
+/*
+    Folding with carry-less multiplications (PCLMULQDQ) - a 128 bit lane X = H * x^64 + L that is followed by T more bits
+    is replaced by H * (x^(T + 64) mod P) + L * (x^T mod P) (same CRC) and added to the lane found T bits later.
+    This CRC is not reflected => the bytes of every lane are reversed so that the first byte holds the highest coefficients.
+*/
+constexpr uint64 CRC64_POLY = 0x42F0E1EBA9EA3693;
+
+GVIEW_CRC_TARGET static inline __m128i Fold64(__m128i lane, __m128i constants, __m128i next)
+{
+    const auto low  = _mm_clmulepi64_si128(lane, constants, 0x00);
+    const auto high = _mm_clmulepi64_si128(lane, constants, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(low, high), next);
+}
+
+GVIEW_CRC_TARGET static inline __m128i Load64(const __m128i* lane, __m128i reverse)
+{
+    return _mm_shuffle_epi8(_mm_loadu_si128(lane), reverse);
+}
+
+// 'length' is a multiple of CLMUL_FOLD_SIZE
+GVIEW_CRC_TARGET static uint64 UpdateFolding(uint64 crc, const uint8* input, size_t length)
+{
+    const auto by4     = _mm_set_epi64x(CRC::XPowModP<uint64>(512 + 64, CRC64_POLY), CRC::XPowModP<uint64>(512, CRC64_POLY));
+    const auto by1     = _mm_set_epi64x(CRC::XPowModP<uint64>(128 + 64, CRC64_POLY), CRC::XPowModP<uint64>(128, CRC64_POLY));
+    const auto reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const auto* p      = reinterpret_cast<const __m128i*>(input);
+
+    auto x0 = _mm_xor_si128(Load64(p, reverse), _mm_set_epi64x(static_cast<int64>(crc), 0));
+    auto x1 = Load64(p + 1, reverse);
+    auto x2 = Load64(p + 2, reverse);
+    auto x3 = Load64(p + 3, reverse);
+    for (p += 4, length -= CRC::CLMUL_FOLD_SIZE; length > 0; p += 4, length -= CRC::CLMUL_FOLD_SIZE)
+    {
+        x0 = Fold64(x0, by4, Load64(p, reverse));
+        x1 = Fold64(x1, by4, Load64(p + 1, reverse));
+        x2 = Fold64(x2, by4, Load64(p + 2, reverse));
+        x3 = Fold64(x3, by4, Load64(p + 3, reverse));
+    }
+    x0 = Fold64(Fold64(Fold64(x0, by1, x1), by1, x2), by1, x3);
+
+    // the remaining 128 bits have the same CRC as the entire input
+    uint8 rest[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rest), _mm_shuffle_epi8(x0, reverse));
+    return UpdateSliceBy16(0, rest, sizeof(rest));
+}
+#endif
+
 bool CRC64::Final()
 {
     CHECK(init, false, "");
@@ -65,19 +138,27 @@ bool CRC64::Init(CRC64Type type)
     return true;
 }
 
-bool CRC64::Update(const unsigned char* input, uint32 length)
+uint64 CRC::Update64(Kernel kernel, uint64 crc, const uint8* input, size_t length)
 {
-    CHECK(input != nullptr, false, "");
-    uint64 crc = value;
-
-    while (length--)
+    if (kernel == Kernel::Bytewise)
+        return UpdateBytewise(crc, input, length);
+#ifdef GVIEW_CRC_CLMUL
+    static const bool hasCarrylessMultiply = HasCarrylessMultiply();
+    if ((kernel == Kernel::CarrylessMultiply) && (length >= CLMUL_MIN_SIZE) && hasCarrylessMultiply)
     {
-        uint64 i = ((uint64) (crc >> 56) ^ *input++) & 0xFF;
-        crc      = CRC64Table[i] ^ (crc << 8);
+        const auto size = length & ~static_cast<size_t>(CLMUL_FOLD_SIZE - 1);
+        crc             = UpdateFolding(crc, input, size);
+        input += size;
+        length -= size;
     }
+#endif
+    return UpdateSliceBy16(crc, input, length);
+}
 
-    value = crc;
-
+bool CRC64::Update(const unsigned char* input, uint32 length)
+{
+    CHECK(input != nullptr, false, "");
+    value = CRC::Update64(CRC::Kernel::CarrylessMultiply, value, input, length);
     return true;
 }
 
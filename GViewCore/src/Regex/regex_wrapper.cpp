@@ -39,6 +39,12 @@ Matcher::~Matcher()
     }
 }
 
+bool Matcher::IsValid() const
+{
+    auto ctx = reinterpret_cast<const Context*>(this->context);
+    return (ctx != nullptr) && (ctx->expression.ok());
+}
+
 bool Matcher::Match(BufferView buffer, uint64& start, uint64& end)
 {
     auto ctx = reinterpret_cast<Context*>(this->context);
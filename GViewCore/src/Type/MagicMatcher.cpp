@@ -74,5 +74,10 @@ bool MagicMatcher::Match(AppCUI::Utils::BufferView buf, TextParser& )
         return memcmp(p, u8, count) == 0;
     }
 }
+PrefixKind MagicMatcher::GetPrefix(std::string_view& prefix) const
+{
+    prefix = { reinterpret_cast<const char*>(u8), static_cast<size_t>(count) };
+    return count > 0 ? PrefixKind::Binary : PrefixKind::None;
+}
 
 } // namespace GView::Type::Matcher
\ No newline at end of file
@@ -58,6 +58,7 @@ Plugin::Plugin()
     this->Invalid   = false;
     this->priority  = 0;
     this->pattern   = nullptr;
+    this->timings   = {};
     // functions
     this->fnValidate       = nullptr;
     this->fnCreateInstance = nullptr;
@@ -207,21 +208,53 @@ bool Plugin::MatchContent(AppCUI::Utils::BufferView buf, Matcher::TextParser& te
     }
     return false;
 }
+bool Plugin::Load()
+{
+    if ((this->Loaded) || (this->Invalid))
+        return this->Loaded;
+    const auto start = std::chrono::steady_clock::now();
+    this->Invalid    = !LoadPlugin();
+    this->Loaded     = !this->Invalid;
+    this->timings.load =
+          static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    return this->Loaded;
+}
 bool Plugin::IsOfType(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, const std::string_view& extension)
 {
-    if (this->Invalid)
-        return false;
-    if (!this->Loaded)
-    {
-        this->Invalid = !LoadPlugin();
-        this->Loaded  = !this->Invalid;
-        if (this->Invalid)
-            return false; // something went wrong when loading he plugin
-    }
+    if (!Load())
+        return false; // something went wrong when loading he plugin
     // all good -> code is loaded
-    return fnValidate(buf, extension);
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = fnValidate(buf, extension);
+    this->timings.validate +=
+          static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    this->timings.validateCalls++;
+    return result;
 }
 
+void Plugin::AddToIndex(PluginIndex& index, uint32 pluginIndex) const
+{
+    if (this->extensions.empty())
+    {
+        if (this->extension != EXTENSION_EMPTY_HASH)
+            index.AddExtension(this->extension, pluginIndex);
+    }
+    else
+    {
+        for (auto ext : this->extensions)
+            index.AddExtension(ext, pluginIndex);
+    }
+    if (this->patterns.empty())
+    {
+        if (this->pattern)
+            index.AddPattern(this->pattern, pluginIndex);
+    }
+    else
+    {
+        for (auto p : this->patterns)
+            index.AddPattern(p, pluginIndex);
+    }
+}
 bool Plugin::PopulateWindow(Reference<GView::View::WindowInterface> win) const
 {
     CHECK(!this->Invalid, false, "Invalid plugin (not loaded properly or no valid exports)");
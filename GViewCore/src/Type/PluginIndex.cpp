@@ -0,0 +1,122 @@
+#include "Internal.hpp"
+
+using namespace GView::Type;
+
+// Precompiled dispatch structure used to identify the type of a buffer:
+// - extension hash  => list of plugins that registered that extension
+// - magic patterns  => trie over the first bytes of the buffer
+// - startswith      => trie over the first characters of the text
+// Plugin indexes are stored in priority order (the order of the plugin vector) so that
+// the candidates are always returned in the same order as a linear scan would find them.
+
+PluginIndex::PluginIndex()
+{
+    Clear();
+}
+void PluginIndex::Clear()
+{
+    this->extensions.clear();
+    this->unindexed.clear();
+    this->binaryTrie.clear();
+    this->textTrie.clear();
+    // root nodes
+    this->binaryTrie.emplace_back();
+    this->textTrie.emplace_back();
+}
+void PluginIndex::AddExtension(uint64 extensionHash, uint32 pluginIndex)
+{
+    auto& list = this->extensions[extensionHash];
+    if (list.empty() || list.back() != pluginIndex)
+        list.push_back(pluginIndex);
+}
+void PluginIndex::AddPrefix(std::vector<Node>& trie, std::string_view prefix, uint32 pluginIndex)
+{
+    uint32 node = 0;
+    for (auto ch : prefix)
+    {
+        const auto key = static_cast<uint16>(static_cast<uint8>(ch));
+        auto& next     = trie[node].next;
+        auto it        = std::lower_bound(next.begin(), next.end(), key, [](const auto& entry, uint16 k) { return entry.first < k; });
+        if ((it != next.end()) && (it->first == key))
+        {
+            node = it->second;
+            continue;
+        }
+        const auto newNode = static_cast<uint32>(trie.size());
+        next.insert(it, { key, newNode });
+        trie.emplace_back(); // invalidates 'next'
+        node = newNode;
+    }
+    auto& plugins = trie[node].plugins;
+    if (plugins.empty() || plugins.back() != pluginIndex)
+        plugins.push_back(pluginIndex);
+}
+void PluginIndex::AddPattern(const Matcher::Interface* pattern, uint32 pluginIndex)
+{
+    CHECKRET(pattern, "");
+    std::string_view prefix;
+    switch (pattern->GetPrefix(prefix))
+    {
+    case Matcher::PrefixKind::Binary:
+        AddPrefix(this->binaryTrie, prefix, pluginIndex);
+        return;
+    case Matcher::PrefixKind::Text:
+        // startswith compares char16 values with (signed) chars => non ASCII characters never match
+        for (auto ch : prefix)
+        {
+            if (static_cast<uint8>(ch) >= 0x80)
+                return;
+        }
+        AddPrefix(this->textTrie, prefix, pluginIndex);
+        return;
+    default:
+        if (this->unindexed.empty() || this->unindexed.back() != pluginIndex)
+            this->unindexed.push_back(pluginIndex);
+        return;
+    }
+}
+template <typename T>
+void PluginIndex::MatchPrefix(const std::vector<Node>& trie, const T* p, size_t size, std::vector<uint32>& output)
+{
+    uint32 node = 0;
+    const T* e  = p + size;
+    while (p < e)
+    {
+        const auto ch = static_cast<uint32>(*p);
+        if (ch > 0xFF)
+            return;
+        const auto& next = trie[node].next;
+        auto it          = std::lower_bound(next.begin(), next.end(), static_cast<uint16>(ch), [](const auto& entry, uint16 k) { return entry.first < k; });
+        if ((it == next.end()) || (it->first != ch))
+            return;
+        node = it->second;
+        output.insert(output.end(), trie[node].plugins.begin(), trie[node].plugins.end());
+        p++;
+    }
+}
+std::span<const uint32> PluginIndex::GetExtensionCandidates(uint64 extensionHash) const
+{
+    auto it = this->extensions.find(extensionHash);
+    if (it == this->extensions.end())
+        return {};
+    return { it->second.data(), it->second.size() };
+}
+void PluginIndex::GetContentCandidates(
+      AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, std::vector<Plugin>& plugins, std::vector<uint32>& output) const
+{
+    output.clear();
+    MatchPrefix(this->binaryTrie, buf.GetData(), buf.GetLength(), output);
+    if (this->textTrie[0].next.empty() == false)
+    {
+        auto text = textParser.GetText();
+        MatchPrefix(this->textTrie, text.data(), text.size(), output);
+    }
+    // patterns that can not be indexed are checked individually
+    for (auto idx : this->unindexed)
+    {
+        if (plugins[idx].MatchContent(buf, textParser))
+            output.push_back(idx);
+    }
+    std::sort(output.begin(), output.end());
+    output.erase(std::unique(output.begin(), output.end()), output.end());
+}
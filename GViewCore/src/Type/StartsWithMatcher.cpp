@@ -23,4 +23,9 @@ bool StartsWithMatcher::Match(AppCUI::Utils::BufferView buf, TextParser& text)
     }
     return (p == e);
 }
+PrefixKind StartsWithMatcher::GetPrefix(std::string_view& prefix) const
+{
+    prefix = { this->value.GetText(), static_cast<size_t>(this->value.Len()) };
+    return PrefixKind::Text;
+}
 } // namespace GView::Type::Matcher
\ No newline at end of file
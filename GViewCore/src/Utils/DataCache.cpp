@@ -1,18 +1,273 @@
 #include "GView.hpp"
 
+#include <future>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef BUILD_FOR_WINDOWS
+#    define NOMINMAX
+#    include <Windows.h>
+#    undef GetObject
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
 using namespace GView::Utils;
 
-constexpr uint32 MAX_CACHE_SIZE = 0x20000000U; // 16 M
+constexpr uint32 MAX_CACHE_SIZE    = 0x20000000U; // 16 M
+constexpr uint32 PAGE_SHIFT        = 16;          // log2(DataCache::PAGE_SIZE)
+constexpr uint32 INVALID_PAGE_SLOT = 0xFFFFFFFFU;
+
+static_assert((1U << PAGE_SHIFT) == DataCache::PAGE_SIZE);
+
+struct PageSlot {
+    uint64 index{ INVALID_OFFSET }; // page index within the file (offset >> PAGE_SHIFT)
+    uint64 lastUsed{ 0 };           // LRU tick (0 means never used)
+};
+static bool ReadObject(AppCUI::OS::DataObject* obj, std::mutex& ioLock, uint64 offset, uint8* buffer, uint32 size)
+{
+    // the data object keeps a current position --> reads from the read-ahead thread and from the caller must not interleave
+    std::lock_guard<std::mutex> lock(ioLock);
+    return obj->SetCurrentPos(offset) && obj->Read(buffer, size);
+}
+
+struct ReadAheadBlock {
+    std::unique_ptr<uint8[]> data;
+    std::future<bool> pending;
+    uint64 start{ 0 };
+    uint32 size{ 0 }; // 0 means that the block is not used
+    bool ok{ false };
+
+    bool Contains(uint64 offset) const
+    {
+        return (size > 0) && (offset >= start) && (offset < start + size);
+    }
+    bool Wait()
+    {
+        if (pending.valid())
+            ok = pending.get();
+        return ok;
+    }
+    void Drop()
+    {
+        Wait();
+        size = 0;
+        ok   = false;
+    }
+};
+struct ReadAhead {
+    ReadAheadBlock blocks[2]; // double buffered: one is consumed while the other one is being read
+    uint32 blockSize{ 0 };
+    uint32 users{ 0 };
+
+    ReadAheadBlock* Find(uint64 offset)
+    {
+        for (auto& b : blocks) {
+            if (b.Contains(offset))
+                return &b;
+        }
+        return nullptr;
+    }
+    uint64 NextBlockStart(uint64 offset, uint64 limit) const
+    {
+        for (auto& b : blocks) {
+            if ((b.size > 0) && (b.start > offset) && (b.start < limit))
+                limit = b.start;
+        }
+        return limit;
+    }
+    // keep (at most) two blocks read in advance after 'from'
+    uint64 Schedule(AppCUI::OS::DataObject* obj, std::mutex& ioLock, uint64 from, uint64 fileSize)
+    {
+        const auto horizon = from + 2ULL * blockSize;
+        auto frontier      = from;
+        uint64 scheduled   = 0;
+        for (auto& b : blocks) {
+            if (b.size == 0)
+                continue;
+            // already consumed or too far away (the scan has jumped) --> the buffer can be reused
+            if ((b.start + b.size <= from) || (b.start >= horizon))
+                b.Drop();
+            else
+                frontier = std::max<uint64>(frontier, b.start + b.size);
+        }
+        for (auto& b : blocks) {
+            if ((b.size > 0) || (frontier >= fileSize))
+                continue;
+            b.start         = frontier;
+            b.size          = (uint32) std::min<uint64>(blockSize, fileSize - frontier);
+            b.ok            = false;
+            auto buffer     = b.data.get();
+            const auto pos  = b.start;
+            const auto size = b.size;
+            b.pending       = std::async(std::launch::async, [obj, &ioLock, pos, buffer, size]() { return ReadObject(obj, ioLock, pos, buffer, size); });
+            frontier += size;
+            scheduled += size;
+        }
+        return scheduled;
+    }
+    void Release()
+    {
+        for (auto& b : blocks) {
+            b.Drop();
+            b.data.reset();
+        }
+    }
+};
+
+struct PageTable {
+    std::mutex ioLock; // declared first --> destroyed after the read-ahead blocks are joined
+    ReadAhead readAhead;
+    std::vector<PageSlot> slots;
+    std::unordered_map<uint64, uint32> pageToSlot;
+    uint64 tick{ 0 };
+
+    ~PageTable()
+    {
+        readAhead.Release();
+    }
+
+    uint32 Find(uint64 firstPage, uint32 count) const
+    {
+        auto it = pageToSlot.find(firstPage);
+        if (it == pageToSlot.end())
+            return INVALID_PAGE_SLOT;
+        const auto slot = it->second;
+        if (slot + count > (uint32) slots.size())
+            return INVALID_PAGE_SLOT;
+        // all pages must be stored one after another so that we can return a contiguous view
+        for (auto idx = 1U; idx < count; idx++) {
+            if (slots[slot + idx].index != firstPage + idx)
+                return INVALID_PAGE_SLOT;
+        }
+        return slot;
+    }
+    uint32 SelectVictims(uint32 count) const
+    {
+        const auto slotsCount = (uint32) slots.size();
+        if (count >= slotsCount)
+            return 0;
+        if (count == 1) {
+            auto best = 0U;
+            for (auto idx = 1U; idx < slotsCount; idx++) {
+                if (slots[idx].lastUsed < slots[best].lastUsed)
+                    best = idx;
+            }
+            return best;
+        }
+        // pick the run of 'count' slots whose most recently used page is the oldest one
+        // (sliding window maximum over the LRU ticks)
+        std::vector<uint32> dq;
+        dq.reserve(slotsCount);
+        size_t head   = 0;
+        auto best     = 0U;
+        auto bestTick = INVALID_OFFSET;
+        for (auto idx = 0U; idx < slotsCount; idx++) {
+            while ((dq.size() > head) && (slots[dq.back()].lastUsed <= slots[idx].lastUsed))
+                dq.pop_back();
+            dq.push_back(idx);
+            if (dq[head] + count <= idx)
+                head++;
+            if (idx + 1 >= count) {
+                const auto runTick = slots[dq[head]].lastUsed;
+                if (runTick < bestTick) {
+                    bestTick = runTick;
+                    best     = idx + 1 - count;
+                }
+            }
+        }
+        return best;
+    }
+    void Release(uint32 slot)
+    {
+        if (slots[slot].index != INVALID_OFFSET)
+            pageToSlot.erase(slots[slot].index);
+        slots[slot].index    = INVALID_OFFSET;
+        slots[slot].lastUsed = 0;
+    }
+    void Touch(uint32 slot, uint32 count)
+    {
+        tick++;
+        for (auto idx = 0U; idx < count; idx++)
+            slots[slot + idx].lastUsed = tick;
+    }
+};
+
+struct MappedFile {
+    const uint8* data{ nullptr };
+    uint64 size{ 0 };
+    uint32 readAheadUsers{ 0 };
+#ifdef BUILD_FOR_WINDOWS
+    HANDLE hFile{ INVALID_HANDLE_VALUE };
+    HANDLE hMapping{ nullptr };
+#endif
+
+    bool Open(const std::filesystem::path& path)
+    {
+#ifdef BUILD_FOR_WINDOWS
+        hFile = CreateFileW(
+              path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        CHECK(hFile != INVALID_HANDLE_VALUE, false, "Fail to open %s (error: %u)", path.string().c_str(), GetLastError());
+        LARGE_INTEGER fileSize;
+        CHECK(GetFileSizeEx(hFile, &fileSize), false, "Fail to get the size of %s", path.string().c_str());
+        CHECK(fileSize.QuadPart > 0, false, "Empty files can not be mapped");
+        hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CHECK(hMapping, false, "Fail to create a file mapping for %s (error: %u)", path.string().c_str(), GetLastError());
+        data = reinterpret_cast<const uint8*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+        CHECK(data, false, "Fail to map %s (error: %u)", path.string().c_str(), GetLastError());
+        size = (uint64) fileSize.QuadPart;
+#else
+        auto fd = open(path.c_str(), O_RDONLY);
+        CHECK(fd >= 0, false, "Fail to open %s", path.string().c_str());
+        struct stat st;
+        if ((fstat(fd, &st) != 0) || (!S_ISREG(st.st_mode)) || (st.st_size <= 0))
+        {
+            close(fd);
+            RETURNERROR(false, "%s is not a regular (non-empty) file", path.string().c_str());
+        }
+        // the mapping is read only => MAP_PRIVATE (no changes are ever shared back); note that touching a page that is
+        // beyond the end of the file (if the file is truncated by another process while mapped) raises SIGBUS
+        auto ptr = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping keeps its own reference to the file
+        CHECK(ptr != MAP_FAILED, false, "Fail to map %s", path.string().c_str());
+        data = reinterpret_cast<const uint8*>(ptr);
+        size = (uint64) st.st_size;
+#endif
+        return true;
+    }
+    ~MappedFile()
+    {
+#ifdef BUILD_FOR_WINDOWS
+        if (data)
+            UnmapViewOfFile(data);
+        if (hMapping)
+            CloseHandle(hMapping);
+        if (hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(hFile);
+#else
+        if (data)
+            munmap(const_cast<uint8*>(data), (size_t) size);
+#endif
+        data = nullptr;
+    }
+};
 
 DataCache::DataCache()
 {
     this->fileObj    = nullptr;
     this->cache      = nullptr;
+    this->window     = nullptr;
+    this->pageTable  = nullptr;
+    this->mapping    = nullptr;
     this->cacheSize  = 0;
     this->start      = 0;
     this->end        = 0;
     this->fileSize   = 0;
     this->currentPos = 0;
+    this->stats      = {};
 }
 DataCache::DataCache(DataCache&& obj)
 {
@@ -22,17 +277,29 @@ DataCache::DataCache(DataCache&& obj)
     end            = obj.end;
     currentPos     = obj.currentPos;
     cache          = obj.cache;
+    window         = obj.window;
+    pageTable      = obj.pageTable;
+    mapping        = obj.mapping;
     cacheSize      = obj.cacheSize;
+    stats          = obj.stats;
     obj.fileObj    = nullptr;
     obj.fileSize   = 0;
     obj.start      = 0;
     obj.end        = 0;
     obj.currentPos = 0;
     obj.cache      = nullptr;
+    obj.window     = nullptr;
+    obj.pageTable  = nullptr;
+    obj.mapping    = nullptr;
     obj.cacheSize  = 0;
+    obj.stats      = {};
 }
 DataCache::~DataCache()
 {
+    // the page table first (it waits for any pending read-ahead that still uses the file object)
+    if (this->pageTable)
+        delete reinterpret_cast<PageTable*>(this->pageTable);
+    this->pageTable = nullptr;
     if (this->fileObj)
     {
         this->fileObj->Close();
@@ -41,10 +308,14 @@ DataCache::~DataCache()
     this->fileObj = nullptr;
     if (this->cache)
         delete[] this->cache;
-    this->cache = nullptr;
+    this->cache  = nullptr;
+    this->window = nullptr;
+    if (this->mapping)
+        delete reinterpret_cast<MappedFile*>(this->mapping);
+    this->mapping = nullptr;
 }
 
-bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize)
+bool DataCache::InitObject(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize)
 {
     CHECK(this->cacheSize == 0, false, "Cache object already initialized !");
     this->fileObj = file.release(); // take ownership of the pointer
@@ -52,94 +323,224 @@ bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cache
     _cacheSize = (_cacheSize | 0xFFFF) + 1; // a minimum of 64 K for cache
     if (_cacheSize == 0)
         _cacheSize = MAX_CACHE_SIZE;
-    _cacheSize     = std::min(_cacheSize, MAX_CACHE_SIZE);
-    this->fileSize = fileObj->GetSize();
-
-    this->cache = new uint8[_cacheSize];
-    CHECK(this->cache, false, "Fail to allocate: %u bytes", _cacheSize);
+    _cacheSize      = std::min(_cacheSize, MAX_CACHE_SIZE);
+    this->fileSize  = fileObj->GetSize();
     this->cacheSize = _cacheSize;
     this->start     = 0;
     this->end       = 0;
-
+    this->window    = nullptr;
+    this->stats     = {};
+    return true;
+}
+bool DataCache::AllocatePages()
+{
+    // one extra page so that any request of up to 'cacheSize' bytes fits in a contiguous run of pages
+    // regardless of how it is aligned
+    const auto pagesCount = (this->cacheSize >> PAGE_SHIFT) + 1;
+    this->cache           = new uint8[(size_t) pagesCount << PAGE_SHIFT];
+    CHECK(this->cache, false, "Fail to allocate: %u bytes", pagesCount << PAGE_SHIFT);
+    auto table = new PageTable();
+    table->slots.resize(pagesCount);
+    table->pageToSlot.reserve(pagesCount);
+    this->pageTable = table;
+    return true;
+}
+bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize)
+{
+    CHECK(this->InitObject(std::move(file), _cacheSize), false, "");
+    return this->AllocatePages();
+}
+bool DataCache::MapFile(const std::filesystem::path& path)
+{
+    auto m = std::make_unique<MappedFile>();
+    CHECK(m->Open(path), false, "");
+    // the mapping must describe the same object as the data object
+    CHECK(m->size == this->fileSize, false, "Size mismatch between mapping (%llu) and file (%llu)", m->size, this->fileSize);
+    this->window  = m->data;
+    this->start   = 0;
+    this->end     = m->size;
+    this->mapping = m.release();
     return true;
 }
+bool DataCache::Init(std::unique_ptr<AppCUI::OS::DataObject> file, uint32 _cacheSize, const std::filesystem::path& path)
+{
+    CHECK(this->InitObject(std::move(file), _cacheSize), false, "");
+    // the entire file is available through the mapping --> pages are needed only if the file can not be mapped
+    if (this->MapFile(path))
+        return true;
+    LOG_ERROR("Fail to memory map %s (the buffered mode will be used)", path.string().c_str());
+    return this->AllocatePages();
+}
 BufferView DataCache::Get(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
 {
     CHECK(this->fileObj, BufferView(), "File was not properly initialized !");
     CHECK(requestedSize > 0, BufferView(), "'requestedSize' has to be bigger than 0 ");
 
-    if (offset >= this->start)
+    // most requests are close to the previous one --> check the last window first
+    if ((offset >= this->start) && ((offset + requestedSize) <= this->end))
     {
-        // data is cached --> return from here
-        if ((offset + requestedSize) <= this->end)
-        {
-            this->currentPos = offset + requestedSize;
-            return BufferView(&this->cache[offset - this->start], requestedSize);
-        }
-        if (this->end == this->fileSize)
-        {
-            // data is not cache (and we are at the end of the file with the case)
-            if (failIfRequestedSizeCanNotBeRead)
-                return BufferView();
-            this->currentPos = this->fileSize;
-            return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
-        }
+        this->stats.hits++;
+        this->currentPos = offset + requestedSize;
+        return BufferView(&this->window[offset - this->start], requestedSize);
     }
     // request outside file
     if (offset >= this->fileSize)
         return BufferView();
-    // data is not available in cache ==> read it
-    uint64 _start, _end;
-    if (this->fileSize <= this->cacheSize)
+
+    // clip the request to the file size and to the cache size
+    auto requestEnd = offset + requestedSize;
+    if (requestEnd > this->fileSize)
     {
-        // read everything
-        _start = 0;
-        _end   = this->fileSize;
+        if (failIfRequestedSizeCanNotBeRead)
+            return BufferView();
+        requestEnd = this->fileSize;
+    }
+    if (this->mapping)
+    {
+        // the window always covers the entire file
+        this->stats.hits++;
+        this->currentPos = requestEnd;
+        return BufferView(&this->window[offset], (uint32) (requestEnd - offset));
+    }
+    if (requestEnd - offset > this->cacheSize)
+    {
+        if (failIfRequestedSizeCanNotBeRead)
+            return BufferView();
+        requestEnd = offset + this->cacheSize;
+    }
+
+    auto table      = reinterpret_cast<PageTable*>(this->pageTable);
+    auto firstPage  = offset >> PAGE_SHIFT;
+    auto pagesCount = (uint32) (((requestEnd - 1) >> PAGE_SHIFT) - firstPage + 1);
+    auto slot       = table->Find(firstPage, pagesCount);
+    if (slot == INVALID_PAGE_SLOT)
+    {
+        this->stats.misses++;
+        // small files are read entirely (all subsequent requests will be served from the cache)
+        if (this->fileSize <= this->cacheSize)
+        {
+            firstPage  = 0;
+            pagesCount = (uint32) (((this->fileSize - 1) >> PAGE_SHIFT) + 1);
+        }
+        // the pages we need might already be cached, but not one after another --> drop them
+        for (auto idx = 0U; idx < pagesCount; idx++)
+        {
+            auto it = table->pageToSlot.find(firstPage + idx);
+            if (it != table->pageToSlot.end())
+                table->Release(it->second);
+        }
+        slot = table->SelectVictims(pagesCount);
+        for (auto idx = 0U; idx < pagesCount; idx++)
+            table->Release(slot + idx);
+
+        const auto readStart = firstPage << PAGE_SHIFT;
+        const auto readSize  = (uint32) std::min<uint64>((uint64) pagesCount << PAGE_SHIFT, this->fileSize - readStart);
+        auto* readBuffer     = this->cache + ((size_t) slot << PAGE_SHIFT);
+        // the last window might be overwritten
+        this->start  = 0;
+        this->end    = 0;
+        this->window = nullptr;
+        if (this->ReadFromObject(readStart, readBuffer, readSize) == false)
+            return BufferView();
+        for (auto idx = 0U; idx < pagesCount; idx++)
+        {
+            table->slots[slot + idx].index     = firstPage + idx;
+            table->pageToSlot[firstPage + idx] = slot + idx;
+        }
     }
     else
     {
-        // compute the new buffer to read
-        auto sz = requestedSize;
-        if ((offset + sz) > this->fileSize)
-            sz = (uint32) (this->fileSize - offset);
-        if (sz > this->cacheSize)
-            sz = this->cacheSize;
-        auto diff = this->cacheSize - sz;
-        if (diff <= offset)
-            _start = offset - diff;
-        else
-            _start = 0;
-        _end = _start + this->cacheSize;
-        if (_end > this->fileSize)
-            _end = this->fileSize;
-    }
-    // read new data in cache
-    if (this->fileObj->SetCurrentPos(_start) == false)
-        return BufferView();
-    if (this->fileObj->Read(this->cache, (uint32) (_end - _start)) == false)
+        this->stats.hits++;
+    }
+    table->Touch(slot, pagesCount);
+
+    // the new window covers all the pages we have just used
+    this->start  = firstPage << PAGE_SHIFT;
+    this->end    = std::min<uint64>(this->start + ((uint64) pagesCount << PAGE_SHIFT), this->fileSize);
+    this->window = this->cache + ((size_t) slot << PAGE_SHIFT);
+
+    this->currentPos = requestEnd;
+    return BufferView(&this->window[offset - this->start], (uint32) (requestEnd - offset));
+}
+bool DataCache::ReadFromObject(uint64 offset, uint8* buffer, uint32 size)
+{
+    auto table     = reinterpret_cast<PageTable*>(this->pageTable);
+    auto& ra       = table->readAhead;
+    const auto end = offset + size;
+    auto pos       = offset;
+
+    while (pos < end)
     {
-        this->start = 0;
-        this->end   = 0;
-        return BufferView();
+        // data that was already read in background is copied from the read-ahead blocks
+        auto block = ra.Find(pos);
+        if (block)
+        {
+            if (block->Wait())
+            {
+                const auto sz = (uint32) (std::min<uint64>(end, block->start + block->size) - pos);
+                memcpy(buffer + (pos - offset), block->data.get() + (pos - block->start), sz);
+                this->stats.readAhead += sz;
+                pos += sz;
+                continue;
+            }
+            // the background read failed --> try again synchronously
+            block->Drop();
+        }
+        const auto next = ra.NextBlockStart(pos, end);
+        CHECK(ReadObject(this->fileObj, table->ioLock, pos, buffer + (pos - offset), (uint32) (next - pos)),
+              false,
+              "Fail to read %llu bytes from %llu offset",
+              next - pos,
+              pos);
+        this->stats.bytesRead += next - pos;
+        pos = next;
     }
-    // return new pointer
-    this->start = _start;
-    this->end   = _end;
-    if ((offset + requestedSize) <= this->end)
+    if (ra.users > 0)
+        this->stats.bytesRead += ra.Schedule(this->fileObj, table->ioLock, end, this->fileSize);
+    return true;
+}
+void DataCache::StartReadAhead()
+{
+    if (this->mapping)
     {
-        this->currentPos = offset + requestedSize;
-        return BufferView(&this->cache[offset - this->start], requestedSize);
+        auto m = reinterpret_cast<MappedFile*>(this->mapping);
+#ifndef BUILD_FOR_WINDOWS
+        // the kernel does the actual read-ahead for mapped files, it only needs to know about the access pattern
+        if (m->readAheadUsers == 0)
+            madvise(const_cast<uint8*>(m->data), (size_t) m->size, MADV_SEQUENTIAL);
+#endif
+        m->readAheadUsers++;
+        return;
     }
-    // the entire data is not in our cache
-    if (failIfRequestedSizeCanNotBeRead)
-        return BufferView();
-    if (this->end == this->fileSize)
+    CHECKRET(this->pageTable, "Cache object was not initialized !");
+    auto& ra = reinterpret_cast<PageTable*>(this->pageTable)->readAhead;
+    if (ra.users == 0)
     {
-        this->currentPos = this->fileSize;
-        return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+        ra.blockSize = this->cacheSize;
+        for (auto& b : ra.blocks)
+            b.data.reset(new uint8[this->cacheSize]);
     }
-    this->currentPos = this->end;
-    return BufferView(&this->cache[offset - this->start], (uint32) (this->end - offset));
+    ra.users++;
+}
+void DataCache::StopReadAhead()
+{
+    if (this->mapping)
+    {
+        auto m = reinterpret_cast<MappedFile*>(this->mapping);
+        CHECKRET(m->readAheadUsers > 0, "StopReadAhead called without a matching StartReadAhead");
+        m->readAheadUsers--;
+#ifndef BUILD_FOR_WINDOWS
+        if (m->readAheadUsers == 0)
+            madvise(const_cast<uint8*>(m->data), (size_t) m->size, MADV_NORMAL);
+#endif
+        return;
+    }
+    CHECKRET(this->pageTable, "Cache object was not initialized !");
+    auto& ra = reinterpret_cast<PageTable*>(this->pageTable)->readAhead;
+    CHECKRET(ra.users > 0, "StopReadAhead called without a matching StartReadAhead");
+    ra.users--;
+    if (ra.users == 0)
+        ra.Release();
 }
 bool DataCache::CopyObject(void* buffer, uint64 offset, uint32 requestedSize)
 {
@@ -149,27 +550,68 @@ bool DataCache::CopyObject(void* buffer, uint64 offset, uint32 requestedSize)
     memcpy(buffer, b.GetData(), b.GetLength());
     return true;
 }
-Buffer DataCache::CopyToBuffer(uint64 offset, uint32 requestedSize, bool failIfRequestedSizeCanNotBeRead)
+bool DataCache::ForEachChunk(uint64 offset, uint64 size, const ChunkCallback& callback, uint32 chunkSize)
+{
+    CHECK(callback, false, "Invalid callback");
+    CHECK(offset <= this->fileSize, false, "Invalid offset (%llu) , should be less than %llu ", offset, this->fileSize);
+    size = std::min<uint64>(size, this->fileSize - offset);
+
+    if (this->mapping)
+    {
+        // no need to split the data, but keep the chunk size so that the callers see the same granularity
+        chunkSize = chunkSize == 0 ? 0x100000 : chunkSize;
+    }
+    else
+    {
+        if ((chunkSize == 0) || (chunkSize > this->cacheSize))
+            chunkSize = this->cacheSize >> 1;
+    }
+
+    while (size > 0)
+    {
+        const auto toRead = (uint32) std::min<uint64>(chunkSize, size);
+        auto bv           = this->Get(offset, toRead, true);
+        CHECK(bv.GetLength() == toRead, false, "Unable to read %u bytes from %llu offset", toRead, offset);
+        if (!callback(offset, bv))
+            return true;
+        offset += toRead;
+        size -= toRead;
+    }
+    return true;
+}
+Buffer DataCache::CopyToBuffer(uint64 offset, uint64 requestedSize, bool failIfRequestedSizeCanNotBeRead)
 {
     // sanity checks
     CHECK(requestedSize > 0, Buffer(), "Invalid requested size (should be bigger than 0)");
     CHECK(offset <= this->fileSize, Buffer(), "Invalid offset (%llu) , should be less than %llu ", offset, this->fileSize);
     if (failIfRequestedSizeCanNotBeRead)
     {
-        CHECK(offset + (uint64) requestedSize <= this->fileSize, Buffer(), "Unable to read %u bytes from %llu", requestedSize, offset);
+        CHECK(offset + requestedSize <= this->fileSize, Buffer(), "Unable to read %llu bytes from %llu", requestedSize, offset);
     }
+    CHECK(requestedSize <= (uint64) SIZE_MAX, Buffer(), "Requested size (%llu) does not fit in memory", requestedSize);
 
     Buffer b{};
-    b.Resize(requestedSize);
-    uint32 toRead = this->cacheSize >> 1;
+    if (this->mapping)
+    {
+        // single copy straight from the mapping
+        const auto available = std::min<uint64>(requestedSize, this->fileSize - offset);
+        b.Resize((size_t) available);
+        if (available > 0)
+            memcpy(b.GetData(), &this->window[offset], (size_t) available);
+        this->currentPos = offset + available;
+        this->stats.hits++;
+        return b;
+    }
+    b.Resize((size_t) requestedSize);
+    uint64 toRead = this->cacheSize >> 1;
     auto p        = b.GetData();
     while (requestedSize)
     {
-        toRead  = std::min(toRead, requestedSize);
-        auto bv = this->Get(offset, toRead, false);
+        toRead  = std::min<uint64>(toRead, requestedSize);
+        auto bv = this->Get(offset, (uint32) toRead, false);
         if (bv.Empty())
         {
-            LOG_ERROR("Empty buffer received when reading %u bytes from %llu offset", toRead, offset);
+            LOG_ERROR("Empty buffer received when reading %llu bytes from %llu offset", toRead, offset);
             if (failIfRequestedSizeCanNotBeRead)
                 return Buffer();
             // trim the buffer size to the amount of data that was read
@@ -178,7 +620,7 @@ Buffer DataCache::CopyToBuffer(uint64 offset, uint32 requestedSize, bool failIfR
         }
         if (toRead != bv.GetLength())
         {
-            LOG_ERROR("Only %u bytes received when trying to read %u bytes from %llu offset", bv.GetLength(), toRead, offset);
+            LOG_ERROR("Only %u bytes received when trying to read %llu bytes from %llu offset", (uint32) bv.GetLength(), toRead, offset);
             if (failIfRequestedSizeCanNotBeRead)
                 return Buffer();
             // copy the buffer that was read
@@ -191,14 +633,14 @@ Buffer DataCache::CopyToBuffer(uint64 offset, uint32 requestedSize, bool failIfR
             b.Resize(p - b.GetData());
             return b;
         }
-        memcpy(p, bv.GetData(), toRead);
+        memcpy(p, bv.GetData(), (size_t) toRead);
         p += toRead;
         offset += toRead;
         requestedSize -= toRead;
     }
     return b;
 }
-bool DataCache::WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint32 size)
+bool DataCache::WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset, uint64 size)
 {
     CHECK(output->SetSize(size), false, "");
     CHECK(output->SetCurrentPos(0), false, "");
@@ -206,15 +648,16 @@ bool DataCache::WriteTo(Reference<AppCUI::OS::DataObject> output, uint64 offset,
     if (size == 0)
         return true; // nothing to write
 
-    uint32 toRead = this->cacheSize >> 1;
-    while (size)
-    {
-        toRead  = std::min(toRead, size);
-        auto bv = this->Get(offset, toRead, true);
-        CHECK(bv.IsValid(), false, "");
-        CHECK(output->Write(bv.begin(), toRead), false, "");
-        offset += toRead;
-        size -= toRead;
-    }
-    return true;
+    CHECK(offset + size <= this->fileSize, false, "Unable to write %llu bytes from %llu offset", size, offset);
+    bool written = true;
+    CHECK(ForEachChunk(offset,
+                       size,
+                       [&output, &written](uint64, BufferView chunk)
+                       {
+                           written = output->Write(chunk.begin(), (uint32) chunk.GetLength());
+                           return written;
+                       }),
+          false,
+          "");
+    return written;
 }
@@ -0,0 +1,303 @@
+#include "Internal.hpp"
+
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define GVIEW_STRINGS_SSE2
+#endif
+
+using namespace GView::Utils;
+
+constexpr uint32 BLOCK_SIZE       = 64;
+constexpr uint64 EVEN_BITS        = 0x5555555555555555ULL;
+constexpr uint64 ODD_BITS         = 0xAAAAAAAAAAAAAAAAULL;
+constexpr uint32 FIND_CHUNK_SIZE  = 0x10000;
+constexpr uint32 UNLIMITED_LENGTH = 0xFFFFFFFF;
+
+namespace
+{
+// bit i of 'chars' => byte i is part of the mask, bit i of 'zeros' => byte i is 0
+struct BlockBits {
+    uint64 chars;
+    uint64 zeros;
+};
+
+#ifdef GVIEW_STRINGS_SSE2
+inline uint32 ClassifyLane(const uint8* p, const uint8 ranges[][2], uint32 rangesCount, uint32& zeros)
+{
+    const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    auto result     = _mm_setzero_si128();
+    for (uint32 idx = 0; idx < rangesCount; idx++)
+    {
+        // unsigned compares: x >= lo <=> max(x,lo) == x ; x <= hi <=> min(x,hi) == x
+        const auto ge = _mm_cmpeq_epi8(_mm_max_epu8(data, _mm_set1_epi8(static_cast<char>(ranges[idx][0]))), data);
+        const auto le = _mm_cmpeq_epi8(_mm_min_epu8(data, _mm_set1_epi8(static_cast<char>(ranges[idx][1]))), data);
+        result        = _mm_or_si128(result, _mm_and_si128(ge, le));
+    }
+    zeros = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_setzero_si128())));
+    return static_cast<uint32>(_mm_movemask_epi8(result));
+}
+#endif
+
+// classifies up to 64 bytes (bits beyond 'size' are 0)
+inline BlockBits ClassifyBlock(const uint8* p, size_t size, const bool mask[256], const uint8 ranges[][2], uint32 rangesCount)
+{
+    BlockBits bits{ 0, 0 };
+#ifdef GVIEW_STRINGS_SSE2
+    if (rangesCount > 0)
+    {
+        uint8 tmp[BLOCK_SIZE];
+        if (size < BLOCK_SIZE)
+        {
+            memcpy(tmp, p, size);
+            memset(tmp + size, 0, BLOCK_SIZE - size);
+            p = tmp;
+        }
+        for (uint32 lane = 0; lane < BLOCK_SIZE; lane += 16)
+        {
+            uint32 zeros;
+            bits.chars |= static_cast<uint64>(ClassifyLane(p + lane, ranges, rangesCount, zeros)) << lane;
+            bits.zeros |= static_cast<uint64>(zeros) << lane;
+        }
+        if (size < BLOCK_SIZE)
+        {
+            const auto valid = (1ULL << size) - 1;
+            bits.chars &= valid;
+            bits.zeros &= valid;
+        }
+        return bits;
+    }
+#endif
+    for (size_t idx = 0; idx < size; idx++)
+    {
+        bits.chars |= static_cast<uint64>(mask[p[idx]]) << idx;
+        bits.zeros |= static_cast<uint64>(p[idx] == 0) << idx;
+    }
+    return bits;
+}
+
+// consecutive set bits starting from 'pos' (only positions with the same parity as 'pos' when stride2 is set)
+uint64 RunLength(const std::vector<uint64>& bits, uint64 pos, uint64 size, bool stride2)
+{
+    const auto start  = pos;
+    const auto filler = stride2 ? ((pos & 1) ? EVEN_BITS : ODD_BITS) : 0;
+    while (pos < size)
+    {
+        const auto bit  = static_cast<uint32>(pos & 63);
+        const auto word = ~(bits[pos >> 6] | filler) >> bit;
+        if (word)
+        {
+            pos += std::countr_zero(word);
+            break;
+        }
+        pos += BLOCK_SIZE - bit;
+    }
+    pos = std::min<>(pos, size);
+    return stride2 ? (pos - start + 1) / 2 : pos - start;
+}
+
+uint64 NextSetBit(const std::vector<uint64>& bits, uint64 pos, uint64 size)
+{
+    while (pos < size)
+    {
+        const auto bit  = static_cast<uint32>(pos & 63);
+        const auto word = bits[pos >> 6] >> bit;
+        if (word)
+            return std::min<>(pos + std::countr_zero(word), size);
+        pos += BLOCK_SIZE - bit;
+    }
+    return size;
+}
+} // namespace
+
+StringsExtractor::StringsExtractor()
+{
+    SetMask(0x20, 0x7E);
+    mask['\t']   = true;
+    ranges[1][0] = '\t';
+    ranges[1][1] = '\t';
+    rangesCount  = 2;
+}
+void StringsExtractor::SetMask(uint8 from, uint8 to)
+{
+    for (uint32 idx = 0; idx < 256; idx++)
+        mask[idx] = (idx >= from) && (idx <= to);
+    ranges[0][0] = from;
+    ranges[0][1] = to;
+    rangesCount  = from <= to ? 1 : 0;
+}
+void StringsExtractor::SetMask(const bool newMask[256])
+{
+    memcpy(mask, newMask, sizeof(mask));
+
+    // try to express the mask as a few intervals (vectorizable range compares)
+    rangesCount = 0;
+    for (uint32 idx = 0; idx < 256;)
+    {
+        if (!mask[idx])
+        {
+            idx++;
+            continue;
+        }
+        auto end = idx;
+        while ((end + 1 < 256) && (mask[end + 1]))
+            end++;
+        if (rangesCount == MAX_RANGES)
+        {
+            rangesCount = 0;
+            return;
+        }
+        ranges[rangesCount][0] = static_cast<uint8>(idx);
+        ranges[rangesCount][1] = static_cast<uint8>(end);
+        rangesCount++;
+        idx = end + 1;
+    }
+}
+
+uint32 StringsExtractor::GetAsciiLength(BufferView buffer, uint32 maxLength) const
+{
+    const auto size = std::min<size_t>(buffer.GetLength(), maxLength);
+    for (size_t pos = 0; pos < size; pos += BLOCK_SIZE)
+    {
+        const auto count = std::min<size_t>(size - pos, BLOCK_SIZE);
+        const auto bits  = ClassifyBlock(buffer.GetData() + pos, count, mask, ranges, rangesCount);
+        if (~bits.chars)
+            return static_cast<uint32>(std::min<size_t>(pos + std::countr_zero(~bits.chars), size));
+    }
+    return static_cast<uint32>(size);
+}
+
+uint32 StringsExtractor::GetUnicodeLength(BufferView buffer, uint32 maxLength) const
+{
+    // a character is valid at an even position 'i' if byte[i] is in the mask and byte[i+1] is 0
+    const auto size = std::min<uint64>(buffer.GetLength() & (~static_cast<size_t>(1)), static_cast<uint64>(maxLength) * 2);
+    for (size_t pos = 0; pos < size; pos += BLOCK_SIZE)
+    {
+        const auto count = std::min<size_t>(size - pos, BLOCK_SIZE);
+        const auto bits  = ClassifyBlock(buffer.GetData() + pos, count, mask, ranges, rangesCount);
+        const auto valid = bits.chars & (bits.zeros >> 1) & EVEN_BITS;
+        // 'count' is even, so the last character of the block is always complete
+        const auto word  = ~(valid | ODD_BITS);
+        if (word)
+            return static_cast<uint32>(std::min<size_t>(pos + std::countr_zero(word), size) / 2);
+    }
+    return static_cast<uint32>(size / 2);
+}
+
+bool StringsExtractor::Find(
+      BufferView buffer,
+      uint64 bufferOffset,
+      uint32 minLength,
+      uint32 maxLength,
+      bool ascii,
+      bool unicode,
+      const RunCallback& callback,
+      uint64* pending) const
+{
+    const uint64 size = buffer.GetLength();
+    if (pending)
+        *pending = bufferOffset + size;
+    if ((size == 0) || ((!ascii) && (!unicode)))
+        return true;
+    minLength = std::max<>(minLength, 1U);
+    if (maxLength == 0)
+        maxLength = UNLIMITED_LENGTH;
+    // below this length, the outcome for a run depends on the bytes that follow it
+    const auto decisiveLength = std::max<>(minLength, maxLength);
+
+    // chars: byte is in the mask ; wide: byte is in the mask and the next one is 0 (UTF-16LE character)
+    const auto wordsCount = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::vector<uint64> chars(wordsCount), wide(unicode ? wordsCount : 0);
+    const auto* data = buffer.GetData();
+    bool nextZero    = false;
+    for (auto word = wordsCount; word > 0; word--)
+    {
+        const auto pos  = (word - 1) * BLOCK_SIZE;
+        const auto bits = ClassifyBlock(data + pos, std::min<uint64>(size - pos, BLOCK_SIZE), mask, ranges, rangesCount);
+        chars[word - 1] = bits.chars;
+        if (unicode)
+            wide[word - 1] = bits.chars & ((bits.zeros >> 1) | (static_cast<uint64>(nextZero) << 63));
+        nextZero = (bits.zeros & 1) != 0;
+    }
+
+    uint64 pos = 0;
+    while (pos < size)
+    {
+        pos = NextSetBit(chars, pos, size);
+        if (pos >= size)
+            break;
+
+        const auto asciiLength = RunLength(chars, pos, size, false);
+        // the run reaches the end of the buffer => it might continue (let the caller provide more data)
+        if (pending && ascii && (pos + asciiLength >= size) && (asciiLength < decisiveLength))
+        {
+            *pending = bufferOffset + pos;
+            return true;
+        }
+        if (ascii && (asciiLength >= minLength))
+        {
+            const auto length = std::min<uint64>(asciiLength, maxLength);
+            if (!callback(bufferOffset + pos, bufferOffset + pos + length, StringType::Ascii))
+                return false;
+            pos += length;
+            continue;
+        }
+        if (unicode)
+        {
+            const auto unicodeLength = RunLength(wide, pos, size, true);
+            // the last character (or its 0 high byte) might be outside the buffer
+            if (pending && (pos + unicodeLength * 2 + 2 > size) && (unicodeLength < decisiveLength))
+            {
+                *pending = bufferOffset + pos;
+                return true;
+            }
+            if (unicodeLength >= minLength)
+            {
+                const auto length = std::min<uint64>(unicodeLength, maxLength) * 2;
+                if (!callback(bufferOffset + pos, bufferOffset + pos + length, StringType::Unicode))
+                    return false;
+                pos += length;
+                continue;
+            }
+        }
+        // a suffix of a short ASCII run is also short, but its last character can still start an UTF-16 string
+        pos += (unicode && (asciiLength > 1)) ? asciiLength - 1 : asciiLength;
+    }
+    return true;
+}
+
+bool StringsExtractor::Find(
+      GView::Utils::DataCache& cache,
+      uint64 offset,
+      uint64 size,
+      uint32 minLength,
+      uint32 maxLength,
+      bool ascii,
+      bool unicode,
+      const RunCallback& callback) const
+{
+    const auto end = std::min<uint64>(offset + size, cache.GetSize());
+    // keep a chunk larger than the longest string that can be reported
+    const auto chunkSize = std::max<uint64>(FIND_CHUNK_SIZE, maxLength == 0 ? 0 : static_cast<uint64>(maxLength) * 2 + 2);
+    while (offset < end)
+    {
+        const auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(end - offset, chunkSize)), false);
+        CHECK(buffer.IsValid(), false, "Fail to read %llu bytes from offset: %llu", std::min<uint64>(end - offset, chunkSize), offset);
+        const auto last = offset + buffer.GetLength() >= end;
+        uint64 resume   = 0;
+        if (!Find(buffer, offset, minLength, maxLength, ascii, unicode, callback, last ? nullptr : &resume))
+            return false;
+        if (last)
+            break;
+        if (resume == offset)
+        {
+            // a string (without a length limit) that covers the entire chunk - report it as it is
+            if (!Find(buffer, offset, minLength, maxLength, ascii, unicode, callback))
+                return false;
+            resume = offset + buffer.GetLength();
+        }
+        offset = resume;
+    }
+    return true;
+}
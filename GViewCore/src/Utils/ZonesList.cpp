@@ -3,9 +3,104 @@
 using namespace GView::Utils;
 using namespace AppCUI::Graphics;
 
+// a flattened, non-overlapping view over the zones: each segment is painted by the zone that wins there
+// (the one that starts last; for equal starts the shortest one), so a lookup is a binary search
+struct ZoneSegment {
+    uint64 low;
+    uint64 high;
+    uint32 zone;
+};
+
+// The segments are rebuilt lazily (by the first lookup after zones were added) and lookups remember the last segment
+// that was hit, so the const lookups of ZonesList modify the 'mutable' state below => a ZonesList must not be used
+// from multiple threads at the same time (even for lookups only).
 struct ZonesListContext {
     std::vector<Zone> zones{};
-    std::vector<Zone> cache{};
+    mutable std::vector<ZoneSegment> segments{};
+    mutable bool dirty{ false };
+
+    // segments that intersect the visible interval + the last segment that was hit (lookups are mostly sequential)
+    mutable Zone::Interval cacheInterval{};
+    mutable size_t cacheFirst{ 0 };
+    mutable size_t cacheLast{ 0 };
+    mutable size_t lastHit{ 0 };
+
+    void Build() const
+    {
+        segments.clear();
+        lastHit    = 0;
+        cacheFirst = 0;
+        cacheLast  = 0;
+        dirty      = false;
+
+        std::vector<uint32> starts, ends;
+        starts.reserve(zones.size());
+        for (uint32 i = 0; i < static_cast<uint32>(zones.size()); i++) {
+            if (zones[i].interval.low <= zones[i].interval.high && zones[i].interval.low != INVALID_OFFSET) {
+                starts.push_back(i);
+            }
+        }
+        if (starts.empty())
+            return;
+        ends = starts;
+        std::sort(starts.begin(), starts.end(), [this](uint32 a, uint32 b) { return zones[a].interval.low < zones[b].interval.low; });
+        std::sort(ends.begin(), ends.end(), [this](uint32 a, uint32 b) { return zones[a].interval.high < zones[b].interval.high; });
+
+        // active zones ordered by priority - the first one paints the current segment
+        const auto priority = [this](uint32 a, uint32 b) {
+            const auto& za = zones[a].interval;
+            const auto& zb = zones[b].interval;
+            if (za.low != zb.low)
+                return za.low > zb.low;
+            if (za.high != zb.high)
+                return za.high < zb.high;
+            return a > b;
+        };
+        std::set<uint32, decltype(priority)> active(priority);
+
+        // a zone stops covering offsets at high + 1 (zones that reach the last offset are clamped to it)
+        const auto endOf = [this](uint32 idx) {
+            const auto high = zones[idx].interval.high;
+            return high == INVALID_OFFSET ? INVALID_OFFSET : high + 1;
+        };
+
+        size_t si = 0, ei = 0;
+        uint64 previous = 0;
+        while (si < starts.size() || ei < ends.size()) {
+            uint64 next = INVALID_OFFSET;
+            if (si < starts.size())
+                next = zones[starts[si]].interval.low;
+            if (ei < ends.size())
+                next = std::min<uint64>(next, endOf(ends[ei]));
+
+            if (active.empty() == false && next > previous) {
+                const auto winner = *active.begin();
+                if (segments.empty() == false && segments.back().zone == winner && segments.back().high + 1 == previous) {
+                    segments.back().high = next - 1;
+                } else {
+                    segments.push_back({ previous, next - 1, winner });
+                }
+            }
+            if (next == INVALID_OFFSET)
+                break;
+
+            while (ei < ends.size() && endOf(ends[ei]) == next) {
+                active.erase(ends[ei++]);
+            }
+            while (si < starts.size() && zones[starts[si]].interval.low == next) {
+                active.insert(starts[si++]);
+            }
+            previous = next;
+        }
+    }
+
+    size_t Find(size_t first, size_t last, uint64 position) const
+    {
+        // first segment (in [first, last)) that ends at/after position
+        auto it = std::lower_bound(
+              segments.begin() + first, segments.begin() + last, position, [](const ZoneSegment& s, uint64 pos) { return s.high < pos; });
+        return static_cast<size_t>(it - segments.begin());
+    }
 };
 
 ZonesList::ZonesList()
@@ -13,6 +108,19 @@ ZonesList::ZonesList()
     context = new ZonesListContext;
 }
 
+ZonesList::ZonesList(const ZonesList& other)
+{
+    context = new ZonesListContext(*reinterpret_cast<ZonesListContext*>(other.context));
+}
+
+ZonesList& ZonesList::operator=(const ZonesList& other)
+{
+    if (this != &other) {
+        *reinterpret_cast<ZonesListContext*>(context) = *reinterpret_cast<ZonesListContext*>(other.context);
+    }
+    return *this;
+}
+
 ZonesList::~ZonesList()
 {
     if (context != nullptr) {
@@ -25,6 +133,7 @@ bool ZonesList::Add(uint64 s, uint64 e, ColorPair c, std::string_view txt)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(s, e, c, txt);
+    ctx->dirty = true;
     return true;
 }
 
@@ -33,21 +142,57 @@ bool ZonesList::Add(const Zone& zone)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
     ctx->zones.emplace_back(zone);
+    ctx->dirty = true;
     return true;
 }
 
 std::optional<Zone> ZonesList::OffsetToZone(uint64 position) const
 {
     CHECK(context != nullptr, std::nullopt, "");
-    auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
-
-    for (const auto& zone : ctx->cache) {
-        if (zone.interval.low <= position && position <= zone.interval.high) {
-            return zone;
-        }
+    auto ctx = reinterpret_cast<const ZonesListContext*>(this->context);
+    if (ctx->dirty) {
+        ctx->Build();
+    }
+    const auto& segments = ctx->segments;
+    if (segments.empty())
+        return std::nullopt;
+
+    // fast path - same segment as the previous lookup or the one right after it
+    auto index = ctx->lastHit;
+    if (index < segments.size() && segments[index].low <= position && position <= segments[index].high) {
+        return ctx->zones[segments[index].zone];
     }
+    if (index + 1 < segments.size() && segments[index].high < position && position <= segments[index + 1].high) {
+        index++;
+    } else if (ctx->cacheFirst < ctx->cacheLast && ctx->cacheInterval.low <= position && position <= ctx->cacheInterval.high) {
+        index = ctx->Find(ctx->cacheFirst, ctx->cacheLast, position);
+    } else {
+        index = ctx->Find(0, segments.size(), position);
+    }
+    if (index >= segments.size())
+        return std::nullopt;
+
+    // misses are expected (offsets between zones) - no logging on this path, it runs for every byte on screen
+    ctx->lastHit = index;
+    if (segments[index].low > position)
+        return std::nullopt;
+    return ctx->zones[segments[index].zone];
+}
 
-    return std::nullopt;
+bool ZonesList::ForEachInInterval(const Zone::Interval& interval, const std::function<bool(uint64 low, uint64 high, const Zone& zone)>& callback) const
+{
+    CHECK(context != nullptr, false, "");
+    auto ctx = reinterpret_cast<const ZonesListContext*>(this->context);
+    if (ctx->dirty) {
+        ctx->Build();
+    }
+    const auto& segments = ctx->segments;
+    for (auto index = ctx->Find(0, segments.size(), interval.low); index < segments.size() && segments[index].low <= interval.high; index++) {
+        const auto& s = segments[index];
+        if (callback(std::max<>(s.low, interval.low), std::min<>(s.high, interval.high), ctx->zones[s.zone]) == false)
+            return false;
+    }
+    return true;
 }
 
 bool ZonesList::SetCache(const Zone::Interval& interval)
@@ -55,21 +200,20 @@ bool ZonesList::SetCache(const Zone::Interval& interval)
     CHECK(context != nullptr, false, "");
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
-    ctx->cache.clear();
-
-    for (const auto& zone : ctx->zones) {
-        if ((zone.interval.low >= interval.low && zone.interval.low <= interval.high) ||
-            interval.low >= zone.interval.low && interval.low <= zone.interval.high) {
-            ctx->cache.push_back(zone);
-        }
+    // the segments are only rebuilt after zones were added - moving the view just narrows the search window
+    if (ctx->dirty) {
+        ctx->Build();
+    } else if (ctx->cacheInterval.low == interval.low && ctx->cacheInterval.high == interval.high) {
+        return true;
     }
 
-    std::sort(ctx->cache.begin(), ctx->cache.end(), [](const Zone& a, const Zone& b) {
-        if (a.interval.low == b.interval.low) {
-            return a.interval.high < b.interval.high;
-        }
-        return a.interval.low > b.interval.low;
-    });
+    ctx->cacheInterval = interval;
+    ctx->cacheFirst    = ctx->Find(0, ctx->segments.size(), interval.low);
+    ctx->cacheLast     = ctx->cacheFirst;
+    while (ctx->cacheLast < ctx->segments.size() && ctx->segments[ctx->cacheLast].low <= interval.high) {
+        ctx->cacheLast++;
+    }
+    ctx->lastHit = ctx->cacheFirst;
 
     return true;
 }
@@ -80,20 +224,25 @@ void ZonesList::Clear()
     auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
 
     ctx->zones.clear();
-    ctx->cache.clear();
+    ctx->segments.clear();
+    ctx->dirty         = false;
+    ctx->cacheInterval = {};
+    ctx->cacheFirst    = 0;
+    ctx->cacheLast     = 0;
+    ctx->lastHit       = 0;
 }
 
 uint32 ZonesList::GetCount() const
 {
     CHECK(context != nullptr, 0, "");
-    auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
+    auto ctx = reinterpret_cast<const ZonesListContext*>(this->context);
     return static_cast<uint32>(ctx->zones.size());
 }
 
 std::optional<Zone> ZonesList::GetZone(uint32 index) const
 {
     CHECK(context != nullptr, std::nullopt, "");
-    auto ctx = reinterpret_cast<ZonesListContext*>(this->context);
+    auto ctx = reinterpret_cast<const ZonesListContext*>(this->context);
     CHECK(index < ctx->zones.size(), std::nullopt, "");
     return ctx->zones.at(index);
 }
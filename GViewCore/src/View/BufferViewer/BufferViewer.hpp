@@ -2,6 +2,8 @@
 
 #include "Internal.hpp"
 
+#include <algorithm>
+
 namespace GView::View::BufferViewer
 {
 using namespace AppCUI;
@@ -67,6 +69,65 @@ struct Config {
     void Initialize();
 };
 
+enum class SearchMode : uint8 {
+    First, // first match (forward)
+    Last,  // last match (backward)
+    All    // every match, in file order
+};
+class SearchEngine
+{
+  public:
+    using MatchCallback    = std::function<bool(uint64 start, uint64 size)>;    // return false to stop the search
+    using ProgressCallback = std::function<bool(uint64 processed, uint64 total)>; // return false to cancel the search
+
+  private:
+    enum class PatternType : uint8 { None, Literal, Regex, UnicodeRegex };
+    struct ChunkMatch {
+        uint64 start;
+        uint64 size;
+    };
+
+    // literal pattern: a byte 'b' matches position 'i' if (b & masks[i]) == values[i] (mask 0 => any byte)
+    std::vector<uint8> values;
+    std::vector<uint8> masks;
+    uint32 anchor; // position that is searched for first (memchr)
+    std::unique_ptr<GView::Regex::Matcher> regex; // RE2 objects can be used from multiple threads
+    PatternType type;
+
+    uint32 GetOverlap() const;
+    // SearchMode::First stops after the first match, SearchMode::Last also reports overlapping matches (so that the last
+    // one is never skipped) and SearchMode::All reports non-overlapping matches
+    void SearchLiteral(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out);
+    void SearchRegex(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out);
+    void SearchUnicodeRegex(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out);
+    void SearchChunk(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out);
+
+  public:
+    SearchEngine();
+
+    void Clear();
+    bool SetBytes(const std::vector<uint8>& bytes, const std::vector<uint8>& bytesMasks);
+    bool SetText(std::string_view text, bool ignoreCase);
+    bool SetUnicodeText(std::u16string_view text, bool ignoreCase);
+    bool SetRegex(std::string_view expression, bool unicode, bool ignoreCase);
+    inline bool IsValid() const
+    {
+        return type != PatternType::None;
+    }
+
+    // Searches the matches that start in [start, end) and fit in [start, limit). The range is split in overlapping chunks
+    // that are searched in parallel, the results are reported (on the calling thread) in file order - or in reverse order
+    // for SearchMode::Last. Returns false if the data could not be read or the search was canceled.
+    bool Search(
+          GView::Utils::DataCache& cache,
+          uint64 start,
+          uint64 end,
+          uint64 limit,
+          SearchMode mode,
+          const MatchCallback& onMatch,
+          const ProgressCallback& onProgress = nullptr);
+};
+
 class FindDialog : public Window, public Handlers::OnCheckInterface
 {
   private:
@@ -92,14 +153,31 @@ class FindDialog : public Window, public Handlers::OnCheckInterface
 
     Reference<CheckBox> ignoreCase;
     Reference<CheckBox> alingTextToUpperLeftCorner;
+    Reference<CheckBox> findAll;
 
     uint64 position{ 0 };
     uint64 length{ 0 };
 
     UnicodeStringBuilder usb;
+    SearchEngine engine;
     std::pair<uint64, uint64> match;
     bool newRequest{ true };
-    bool ProcessInput(uint64 end = GView::Utils::INVALID_OFFSET, bool last = false);
+
+    // "find all" results - sorted by offset, built in a single scan and reused for next/previous navigation
+    struct Hit
+    {
+        uint64 offset;
+        uint32 length;
+    };
+    std::vector<Hit> hits; // also the overlay of the hits (no zones are built for it)
+    bool hitsIndexed{ false };
+    bool hitsTruncated{ false };
+
+    bool PreparePattern();
+    std::vector<std::pair<uint64, uint64>> GetSearchRanges();
+    bool ProcessInput(bool backward = false);
+    bool BuildHitsIndex();
+    bool FindInHitsIndex(bool backward);
 
   public:
     FindDialog();
@@ -131,6 +209,25 @@ class FindDialog : public Window, public Handlers::OnCheckInterface
         CHECK(start != GView::Utils::INVALID_OFFSET && length > 0, false, "");
         return true;
     }
+    bool HasHitsIndex() const
+    {
+        return hitsIndexed && hits.empty() == false;
+    }
+    size_t GetHitsCount() const
+    {
+        return hits.size();
+    }
+    // calls callback(start, end) for the hits that intersect [start, end) - hits are sorted and disjoint, so only the
+    // hit before the first one that starts in the range may reach into it
+    template <typename T>
+    void ForEachHitInRange(uint64 start, uint64 end, T&& callback) const
+    {
+        auto it = std::upper_bound(hits.begin(), hits.end(), start, [](uint64 pos, const Hit& hit) { return pos < hit.offset; });
+        if ((it != hits.begin()) && ((it - 1)->offset + (it - 1)->length > start))
+            it--;
+        for (; (it != hits.end()) && (it->offset < end); it++)
+            callback(it->offset, it->offset + it->length);
+    }
 };
 
 namespace Commands
@@ -245,6 +342,7 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
         uint64 start, end, middle;
         uint32 minCount{ 4 };
         bool AsciiMask[256];
+        GView::Utils::StringsExtractor extractor; // kept in sync with AsciiMask
         StringType type;
         String asciiMaskRepr;
         bool showAscii{ true };
@@ -255,6 +353,27 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
         ColorPair Normal, Line, Highlighted;
     } CursorColors;
 
+    // colors of the bytes that are on screen - resolved once per paint, one layer (selection, hits, plugins, strings,
+    // zones) at a time, over the whole visible window
+    struct FrameByte {
+        ColorPair color;
+        uint8 flags;
+        uint8 text; // the byte that is displayed in the text column (unicode strings show every other byte)
+    };
+    struct {
+        uint64 start{ GView::Utils::INVALID_OFFSET };
+        uint32 size{ 0 };              // bytes on screen
+        std::vector<uint8> data;       // bytes on screen + a look-ahead (strings, similar selections, plugins)
+        std::vector<FrameByte> bytes;  // one entry for every byte on screen
+        std::vector<BufferColor> spans; // colored by the type plugin (GetColorsForRange)
+        uint32 unresolved{ 0 };
+
+        inline const FrameByte* Get(uint64 offset) const
+        {
+            return (offset >= start) && (offset - start < size) ? &bytes[offset - start] : nullptr;
+        }
+    } Frame;
+
     struct {
         uint8 buffer[256]{ 0 };
         uint32 size{ 0 };
@@ -314,12 +433,18 @@ class Instance : public View::ViewControl, public GView::Utils::SelectionZoneInt
     void MoveTillNextBlock(bool select, int dir);
 
     void UpdateStringInfo(uint64 offset);
+    void UpdateStringInfo(uint64 offset, BufferView buf);
     void ResetStringInfo();
     std::string_view GetAsciiMaskStringRepresentation();
     bool SetStringAsciiMask(string_view stringRepresentation);
 
     ColorPair OffsetToColorZone(uint64 offset);
     ColorPair OffsetToColor(uint64 offset);
+    bool ComputeFrame();
+    void SetFrameColor(uint64 offset, ColorPair color);
+    void SetFrameZonesColors(const GView::Utils::ZonesList& zones);
+    void SetFrameStringsColors();
+    void SetFrameTypeColors();
 
     void AnalyzeMousePosition(int x, int y, MousePositionInfo& mpInfo);
 
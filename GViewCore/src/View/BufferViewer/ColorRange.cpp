@@ -0,0 +1,40 @@
+#include "BufferViewer.hpp"
+
+#include <algorithm>
+
+namespace GView::View::BufferViewer
+{
+void ColorRangeByZones(uint64 offset, uint64 size, BufferView buf, const std::vector<std::pair<uint64, uint64>>& zones, bool checkHeaders, const OpcodeColorCallback& colorOpcode, std::vector<BufferColor>& spans)
+{
+    // only the zones that intersect the range (sorted by start) - walked once, along with the range
+    std::vector<std::pair<uint64, uint64>> visible;
+    for (const auto& [start, end] : zones) {
+        if (start < offset + size && end > offset) {
+            visible.emplace_back(start, end);
+        }
+    }
+    std::sort(visible.begin(), visible.end());
+
+    const auto count = std::min<uint64>(size, buf.GetLength());
+    size_t zone      = 0;
+    BufferColor color;
+    for (uint64 i = 0; i < count;) {
+        const auto pos = offset + i;
+        while (zone < visible.size() && visible[zone].second <= pos) {
+            zone++;
+        }
+        const auto executable = zone < visible.size() && visible[zone].first <= pos;
+        if (!executable && !checkHeaders) {
+            // nothing can be colored until the next zone
+            i = zone < visible.size() ? visible[zone].first - offset : count;
+            continue;
+        }
+        if (colorOpcode(pos, BufferView(buf.GetData() + i, (size_t) std::min<uint64>(16, buf.GetLength() - i)), executable, color)) {
+            spans.push_back(color);
+            i = color.end + 1 - offset;
+        } else {
+            i++;
+        }
+    }
+}
+} // namespace GView::View::BufferViewer
@@ -162,24 +162,16 @@ bool CopyDialog::Process()
 
             std::vector<Info> infos;
 
-            auto UpdateStringInfo = [this](uint64 offset, BufferView buf, Info& info) -> bool
+            const auto stringInfo = instance->GetStringInfo();
+            auto UpdateStringInfo = [&stringInfo](uint64 offset, BufferView buf, Info& info) -> bool
             {
-                auto* s = reinterpret_cast<char16*>(const_cast<uint8*>(buf.GetData()));
-                auto* e = s + buf.GetLength() / 2;
-                if ((s < e) && ((*s) < 256) && (instance->GetStringInfo().AsciiMask[*s]))
+                const auto count = stringInfo.extractor.GetUnicodeLength(buf);
+                if ((count > 0) && (count >= stringInfo.minCount))
                 {
-                    while ((s < e) && ((*s) < 256) && (instance->GetStringInfo().AsciiMask[*s]))
-                    {
-                        s++;
-                    }
-
-                    if (s - reinterpret_cast<char16*>(const_cast<uint8*>(buf.GetData())) >= instance->GetStringInfo().minCount)
-                    {
-                        info.start  = offset;
-                        info.middle = offset + (s - reinterpret_cast<char16*>(const_cast<uint8*>(buf.GetData())));
-                        info.end    = offset + (reinterpret_cast<const uint8*>(s) - buf.GetData());
-                        return true;
-                    }
+                    info.start  = offset;
+                    info.middle = offset + count;
+                    info.end    = offset + count * 2ULL;
+                    return true;
                 }
 
                 return false;
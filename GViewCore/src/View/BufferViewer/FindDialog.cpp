@@ -1,7 +1,6 @@
 #include "BufferViewer.hpp"
 
 #include <array>
-#include <regex>
 #include <charconv>
 
 namespace GView::View::BufferViewer
@@ -22,6 +21,7 @@ constexpr int32 CHECKBOX_ID_ALIGN_TEXT_UPPER_LEFT = 12;
 constexpr int32 RADIOBOX_ID_TEXT_HEX              = 13;
 constexpr int32 RADIOBOX_ID_TEXT_DEC              = 14;
 constexpr int32 CHECKBOX_ID_TEXT_REGEX            = 15;
+constexpr int32 CHECKBOX_ID_FIND_ALL              = 16;
 
 constexpr int32 GROUPD_ID_SEARCH_TYPE    = 1;
 constexpr int32 GROUPD_ID_TEXT_TYPE      = 2;
@@ -32,7 +32,7 @@ constexpr int32 GROUPD_ID_BUFFER_ACTION  = 5;
 constexpr uint32 DIALOG_HEIGHT_TEXT_FORMAT      = 18;
 constexpr uint32 DESCRIPTION_HEIGHT_TEXT_FORMAT = 3;
 constexpr std::string_view TEXT_FORMAT_TITLE    = "Text Pattern";
-constexpr std::string_view TEXT_FORMAT_BODY     = "Plain text or regex (ECMAScript) to find. Alt+I to focus on input text field.";
+constexpr std::string_view TEXT_FORMAT_BODY     = "Plain text or regex (RE2 syntax) to find. Alt+I to focus on input text field.";
 
 constexpr std::string_view BINARY_FORMAT_TITLE = "Binary Pattern";
 constexpr std::array<std::string_view, 4> BINARY_FORMAT_BODY{ "Binary pattern to find. Alt+I to focus on input text field.",
@@ -45,6 +45,9 @@ constexpr uint32 DESCRIPTION_HEIGHT_BINARY_FORMAT = DESCRIPTION_HEIGHT_TEXT_FORM
 
 constexpr std::string_view ANYTHING_PATTERN{ "???" };
 
+// upper bound for the "find all" index (16 bytes per hit) - past it, next/previous fall back to scanning
+constexpr size_t MAX_INDEXED_HITS = 0x1000000;
+
 FindDialog::FindDialog()
     : Window("Find", "d:c,w:30%,h:18", WindowFlags::ProcessReturn | WindowFlags::Sizeable), currentPos(GView::Utils::INVALID_OFFSET),
       position(GView::Utils::INVALID_OFFSET), match({ GView::Utils::INVALID_OFFSET, 0 })
@@ -98,6 +101,9 @@ FindDialog::FindDialog()
     alingTextToUpperLeftCorner->SetChecked(true);
     alingTextToUpperLeftCorner->Handlers()->OnCheck = this;
 
+    findAll                      = Factory::CheckBox::Create(this, "Find &all (index hits)", "x:60%,y:11,w:40%,h:1", CHECKBOX_ID_FIND_ALL);
+    findAll->Handlers()->OnCheck = this;
+
     Factory::Button::Create(this, "&OK", "x:25%,y:100%,a:b,w:12", BTN_ID_OK);
     Factory::Button::Create(this, "&Cancel", "x:75%,y:100%,a:b,w:12", BTN_ID_CANCEL);
 
@@ -115,9 +121,9 @@ bool FindDialog::OnEvent(Reference<Control>, Event eventType, int ID)
             Exit(Dialogs::Result::Cancel);
             return true;
         case BTN_ID_OK:
-            Exit(Dialogs::Result::Ok);
+            CHECK(PreparePattern(), true, "");
             newRequest = true;
-            CHECK(ProcessInput(), false, "");
+            Exit(Dialogs::Result::Ok);
             return true;
         }
     }
@@ -125,9 +131,9 @@ bool FindDialog::OnEvent(Reference<Control>, Event eventType, int ID)
     switch (eventType)
     {
     case Event::WindowAccept:
-        Exit(Dialogs::Result::Ok);
+        CHECK(PreparePattern(), true, "");
         newRequest = true;
-        CHECK(ProcessInput(), false, "");
+        Exit(Dialogs::Result::Ok);
         return true;
     case Event::WindowClose:
         Exit(Dialogs::Result::Cancel);
@@ -274,6 +280,7 @@ bool FindDialog::Update()
     bufferMoveCursorTo->MoveTo(bufferMoveCursorTo->GetX(), bufferMoveCursorTo->GetY() + deltaSigned);
     ignoreCase->MoveTo(ignoreCase->GetX(), ignoreCase->GetY() + deltaSigned);
     alingTextToUpperLeftCorner->MoveTo(alingTextToUpperLeftCorner->GetX(), alingTextToUpperLeftCorner->GetY() + deltaSigned);
+    findAll->MoveTo(findAll->GetX(), findAll->GetY() + deltaSigned);
 
     return true;
 }
@@ -297,28 +304,31 @@ void FindDialog::UpdateData(uint64 currentPos, Reference<GView::Object> object)
 std::pair<uint64, uint64> FindDialog::GetNextMatch(uint64 currentPos)
 {
     this->currentPos = currentPos;
-    ProcessInput();
+    if (newRequest)
+    {
+        newRequest = false;
+        match      = { GView::Utils::INVALID_OFFSET, 0 };
+        hits.clear();
+        hitsIndexed   = false;
+        hitsTruncated = false;
+        if (findAll->IsChecked())
+        {
+            BuildHitsIndex();
+        }
+    }
+    if (FindInHitsIndex(false) == false)
+    {
+        ProcessInput();
+    }
     return match;
 }
 
 std::pair<uint64, uint64> FindDialog::GetPreviousMatch(uint64 currentPos)
 {
-    const auto initialCurrentPos = this->currentPos;
-    while (true)
-    {
-        const auto end   = currentPos - 1;
-        this->currentPos = this->object->GetData().GetCacheSize() > currentPos ? 0 : currentPos - this->object->GetData().GetCacheSize();
-        ProcessInput(end, true);
-        if (HasResults())
-        {
-            this->currentPos = match.first;
-            break;
-        }
-        CHECKBK(this->currentPos, "");
-    };
-    if (HasResults() == false)
+    this->currentPos = currentPos;
+    if (FindInHitsIndex(true) == false)
     {
-        this->currentPos = initialCurrentPos;
+        ProcessInput(true);
     }
     return match;
 }
@@ -369,7 +379,7 @@ bool ValidateHex(std::string_view number)
         CHECK((number[0] >= '0' && number[0] <= '9') || (number[0] >= 'a' && number[0] <= 'f') || (number[0] >= 'A' && number[0] <= 'F'), false, "");
         if (number.size() == 2)
         {
-            CHECK((number[0] >= '1' && number[1] <= '9') || (number[1] >= 'a' && number[1] <= 'f') || (number[1] >= 'A' && number[1] <= 'F'), false, "");
+            CHECK((number[1] >= '0' && number[1] <= '9') || (number[1] >= 'a' && number[1] <= 'f') || (number[1] >= 'A' && number[1] <= 'F'), false, "");
         }
     }
     else
@@ -380,12 +390,9 @@ bool ValidateHex(std::string_view number)
     return true;
 }
 
-bool FindDialog::ProcessInput(uint64 end, bool last)
+bool FindDialog::PreparePattern()
 {
-    CHECK(currentPos != GView::Utils::INVALID_OFFSET, false, "");
-    CHECK(object.IsValid(), false, "");
     CHECK(input.IsValid(), false, "");
-
     if (input->GetText().Len() == 0)
     {
         Dialogs::MessageBox::ShowError("Error!", "Missing input!");
@@ -395,40 +402,116 @@ bool FindDialog::ProcessInput(uint64 end, bool last)
     CHECK(usb.Set(input->GetText()), false, "");
     CHECK(usb.Len() > 0, false, "");
 
-    if (newRequest)
+    if (textOption->IsChecked())
     {
-        match      = { GView::Utils::INVALID_OFFSET, 0 };
-        newRequest = false;
+        if (textRegex->IsChecked())
+        {
+            std::string expression;
+            usb.ToString(expression);
+            if (engine.SetRegex(expression, textUnicode->IsChecked(), ignoreCase->IsChecked()) == false)
+            {
+                Dialogs::MessageBox::ShowError("Error!", "Invalid regular expression!");
+                return false;
+            }
+            return true;
+        }
+        if (textAscii->IsChecked())
+        {
+            std::string ascii;
+            usb.ToString(ascii);
+            return engine.SetText(ascii, ignoreCase->IsChecked());
+        }
+        return engine.SetUnicodeText(usb.ToStringView(), ignoreCase->IsChecked());
     }
 
-    std::vector<TypeInterface::SelectionZone> selectedZones;
-    for (auto i = 0U; i < this->object->GetContentType()->GetSelectionZonesCount(); i++)
-    {
-        selectedZones.emplace_back(this->object->GetContentType()->GetSelectionZone(i));
-    }
+    // binary pattern: bytes separated through spaces, '?' means any byte
+    std::string input;
+    usb.ToString(input);
 
-    const auto computeForFile = !searchSelection->IsChecked();
+    std::vector<uint8> bytes, masks;
+    bytes.reserve(input.size() / 2 + 1);
+    masks.reserve(input.size() / 2 + 1);
 
-    auto objectSize = 0ULL;
-    if (computeForFile)
+    size_t pos = 0;
+    while (pos < input.size())
     {
-        if (last && end != GView::Utils::INVALID_OFFSET)
+        if (input[pos] == ' ')
         {
-            objectSize = end - currentPos;
+            pos++;
+            continue;
         }
-        else
+        auto next = input.find_first_of(' ', pos);
+        if (next == std::string::npos)
         {
-            objectSize = object->GetData().GetSize();
+            next = input.size();
         }
+        std::string_view number{ input.data() + pos, next - pos };
+        pos = next;
+
+        if ((textDec->IsChecked() ? ValidateDecimal(number) : ValidateHex(number)) == false)
+        {
+            Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
+            return false;
+        }
+
+        if (number[0] == '?')
+        {
+            bytes.push_back(0);
+            masks.push_back(0);
+            continue;
+        }
+
+        uint8 n;
+        const std::from_chars_result result = std::from_chars(number.data(), number.data() + number.size(), n, textDec->IsChecked() ? 10 : 16);
+        if (result.ec == std::errc::invalid_argument || result.ec == std::errc::result_out_of_range)
+        {
+            Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
+            return false;
+        }
+        bytes.push_back(n);
+        masks.push_back(0xFF);
     }
-    else
+    if (bytes.empty())
     {
-        for (auto& sz : selectedZones)
+        Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
+        return false;
+    }
+
+    return engine.SetBytes(bytes, masks);
+}
+
+std::vector<std::pair<uint64, uint64>> FindDialog::GetSearchRanges()
+{
+    // every range is a [start, end) interval that the matches must fit in
+    std::vector<std::pair<uint64, uint64>> ranges;
+    if (searchSelection->IsChecked())
+    {
+        for (auto i = 0U; i < this->object->GetContentType()->GetSelectionZonesCount(); i++)
         {
-            objectSize += sz.end - sz.start + 1;
+            const auto zone = this->object->GetContentType()->GetSelectionZone(i);
+            ranges.emplace_back(zone.start, zone.end + 1);
         }
+        std::sort(ranges.begin(), ranges.end());
     }
-    ProgressStatus::Init("Searching...", objectSize);
+    else
+    {
+        ranges.emplace_back(0, object->GetData().GetSize());
+    }
+    return ranges;
+}
+
+bool FindDialog::BuildHitsIndex()
+{
+    CHECK(object.IsValid(), false, "");
+    CHECK(engine.IsValid(), false, "");
+
+    const auto ranges = GetSearchRanges();
+    auto objectSize   = 0ULL;
+    for (const auto& [start, end] : ranges)
+    {
+        objectSize += end - start;
+    }
+    ProgressStatus::Init("Indexing matches...", objectSize);
 
     LocalString<512> ls;
     const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
@@ -437,251 +520,132 @@ bool FindDialog::ProcessInput(uint64 end, bool last)
         format = "[0x%.16llX/0x%.16llX] bytes...";
     }
 
-    const auto block = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : object->GetData().GetCacheSize();
-
-    const auto SearchInAsciiChunk = [&](uint64 offset, uint64 left, const std::regex& pattern)
+    auto searched     = 0ULL;
+    auto cancelled    = false;
+    const auto Found  = [&](uint64 start, uint64 size)
     {
-        do
+        if (hits.size() >= MAX_INDEXED_HITS)
         {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
-
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
-
-            const auto buffer = object->GetData().Get(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
-
-            const auto initialStart = reinterpret_cast<char const*>(buffer.GetData());
-            auto start              = reinterpret_cast<char const*>(buffer.GetData());
-            const auto end          = reinterpret_cast<char const*>(start + buffer.GetLength());
-            std::cmatch matches{};
-            while (std::regex_search(start, end, matches, pattern))
-            {
-                match = std::pair<uint64, uint64>{ offset + (start - initialStart) + matches.position(), matches.length() };
-                start += matches.position() + matches.length();
-                CHECKBK(last, "");
-            }
-
-            offset += sizeToRead;
-        } while (left > 0);
-
+            hitsTruncated = true;
+            return false;
+        }
+        // regex matches may be longer than 4GB in theory - the index keeps them clamped, navigation only needs the start
+        hits.push_back({ start, static_cast<uint32>(std::min<uint64>(size, 0xFFFFFFFF)) });
         return true;
     };
-
-    const auto SearchInUnicodeChunk = [&](uint64 offset, uint64 left, const std::wregex& pattern)
+    const auto Progress = [&](uint64 processed, uint64)
     {
-        do
-        {
-            CHECK(ProgressStatus::Update(offset, ls.Format(format, offset, objectSize)) == false, false, "");
-
-            const auto sizeToRead = (left >= block ? block : left);
-            left -= (left >= block ? block : left);
-
-            const auto buffer = object->GetData().Get(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
-
-            auto initialStart = reinterpret_cast<wchar_t const*>(buffer.GetData());
-            auto start        = reinterpret_cast<wchar_t const*>(buffer.GetData());
-            const auto end    = reinterpret_cast<wchar_t const*>(start + buffer.GetLength());
-            std::wcmatch matches{};
-            while (std::regex_search(start, end, matches, pattern))
-            {
-                match = std::pair<uint64, uint64>{ offset + (start - initialStart) * sizeof(wchar_t) + matches.position(), matches.length() };
-                start += matches.position() + matches.length();
-                CHECKBK(last, "");
-            }
-
-            offset += sizeToRead;
-        } while (left > 0);
-
-        return true;
+        cancelled = ProgressStatus::Update(searched + processed, ls.Format(format, searched + processed, objectSize));
+        return cancelled == false;
     };
 
-    if (textOption->IsChecked())
+    // ranges are sorted and disjoint, so hits come out sorted as well
+    for (const auto& [start, end] : ranges)
     {
-        if (textAscii->IsChecked())
+        if (start >= end)
+            continue;
+        if (engine.Search(object->GetData(), start, end, end, SearchMode::All, Found, Progress) == false)
         {
-            std::string ascii;
-            usb.ToString(ascii);
-
-            if (textRegex->IsChecked() == false)
-            {
-                const static std::regex specialChars{ R"([-[\]{}()*+?.,\^$|#\s])" };
-                ascii = std::regex_replace(ascii, specialChars, R"(\$&)");
-            }
-
-            const std::regex pattern(
-                  ascii,
-                  (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                           : std::regex_constants::ECMAScript | std::regex_constants::optimize));
-
-            if (computeForFile)
-            {
-                auto offset = currentPos;
-                auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
-
-                CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
-            }
-            else
-            {
-                for (const auto& zone : selectedZones)
-                {
-                    auto offset = zone.start;
-                    auto left   = zone.end - zone.start + 1;
-
-                    CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                    CHECK(HasResults() == false, true, "");
-                }
-            }
+            // read error or canceled by the user - a partial index would silently skip matches, so drop it and
+            // fall back to plain scanning
+            hits.clear();
+            hitsTruncated = false;
+            return false;
         }
-        else
-        {
-            std::wstring unicode{ reinterpret_cast<const wchar_t*>(usb.ToStringView().data()), usb.ToStringView().size() };
+        if (hitsTruncated)
+            break;
+        searched += end - start;
+    }
 
-            if (textRegex->IsChecked() == false)
-            {
-                const static std::wregex specialChars{ LR"([-[\]{}()*+?.,\^$|#\s])" };
-                unicode = std::regex_replace(unicode, specialChars, LR"(\$&)");
-            }
+    hitsIndexed = true;
 
-            const std::wregex pattern(
-                  reinterpret_cast<wchar_t const* const>(usb.ToStringView().data()),
-                  (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                           : std::regex_constants::ECMAScript | std::regex_constants::optimize));
+    return true;
+}
 
-            if (computeForFile)
-            {
-                auto offset = currentPos;
-                auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
+bool FindDialog::FindInHitsIndex(bool backward)
+{
+    if ((hitsIndexed == false) || (currentPos == GView::Utils::INVALID_OFFSET))
+        return false; // no index => plain scanning
 
-                CHECK(SearchInUnicodeChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
-            }
-            else
-            {
-                for (const auto& zone : selectedZones)
-                {
-                    auto offset = zone.start;
-                    auto left   = zone.end - zone.start + 1;
-
-                    CHECK(SearchInUnicodeChunk(offset, left, pattern), false, "");
-                    CHECK(HasResults() == false, true, "");
-                }
-            }
-        }
-    }
-    else
+    if (backward)
     {
-        std::string input;
-        usb.ToString(input);
+        // last hit that starts at/before currentPos - a truncated index is only complete up to its last entry
+        auto it = std::upper_bound(hits.begin(), hits.end(), currentPos, [](uint64 pos, const Hit& hit) { return pos < hit.offset; });
+        if ((it == hits.end()) && (hitsTruncated))
+            return false;
+        if (it == hits.begin())
+            return true; // no hit before currentPos
+        --it;
+        match = { it->offset, it->length };
+        return true;
+    }
 
-        std::string regexPayload;
-        regexPayload.reserve(input.size() * 2);
+    auto it = std::lower_bound(hits.begin(), hits.end(), currentPos, [](const Hit& hit, uint64 pos) { return hit.offset < pos; });
+    if (it == hits.end())
+    {
+        // past the last indexed hit - only a truncated index needs a rescan
+        return hitsTruncated == false;
+    }
+    match = { it->offset, it->length };
+    return true;
+}
 
-        uint64 last    = 0;
-        uint64 current = input.find_first_of(' ', last);
-        do
-        {
-            if (current == std::string::npos)
-            {
-                current = input.size();
-            }
+bool FindDialog::ProcessInput(bool backward)
+{
+    CHECK(currentPos != GView::Utils::INVALID_OFFSET, false, "");
+    CHECK(object.IsValid(), false, "");
+    CHECK(engine.IsValid(), false, "");
 
-            std::string_view number{ input.data() + last, current - last };
+    if (newRequest)
+    {
+        match      = { GView::Utils::INVALID_OFFSET, 0 };
+        newRequest = false;
+    }
 
-            if (textDec->IsChecked())
-            {
-                if (ValidateDecimal(number) == false)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (number[0] == '?')
-                {
-                    regexPayload.append("[\\x00-\\xFF]");
-                }
-                else
-                {
-                    uint8 n;
-                    const std::from_chars_result resultFrom = std::from_chars(number.data(), number.data() + number.size(), n);
-                    if (resultFrom.ec == std::errc::invalid_argument || resultFrom.ec == std::errc::result_out_of_range)
-                    {
-                        Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
-                        return false;
-                    }
-
-                    char hex[10]                        = { 0 };
-                    const std::to_chars_result resultTo = std::to_chars(std::begin(hex), std::end(hex), n, 16);
-                    if (resultTo.ec == std::errc::invalid_argument || resultTo.ec == std::errc::result_out_of_range)
-                    {
-                        Dialogs::MessageBox::ShowError("Error!", "Invalid input - conversion failed!");
-                        return false;
-                    }
-                    regexPayload.append("\\x");
-                    if (hex[1] == 0)
-                    {
-                        regexPayload.append("0");
-                    }
-                    regexPayload.append(hex);
-                }
-            }
-            else
-            {
-                if (number.size() > 2)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (ValidateHex(number) == false)
-                {
-                    Dialogs::MessageBox::ShowError("Error!", "Invalid input!");
-                    return false;
-                }
-
-                if (number[0] == '?')
-                {
-                    regexPayload.append("[\\x00-\\xFF]");
-                }
-                else
-                {
-                    regexPayload.append("\\x");
-                    if (number.size() == 1)
-                    {
-                        regexPayload.append("0");
-                    }
-                    regexPayload.append(number);
-                }
-            }
-            last = current + 1;
-        } while ((current = input.find_first_of(' ', last)) && last < input.size());
+    const auto ranges = GetSearchRanges();
 
-        const std::regex pattern(
-              regexPayload,
-              (ignoreCase->IsChecked() ? std::regex_constants::icase | std::regex_constants::ECMAScript | std::regex_constants::optimize
-                                       : std::regex_constants::ECMAScript | std::regex_constants::optimize));
+    // forward searches look for matches that start at/after currentPos, backward ones for matches that start at/before it
+    auto objectSize = 0ULL;
+    for (const auto& [start, end] : ranges)
+    {
+        const auto from = backward ? start : std::max<uint64>(start, currentPos);
+        const auto to   = backward ? std::min<uint64>(end, currentPos + 1) : end;
+        objectSize += to > from ? to - from : 0;
+    }
+    ProgressStatus::Init("Searching...", objectSize);
 
-        if (computeForFile)
-        {
-            auto offset = currentPos;
-            auto left   = (last && end != GView::Utils::INVALID_OFFSET) ? (end - currentPos) : (object->GetData().GetSize() - currentPos);
+    LocalString<512> ls;
+    const char* format = "Reading [0x%.8llX/0x%.8llX] bytes...";
+    if (objectSize > 0xFFFFFFFF)
+    {
+        format = "[0x%.16llX/0x%.16llX] bytes...";
+    }
 
-            CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-            CHECK(HasResults() == false, true, "");
-        }
-        else
-        {
-            for (const auto& zone : selectedZones)
-            {
-                auto offset = zone.start;
-                auto left   = zone.end - zone.start + 1;
+    auto searched    = 0ULL;
+    auto found       = false;
+    const auto mode  = backward ? SearchMode::Last : SearchMode::First;
+    const auto Found = [&](uint64 start, uint64 size)
+    {
+        match = { start, size };
+        found = true;
+        return false;
+    };
+    const auto Progress = [&](uint64 processed, uint64)
+    {
+        return ProgressStatus::Update(searched + processed, ls.Format(format, searched + processed, objectSize)) == false;
+    };
 
-                CHECK(SearchInAsciiChunk(offset, left, pattern), false, "");
-                CHECK(HasResults() == false, true, "");
-            }
-        }
+    for (size_t idx = 0; idx < ranges.size(); idx++)
+    {
+        const auto& [start, end] = ranges[backward ? ranges.size() - 1 - idx : idx];
+        const auto from          = backward ? start : std::max<uint64>(start, currentPos);
+        const auto to            = backward ? std::min<uint64>(end, currentPos + 1) : end;
+        if (from >= to)
+            continue;
+        CHECK(engine.Search(object->GetData(), from, to, end, mode, Found, Progress), false, "");
+        if (found)
+            return true;
+        searched += to - from;
     }
 
     return false;
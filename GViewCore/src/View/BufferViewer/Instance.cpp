@@ -6,6 +6,10 @@ using namespace GView::View::BufferViewer;
 using namespace AppCUI::Input;
 using namespace Commands;
 
+constexpr uint32 STRING_LOOKAHEAD   = 1024; // bytes that are checked (from the current offset) to find the end of a string
+constexpr uint8 FRAME_BYTE_RESOLVED = 0x01; // the color of the byte was set by a layer (the next ones are skipped)
+constexpr uint8 FRAME_BYTE_BLANK    = 0x02; // second half of a unicode string (displayed as a space)
+
 const char hexCharsList[]              = "0123456789ABCDEF";
 const uint32 characterFormatModeSize[] = { 2 /*Hex*/, 3 /*Oct*/, 4 /*signed 8*/, 3 /*unsigned 8*/ };
 const std::string_view hex_header      = "00 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F 10 11 12 13 14 15 16 17 18 19 1A 1B 1C 1D 1E 1F ";
@@ -46,6 +50,7 @@ Instance::Instance(Reference<GView::Object> _obj, Settings* _settings)
     this->chars.Fill('*', 1024, ColorPair{ Color::Black, Color::Transparent });
 
     memcpy(this->StringInfo.AsciiMask, DefaultAsciiMask, 256);
+    this->StringInfo.extractor.SetMask(this->StringInfo.AsciiMask);
 
     this->bufColor.Reset();
     this->ResetStringInfo();
@@ -411,7 +416,10 @@ void Instance::ResetStringInfo()
 }
 void Instance::UpdateStringInfo(uint64 offset)
 {
-    auto buf = this->obj->GetData().Get(offset, 1024, false);
+    UpdateStringInfo(offset, this->obj->GetData().Get(offset, STRING_LOOKAHEAD, false));
+}
+void Instance::UpdateStringInfo(uint64 offset, BufferView buf)
+{
     if (!buf.IsValid()) {
         ResetStringInfo();
         return;
@@ -419,37 +427,26 @@ void Instance::UpdateStringInfo(uint64 offset)
 
     // check for ascii
     if (this->StringInfo.showAscii) {
-        auto* s = buf.GetData();
-        auto* e = s + buf.GetLength();
-
-        if (StringInfo.AsciiMask[*s]) {
-            while ((s < e) && (StringInfo.AsciiMask[*s]))
-                s++;
-            if (s - buf.GetData() >= StringInfo.minCount) {
-                // ascii string found
-                StringInfo.start = offset;
-                StringInfo.end   = offset + (s - buf.GetData());
-                StringInfo.type  = StringType::Ascii;
-                return;
-            }
+        const auto count = StringInfo.extractor.GetAsciiLength(buf);
+        if ((count > 0) && (count >= StringInfo.minCount)) {
+            // ascii string found
+            StringInfo.start = offset;
+            StringInfo.end   = offset + count;
+            StringInfo.type  = StringType::Ascii;
+            return;
         }
     }
 
     // check for unicode
     if (this->StringInfo.showUnicode) {
-        auto* s = (char16*) buf.GetData();
-        auto* e = s + buf.GetLength() / 2;
-        if ((s < e) && ((*s) < 256) && (StringInfo.AsciiMask[*s])) {
-            while ((s < e) && ((*s) < 256) && (StringInfo.AsciiMask[*s]))
-                s++;
-            if (s - (char16*) buf.GetData() >= StringInfo.minCount) {
-                // ascii string found
-                StringInfo.start  = offset;
-                StringInfo.end    = offset + ((const uint8*) s - buf.GetData());
-                StringInfo.middle = offset + (s - (char16*) buf.GetData());
-                StringInfo.type   = StringType::Unicode;
-                return;
-            }
+        const auto count = StringInfo.extractor.GetUnicodeLength(buf);
+        if ((count > 0) && (count >= StringInfo.minCount)) {
+            // unicode string found
+            StringInfo.start  = offset;
+            StringInfo.end    = offset + count * 2ULL;
+            StringInfo.middle = offset + count;
+            StringInfo.type   = StringType::Unicode;
+            return;
         }
     }
 
@@ -458,46 +455,16 @@ void Instance::UpdateStringInfo(uint64 offset)
     StringInfo.middle = GView::Utils::INVALID_OFFSET;
     StringInfo.type   = StringType::None;
 
-    {
-        auto* s = buf.GetData();
-        auto* e = s + buf.GetLength();
-
-        while (s < e) {
-            while ((s < e) && (!StringInfo.AsciiMask[*s]))
-                s++;
-            if (s == e)
-                break;
-            // reached a possible string --> check for minim size
-            auto* s_s = s;
-            auto* s_e = s + StringInfo.minCount;
-            if (s_e <= e) {
-                while ((s_s < s_e) && (StringInfo.AsciiMask[*s_s]))
-                    s_s++;
-                if (s_s == s_e) {
-                    // found a possible string at 's' position --> stop before 's'
-                    StringInfo.end = offset + (s - buf.GetData());
-                    return;
-                }
-            }
-            // check if not an unicode string
-            auto* u_s = (char16_t*) s;
-            auto* u_e = u_s + StringInfo.minCount;
-            if ((((const uint8*) u_e) + 1) <= e) {
-                while ((u_s < u_e) && (*u_s < 256) && (StringInfo.AsciiMask[*u_s]))
-                    u_s++;
-                if (u_s == u_e) {
-                    // found a possible unicode at 's' position --> stop before 's'
-                    StringInfo.end = offset + (s - buf.GetData());
-                    return;
-                }
-            }
-            // no possible string found --> advance to next non_ascii character
-            if (s_s > s)
-                s = s_s;
-            else
-                s++; // move to next
-        }
-    }
+    // stop before the first possible (ascii or unicode) string
+    auto found = false;
+    StringInfo.extractor.Find(
+          buf, offset, StringInfo.minCount, 0, true, true, [this, &found](uint64 start, uint64, GView::Utils::StringsExtractor::StringType) {
+              StringInfo.end = start;
+              found          = true;
+              return false;
+          });
+    if (found)
+        return;
     // all buffer was process and nothing was found
     StringInfo.end = offset + buf.GetLength();
 }
@@ -515,6 +482,7 @@ bool Instance::SetStringAsciiMask(string_view stringRepresentation)
     cSet.ClearAll();
     if (cSet.Set(stringRepresentation, true)) {
         cSet.CopySetTo(this->StringInfo.AsciiMask);
+        this->StringInfo.extractor.SetMask(this->StringInfo.AsciiMask);
         return true;
     }
     return false;
@@ -546,6 +514,14 @@ ColorPair Instance::OffsetToColor(uint64 offset)
         }
     }
 
+    // "find all" hits
+    if (findDialog.HasHitsIndex()) {
+        auto hit = false;
+        findDialog.ForEachHitInRange(offset, offset + 1, [&hit](uint64, uint64) { hit = true; });
+        if (hit)
+            return Cfg.Selection.SimilarText;
+    }
+
     // color
     if (settings) {
         if (showObjectsHighlighting) {
@@ -613,6 +589,204 @@ ColorPair Instance::OffsetToColor(uint64 offset)
     // not a string --> check the zone
     return OffsetToColorZone(offset);
 }
+void Instance::SetFrameColor(uint64 offset, ColorPair color)
+{
+    auto& b = Frame.bytes[offset - Frame.start];
+    if ((b.flags & FRAME_BYTE_RESOLVED) == 0) {
+        b.color = color;
+        b.flags |= FRAME_BYTE_RESOLVED;
+        Frame.unresolved--;
+    }
+}
+void Instance::SetFrameZonesColors(const GView::Utils::ZonesList& zones)
+{
+    zones.ForEachInInterval({ Frame.start, Frame.start + Frame.size - 1 }, [this](uint64 low, uint64 high, const GView::Utils::Zone& zone) {
+        for (auto offset = low; offset <= high; offset++) {
+            SetFrameColor(offset, zone.color);
+        }
+        return Frame.unresolved > 0;
+    });
+}
+void Instance::SetFrameStringsColors()
+{
+    const auto end = Frame.start + Frame.size;
+    auto offset    = Frame.start;
+    while ((offset < end) && (Frame.unresolved > 0)) {
+        if ((offset < StringInfo.start) || (offset >= StringInfo.end)) {
+            const auto idx = static_cast<size_t>(offset - Frame.start);
+            UpdateStringInfo(offset, BufferView(Frame.data.data() + idx, std::min<size_t>(STRING_LOOKAHEAD, Frame.data.size() - idx)));
+            if (StringInfo.end <= offset) {
+                offset++;
+                continue;
+            }
+        }
+        const auto last = std::min<uint64>(StringInfo.end, end);
+        switch (StringInfo.type) {
+        case StringType::Ascii:
+            for (; offset < last; offset++) {
+                SetFrameColor(offset, config.Colors.Ascii);
+            }
+            break;
+        case StringType::Unicode:
+            for (; offset < last; offset++) {
+                auto& b = Frame.bytes[offset - Frame.start];
+                if (b.flags & FRAME_BYTE_RESOLVED)
+                    continue;
+                SetFrameColor(offset, config.Colors.Unicode);
+                if (offset > StringInfo.middle) {
+                    b.flags |= FRAME_BYTE_BLANK;
+                    continue;
+                }
+                // the characters of the string are displayed one after another (the zero bytes are skipped)
+                const auto source = ((offset - StringInfo.start) << 1) + StringInfo.start;
+                if ((source >= Frame.start) && (source - Frame.start < Frame.data.size()))
+                    b.text = Frame.data[source - Frame.start];
+                else
+                    b.text = obj->GetData().GetFromCache(source);
+            }
+            break;
+        default:
+            offset = last;
+            break;
+        }
+    }
+}
+void Instance::SetFrameTypeColors()
+{
+    const auto end = Frame.start + Frame.size;
+    auto from      = Frame.start;
+
+    // a span that was found before (e.g. an instruction that starts above the screen)
+    if (bufColor.IsValue() && (bufColor.start <= from) && (from <= bufColor.end)) {
+        for (; (from <= bufColor.end) && (from < end); from++) {
+            SetFrameColor(from, bufColor.color);
+        }
+    }
+    if (from >= end)
+        return;
+
+    const auto idx = static_cast<size_t>(from - Frame.start);
+    Frame.spans.clear();
+    if (settings->positionToColorCallback->GetColorsForRange(from, end - from, BufferView(Frame.data.data() + idx, Frame.data.size() - idx), Frame.spans)) {
+        for (const auto& span : Frame.spans) {
+            for (auto offset = std::max<>(span.start, from); (offset <= span.end) && (offset < end); offset++) {
+                SetFrameColor(offset, span.color);
+            }
+        }
+        if (Frame.spans.empty() == false)
+            bufColor = Frame.spans.back();
+        return;
+    }
+
+    // the plugin only colors a position at a time
+    for (auto i = idx; (i < Frame.size) && (Frame.unresolved > 0); i++) {
+        if (Frame.bytes[i].flags & FRAME_BYTE_RESOLVED)
+            continue;
+        const auto offset = Frame.start + i;
+        if ((offset >= bufColor.start) && (offset <= bufColor.end)) {
+            SetFrameColor(offset, bufColor.color);
+            continue;
+        }
+        const auto bv = BufferView(Frame.data.data() + i, std::min<size_t>(16, Frame.data.size() - i));
+        if (settings->positionToColorCallback->GetColorForBuffer(offset, bv, bufColor))
+            SetFrameColor(offset, bufColor.color);
+    }
+}
+bool Instance::ComputeFrame()
+{
+    auto& cache     = this->obj->GetData();
+    const auto size = cache.GetSize();
+
+    Frame.start = cursor.GetStartView();
+    Frame.size  = 0;
+    if (Frame.start >= size)
+        return false;
+
+    // a single read for the whole screen - the data is copied, as the plugins might read from the cache as well
+    const auto screenSize = std::min<uint64>(static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows, size - Frame.start);
+    const auto readSize   = std::min<uint64>(screenSize + STRING_LOOKAHEAD, size - Frame.start);
+    auto buf              = cache.Get(Frame.start, static_cast<uint32>(readSize), false);
+    if ((buf.IsValid() == false) || (buf.GetLength() < screenSize))
+        return false; // larger than the cache => colors are computed byte by byte
+
+    Frame.data.assign(buf.begin(), buf.end());
+    Frame.size       = static_cast<uint32>(screenSize);
+    Frame.unresolved = Frame.size;
+    Frame.bytes.resize(Frame.size);
+    for (uint32 idx = 0; idx < Frame.size; idx++) {
+        Frame.bytes[idx] = { Cfg.Text.Inactive, 0, Frame.data[idx] };
+    }
+    const auto end = Frame.start + Frame.size;
+
+    // current selection (and the other places where the same bytes are found)
+    if ((this->CurrentSelection.size) && (this->CurrentSelection.highlight)) {
+        const auto sz = this->CurrentSelection.size;
+        if (this->CurrentSelection.start != GView::Utils::INVALID_OFFSET) {
+            for (auto offset = std::max<>(this->CurrentSelection.start, Frame.start); offset < std::min<>(this->CurrentSelection.end, end); offset++) {
+                SetFrameColor(offset, Cfg.Selection.SimilarText);
+            }
+        }
+        const auto* data = Frame.data.data();
+        for (uint32 idx = 0; idx < Frame.size; idx++) {
+            auto p = reinterpret_cast<const uint8*>(memchr(data + idx, this->CurrentSelection.buffer[0], Frame.size - idx));
+            if (p == nullptr)
+                break;
+            idx = static_cast<uint32>(p - data);
+            if ((idx + sz <= Frame.data.size()) && (memcmp(p, this->CurrentSelection.buffer, sz) == 0)) {
+                for (auto offset = Frame.start + idx; offset < std::min<uint64>(Frame.start + idx + sz, end); offset++) {
+                    SetFrameColor(offset, Cfg.Selection.SimilarText);
+                }
+            }
+        }
+    }
+
+    // "find all" hits
+    if ((Frame.unresolved > 0) && findDialog.HasHitsIndex()) {
+        findDialog.ForEachHitInRange(Frame.start, end, [&](uint64 hitStart, uint64 hitEnd) {
+            for (auto offset = std::max<>(hitStart, Frame.start); offset < std::min<>(hitEnd, end); offset++) {
+                SetFrameColor(offset, Cfg.Selection.SimilarText);
+            }
+        });
+    }
+
+    if ((Frame.unresolved > 0) && settings) {
+        if (showObjectsHighlighting) {
+            // nothing else is colored in this mode
+            SetFrameZonesColors(this->settings->zListObjects);
+            return true;
+        }
+
+        if ((showCodeExecution || showSyncCompare) && settings->bufferColorCallback) {
+            const ViewData vd{ .viewStartOffset   = cursor.GetStartView(),
+                               .viewSize          = static_cast<uint64>(Layout.charactersPerLine) * Layout.visibleRows,
+                               .cursorStartOffset = cursor.GetCurrentPosition() };
+            for (uint32 idx = 0; (idx < Frame.size) && (Frame.unresolved > 0); idx++) {
+                if (Frame.bytes[idx].flags & FRAME_BYTE_RESOLVED)
+                    continue;
+                auto byteData = vd;
+                byteData.byte = Frame.data[idx];
+                ColorPair c;
+                if (settings->bufferColorCallback->GetColorForByteAt(Frame.start + idx, byteData, c))
+                    SetFrameColor(Frame.start + idx, c);
+            }
+        }
+
+        if ((Frame.unresolved > 0) && showTypeObjects && settings->positionToColorCallback) {
+            SetFrameTypeColors();
+        }
+    }
+
+    // strings
+    if ((Frame.unresolved > 0) && (this->StringInfo.showAscii || this->StringInfo.showUnicode)) {
+        SetFrameStringsColors();
+    }
+
+    // zones
+    if (Frame.unresolved > 0) {
+        SetFrameZonesColors(this->settings->zList);
+    }
+    return true;
+}
 
 void Instance::UpdateViewSizes()
 {
@@ -681,9 +855,15 @@ void Instance::PrepareDrawLineInfo(DrawLineInfo& dli)
         this->chars.Resize(dli.offsetAndNameSize + dli.textSize + dli.numbersSize);
         dli.recomputeOffsets = false;
     }
-    auto buf          = this->obj->GetData().Get(dli.offset, dli.textSize, false);
-    dli.start         = buf.GetData();
-    dli.end           = buf.GetData() + buf.GetLength();
+    if (Frame.Get(dli.offset)) {
+        const auto idx = static_cast<uint32>(dli.offset - Frame.start);
+        dli.start      = Frame.data.data() + idx;
+        dli.end        = dli.start + std::min<uint32>(dli.textSize, Frame.size - idx);
+    } else {
+        auto buf  = this->obj->GetData().Get(dli.offset, dli.textSize, false);
+        dli.start = buf.GetData();
+        dli.end   = buf.GetData() + buf.GetLength();
+    }
     dli.chNameAndSize = this->chars.GetBuffer();
     dli.chText        = dli.chNameAndSize + (dli.offsetAndNameSize + dli.numbersSize);
     dli.chNumbers     = dli.chNameAndSize + dli.offsetAndNameSize;
@@ -822,18 +1002,25 @@ void Instance::WriteLineTextToChars(DrawLineInfo& dli)
     if (active) {
         const auto startCh  = dli.chText;
         const auto ofsStart = dli.offset;
+        auto fb             = Frame.Get(dli.offset);
         while (dli.start < dli.end) {
-            cp = OffsetToColor(dli.offset);
-            if (selection.Contains(dli.offset))
-                cp = Cfg.Selection.Editor;
-            if (StringInfo.type == StringType::Unicode) {
-                if (dli.offset > StringInfo.middle)
-                    dli.chText->Code = ' ';
-                else
-                    dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
+            if (fb) {
+                cp               = fb->color;
+                dli.chText->Code = (fb->flags & FRAME_BYTE_BLANK) ? ' ' : codePage[fb->text];
+                fb++;
             } else {
-                dli.chText->Code = codePage[*dli.start];
+                cp = OffsetToColor(dli.offset);
+                if (StringInfo.type == StringType::Unicode) {
+                    if (dli.offset > StringInfo.middle)
+                        dli.chText->Code = ' ';
+                    else
+                        dli.chText->Code = codePage[obj->GetData().GetFromCache(((dli.offset - StringInfo.start) << 1) + StringInfo.start)];
+                } else {
+                    dli.chText->Code = codePage[*dli.start];
+                }
             }
+            if (selection.Contains(dli.offset))
+                cp = Cfg.Selection.Editor;
             dli.chText->Color = cp;
             dli.chText++;
             dli.start++;
@@ -861,10 +1048,11 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
     auto sps   = dli.chText;
     auto start = dli.offset;
     auto end   = start + (dli.end - dli.start);
+    auto fb    = active ? Frame.Get(dli.offset) : nullptr;
 
     while (dli.start < dli.end) {
         if (active) {
-            cp = OffsetToColor(dli.offset);
+            cp = fb ? fb->color : OffsetToColor(dli.offset);
 
             if (selection.Contains(dli.offset)) {
                 cp = Cfg.Selection.Editor;
@@ -986,7 +1174,10 @@ void Instance::WriteLineNumbersToChars(DrawLineInfo& dli)
         c->Color = cp;
         c++;
 
-        if (active) {
+        if (fb) {
+            dli.chText->Code = (fb->flags & FRAME_BYTE_BLANK) ? ' ' : codePage[fb->text];
+            fb++;
+        } else if (active) {
             if (StringInfo.type == StringType::Unicode) {
                 if (dli.offset > StringInfo.middle)
                     dli.chText->Code = ' ';
@@ -1038,6 +1229,8 @@ void Instance::Paint(Renderer& renderer)
         settings->zList.SetCache({ startView, ((uint64) Layout.charactersPerLine) * (Layout.visibleRows - 1ull) + startView });
     }
 
+    ComputeFrame();
+
     DrawLineInfo dli;
     for (uint32 tr = 0; tr < Layout.visibleRows; tr++) {
         dli.offset = ((uint64) Layout.charactersPerLine) * tr + startView;
@@ -0,0 +1,387 @@
+#include "BufferViewer.hpp"
+
+#include <future>
+#include <thread>
+
+namespace GView::View::BufferViewer
+{
+constexpr uint64 SEARCH_CHUNK_SIZE  = 0x200000; // 2 MB
+constexpr uint32 MAX_SEARCH_WORKERS = 8;
+constexpr uint32 REGEX_OVERLAP      = 0x10000; // regex matches that cross a chunk boundary are found if they are shorter than this
+constexpr char16 UNICODE_FILLER     = 0x1A;    // replaces non-ASCII characters when a unicode buffer is narrowed for the regex engine
+
+SearchEngine::SearchEngine()
+{
+    Clear();
+}
+void SearchEngine::Clear()
+{
+    this->values.clear();
+    this->masks.clear();
+    this->anchor = 0;
+    this->type   = PatternType::None;
+    this->regex.reset();
+}
+bool SearchEngine::SetBytes(const std::vector<uint8>& bytes, const std::vector<uint8>& bytesMasks)
+{
+    Clear();
+    CHECK(bytes.size() > 0, false, "Empty pattern");
+    CHECK(bytes.size() == bytesMasks.size(), false, "Every byte needs a mask");
+    this->values = bytes;
+    this->masks  = bytesMasks;
+    for (size_t idx = 0; idx < this->values.size(); idx++)
+        this->values[idx] &= this->masks[idx];
+
+    // the anchor is searched with memchr => pick an exact byte that is not very common in binary files
+    const auto Score = [](uint8 value) -> uint32 {
+        if (value == 0)
+            return 3;
+        if (value == 0xFF)
+            return 2;
+        if ((value == ' ') || ((value >= 'a') && (value <= 'z')))
+            return 1;
+        return 0;
+    };
+    auto bestScore = 0xFFFFFFFFU;
+    for (uint32 idx = 0; idx < static_cast<uint32>(this->values.size()); idx++)
+    {
+        if ((this->masks[idx] == 0xFF) && (Score(this->values[idx]) < bestScore))
+        {
+            bestScore    = Score(this->values[idx]);
+            this->anchor = idx;
+        }
+    }
+    this->type = PatternType::Literal;
+    return true;
+}
+bool SearchEngine::SetText(std::string_view text, bool ignoreCase)
+{
+    std::vector<uint8> bytes, bytesMasks;
+    bytes.reserve(text.size());
+    bytesMasks.reserve(text.size());
+    for (auto ch : text)
+    {
+        const auto c = static_cast<uint8>(ch);
+        if ((ignoreCase) && (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z'))))
+        {
+            bytes.push_back(c & 0xDF);
+            bytesMasks.push_back(0xDF);
+        }
+        else
+        {
+            bytes.push_back(c);
+            bytesMasks.push_back(0xFF);
+        }
+    }
+    return SetBytes(bytes, bytesMasks);
+}
+bool SearchEngine::SetUnicodeText(std::u16string_view text, bool ignoreCase)
+{
+    // UTF-16 (little endian) representation of the text
+    std::vector<uint8> bytes, bytesMasks;
+    bytes.reserve(text.size() * 2);
+    bytesMasks.reserve(text.size() * 2);
+    for (auto ch : text)
+    {
+        if ((ignoreCase) && (((ch >= 'a') && (ch <= 'z')) || ((ch >= 'A') && (ch <= 'Z'))))
+        {
+            bytes.push_back(static_cast<uint8>(ch) & 0xDF);
+            bytesMasks.push_back(0xDF);
+        }
+        else
+        {
+            bytes.push_back(static_cast<uint8>(ch & 0xFF));
+            bytesMasks.push_back(0xFF);
+        }
+        bytes.push_back(static_cast<uint8>(ch >> 8));
+        bytesMasks.push_back(0xFF);
+    }
+    return SetBytes(bytes, bytesMasks);
+}
+bool SearchEngine::SetRegex(std::string_view expression, bool unicode, bool ignoreCase)
+{
+    Clear();
+    CHECK(expression.size() > 0, false, "Empty expression");
+    // Regex::Matcher reports the first capturing group => capture the entire expression
+    std::string wrapped;
+    wrapped.reserve(expression.size() + 2);
+    wrapped += '(';
+    wrapped += expression;
+    wrapped += ')';
+    this->regex = std::make_unique<GView::Regex::Matcher>();
+    CHECK(this->regex->Init(wrapped, unicode, !ignoreCase), false, "");
+    CHECK(this->regex->IsValid(), false, "Invalid expression: %s", wrapped.c_str());
+    this->type = unicode ? PatternType::UnicodeRegex : PatternType::Regex;
+    return true;
+}
+uint32 SearchEngine::GetOverlap() const
+{
+    if (this->type == PatternType::Literal)
+        return static_cast<uint32>(this->values.size() - 1);
+    return REGEX_OVERLAP;
+}
+void SearchEngine::SearchLiteral(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out)
+{
+    const auto len = this->values.size();
+    if (size < len)
+        return;
+    // only the last match is needed by backward searches => overlapping matches must be checked as well
+    const auto step = mode == SearchMode::Last ? 1 : len;
+    const auto* v     = this->values.data();
+    const auto* m     = this->masks.data();
+    const auto Verify = [&](const uint8* p) {
+        for (size_t idx = 0; idx < len; idx++)
+        {
+            if ((p[idx] & m[idx]) != v[idx])
+                return false;
+        }
+        return true;
+    };
+    // candidates must start in the owned part of the chunk and must fit in the buffer
+    const auto lastStart = std::min<size_t>(owned, size - len + 1);
+    size_t pos           = 0;
+    if (this->masks[this->anchor] == 0xFF)
+    {
+        const auto value = this->values[this->anchor];
+        while (pos < lastStart)
+        {
+            const auto* p = reinterpret_cast<const uint8*>(memchr(data + pos + this->anchor, value, lastStart - pos));
+            if (!p)
+                break;
+            const auto candidate = static_cast<size_t>(p - data) - this->anchor;
+            if (Verify(data + candidate))
+            {
+                out.push_back({ base + candidate, len });
+                if (mode == SearchMode::First)
+                    return;
+                pos = candidate + step;
+            }
+            else
+            {
+                pos = candidate + 1;
+            }
+        }
+        return;
+    }
+    // no exact byte in the pattern (only wildcards and/or case insensitive letters)
+    while (pos < lastStart)
+    {
+        if (Verify(data + pos))
+        {
+            out.push_back({ base + pos, len });
+            if (mode == SearchMode::First)
+                return;
+            pos += step;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+}
+void SearchEngine::SearchRegex(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out)
+{
+    size_t pos = 0;
+    while (pos < owned)
+    {
+        uint64 start, end;
+        if (!this->regex->Match(BufferView(data + pos, size - pos), start, end))
+            break;
+        const auto candidate = pos + static_cast<size_t>(start);
+        if (candidate >= owned)
+            break;
+        if (end == start)
+        {
+            // empty matches are not reported
+            pos = candidate + 1;
+            continue;
+        }
+        out.push_back({ base + candidate, end - start });
+        if (mode == SearchMode::First)
+            return;
+        pos = mode == SearchMode::Last ? candidate + 1 : pos + static_cast<size_t>(end);
+    }
+}
+void SearchEngine::SearchUnicodeRegex(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out)
+{
+    // RE2 works with narrow strings => every UTF-16 character becomes one byte (non-ASCII characters become a filler)
+    // so that offsets can be translated back (x2) to the original buffer
+    const auto count = size / 2;
+    std::vector<uint8> narrow(count);
+    const auto* p = reinterpret_cast<const uint16*>(data);
+    for (size_t idx = 0; idx < count; idx++)
+    {
+        const auto ch = p[idx];
+        narrow[idx]   = static_cast<uint8>(ch < 0x80 ? ch : UNICODE_FILLER);
+    }
+    const auto first = out.size();
+    SearchRegex(narrow.data(), count, (owned + 1) / 2, 0, mode, out);
+    for (auto idx = first; idx < out.size(); idx++)
+    {
+        out[idx].start = base + out[idx].start * 2;
+        out[idx].size *= 2;
+    }
+}
+void SearchEngine::SearchChunk(const uint8* data, size_t size, size_t owned, uint64 base, SearchMode mode, std::vector<ChunkMatch>& out)
+{
+    switch (this->type)
+    {
+    case PatternType::Literal:
+        SearchLiteral(data, size, owned, base, mode, out);
+        break;
+    case PatternType::Regex:
+        SearchRegex(data, size, owned, base, mode, out);
+        break;
+    case PatternType::UnicodeRegex:
+        SearchUnicodeRegex(data, size, owned, base, mode, out);
+        break;
+    default:
+        break;
+    }
+}
+bool SearchEngine::Search(
+      GView::Utils::DataCache& cache,
+      uint64 start,
+      uint64 end,
+      uint64 limit,
+      SearchMode mode,
+      const MatchCallback& onMatch,
+      const ProgressCallback& onProgress)
+{
+    CHECK(IsValid(), false, "No pattern was set !");
+    limit = std::min<uint64>(limit, cache.GetSize());
+    end   = std::min<uint64>(end, limit);
+    if (start >= end)
+        return true; // nothing to search
+
+    struct Slot {
+        std::vector<uint8> buffer; // copy of the chunk (if the file is not memory mapped)
+        const uint8* data;
+        size_t size;
+        size_t owned;
+        uint64 base;
+        std::vector<ChunkMatch> matches;
+        std::future<void> task;
+        bool used;
+    };
+
+    const auto overlap     = GetOverlap();
+    const auto total       = end - start;
+    const auto chunksCount = (total + SEARCH_CHUNK_SIZE - 1) / SEARCH_CHUNK_SIZE;
+    const auto workers     = std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1U), MAX_SEARCH_WORKERS);
+    const auto waves       = (chunksCount + workers - 1) / workers;
+    const auto mapped      = cache.IsMemoryMapped();
+    const auto file        = mapped ? cache.GetEntireFile() : BufferView();
+
+    // two sets of slots: one is searched by the workers while the other one is filled with the next chunks
+    std::vector<Slot> slots(static_cast<size_t>(workers) * 2);
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+
+    const auto Prepare = [&](uint64 wave, uint32 set) -> bool {
+        for (uint32 idx = 0; idx < workers; idx++)
+        {
+            auto& slot = slots[static_cast<size_t>(set) * workers + idx];
+            slot.used  = false;
+            slot.matches.clear();
+            const auto order = wave * workers + idx;
+            if (order >= chunksCount)
+                continue;
+            // backward searches process the chunks starting from the end of the range
+            const auto chunk      = mode == SearchMode::Last ? chunksCount - 1 - order : order;
+            const auto chunkStart = start + chunk * SEARCH_CHUNK_SIZE;
+            const auto chunkEnd   = std::min<uint64>(chunkStart + SEARCH_CHUNK_SIZE, end);
+            const auto dataEnd    = std::min<uint64>(chunkEnd + overlap, limit);
+            slot.base             = chunkStart;
+            slot.owned            = static_cast<size_t>(chunkEnd - chunkStart);
+            slot.size             = static_cast<size_t>(dataEnd - chunkStart);
+            if (mapped)
+            {
+                slot.data = file.GetData() + chunkStart;
+            }
+            else
+            {
+                slot.buffer.resize(slot.size);
+                auto* dest = slot.buffer.data();
+                CHECK(cache.ForEachChunk(
+                            chunkStart,
+                            slot.size,
+                            [dest, chunkStart](uint64 offset, BufferView data) {
+                                memcpy(dest + (offset - chunkStart), data.GetData(), data.GetLength());
+                                return true;
+                            }),
+                      false,
+                      "Fail to read %llu bytes from offset %llu",
+                      (uint64) slot.size,
+                      chunkStart);
+                slot.data = dest;
+            }
+            slot.used = true;
+        }
+        return true;
+    };
+    const auto Launch = [&](uint32 set) {
+        for (uint32 idx = 0; idx < workers; idx++)
+        {
+            auto& slot = slots[static_cast<size_t>(set) * workers + idx];
+            if (slot.used)
+                slot.task = std::async(std::launch::async, [this, &slot, mode]() {
+                    SearchChunk(slot.data, slot.size, slot.owned, slot.base, mode, slot.matches);
+                });
+        }
+    };
+
+    CHECK(Prepare(0, 0), false, "");
+    Launch(0);
+
+    uint64 processed = 0;
+    uint64 lastEnd   = 0;
+    for (uint64 wave = 0; wave < waves; wave++)
+    {
+        const auto set    = static_cast<uint32>(wave & 1);
+        const auto readOK = (wave + 1 < waves) ? Prepare(wave + 1, set ^ 1) : true;
+        for (uint32 idx = 0; idx < workers; idx++)
+        {
+            auto& slot = slots[static_cast<size_t>(set) * workers + idx];
+            if (slot.used)
+                slot.task.get();
+        }
+        CHECK(readOK, false, "");
+
+        // slots are already in the order in which the results have to be reported
+        for (uint32 idx = 0; idx < workers; idx++)
+        {
+            auto& slot = slots[static_cast<size_t>(set) * workers + idx];
+            if (!slot.used)
+                continue;
+            processed += slot.owned;
+            if (slot.matches.empty())
+                continue;
+            switch (mode)
+            {
+            case SearchMode::First:
+                onMatch(slot.matches.front().start, slot.matches.front().size);
+                return true;
+            case SearchMode::Last:
+                onMatch(slot.matches.back().start, slot.matches.back().size);
+                return true;
+            default:
+                for (const auto& m : slot.matches)
+                {
+                    // a match from the overlapping area of the previous chunk may cover the first matches of this one
+                    if (m.start < lastEnd)
+                        continue;
+                    lastEnd = m.start + m.size;
+                    if (!onMatch(m.start, m.size))
+                        return true;
+                }
+                break;
+            }
+        }
+        if ((onProgress) && (!onProgress(processed, total)))
+            return false;
+        if (wave + 1 < waves)
+            Launch(set ^ 1);
+    }
+    return true;
+}
+} // namespace GView::View::BufferViewer
@@ -7,14 +7,14 @@ constexpr int32 BTN_ID_OK        = 1;
 constexpr int32 BTN_ID_CANCEL    = 2;
 constexpr int32 RB_GROUP_ID      = 123;
 
-GoToDialog::GoToDialog(uint64 currentPos, uint64 sz, uint32 currentLine, uint32 _maxLines)
-    : Window("GoTo", "d:c,w:60,h:10", WindowFlags::ProcessReturn), maxSize(sz), maxLines(_maxLines)
+GoToDialog::GoToDialog(uint64 currentPos, uint64 sz, uint32 currentLine, uint32 _maxLines, bool _allLinesIndexed)
+    : Window("GoTo", "d:c,w:60,h:10", WindowFlags::ProcessReturn), maxSize(sz), maxLines(_maxLines), allLinesIndexed(_allLinesIndexed)
 {
     LocalString<128> tmp;
     resultedPos = GView::Utils::INVALID_OFFSET;
     gotoLine    = true;
 
-    rbLineNumber = Factory::RadioBox::Create(this, tmp.Format("&Line (1..%u)", _maxLines), "x:1,y:1,w:38", RB_GROUP_ID);
+    rbLineNumber = Factory::RadioBox::Create(this, tmp.Format(_allLinesIndexed ? "&Line (1..%u)" : "&Line (1..%u+)", _maxLines), "x:1,y:1,w:38", RB_GROUP_ID);
     txLineNumber = Factory::TextField::Create(this, tmp.Format("%u", currentLine), "x:40,y:1,w:16");
 
     rbFileOffset = Factory::RadioBox::Create(this, tmp.Format("&File offset (0..%llu)", sz), "x:1,y:3,w:38", RB_GROUP_ID);
@@ -62,9 +62,10 @@ void GoToDialog::Validate()
     // checks in boundery
     if (rbLineNumber->IsChecked())
     {
-        if ((newPos > maxLines) || (newPos < 1))
+        // lines after the ones indexed so far are also accepted (the file is still indexed)
+        if ((newPos < 1) || (newPos > (allLinesIndexed ? maxLines : INVALID_LINE_NUMBER - 1)))
         {
-            Dialogs::MessageBox::ShowError("Error", error.Format("Valid line number are between 1 and %u", maxLines));
+            Dialogs::MessageBox::ShowError("Error", error.Format("Valid line number are between 1 and %u", allLinesIndexed ? maxLines : INVALID_LINE_NUMBER - 1));
             input->SetFocus();
             return;
         }
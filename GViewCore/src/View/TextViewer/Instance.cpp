@@ -6,8 +6,7 @@ using namespace AppCUI::Input;
 
 Config Instance::config;
 
-constexpr int32 CMD_ID_WORD_WRAP     = 0xBF00;
-constexpr uint32 INVALID_LINE_NUMBER = 0xFFFFFFFF;
+constexpr int32 CMD_ID_WORD_WRAP = 0xBF00;
 
 enum class BulletParserState : uint8
 {
@@ -197,7 +196,7 @@ uint8 GetCharGroup(char16 ch)
 class DataCharacterStream
 {
     GView::Utils::DataCache& dataCache;
-    std::vector<LineInfo>& lines;
+    LineIndex& lines;
     Reference<SettingsData> settings;
     uint32 linesCount;
     uint32 charIndex;
@@ -206,17 +205,19 @@ class DataCharacterStream
     bool ConvertLine(uint32 lineNo)
     {
         CHECK(lineNo < linesCount, false, "");
-        auto buf = dataCache.Get(lines[lineNo].offset, lines[lineNo].size, false);
+        LineInfo li;
+        CHECK(lines.Get(lineNo, li), false, "");
+        auto buf = dataCache.Get(li.offset, li.size, false);
         CHECK(tempLine.Create(buf, settings), false, "");
         currentLine = lineNo;
         return true;
     }
 
   public:
-    DataCharacterStream(std::vector<LineInfo>& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
+    DataCharacterStream(LineIndex& li, Reference<SettingsData> _settings, GView::Utils::DataCache& cache)
         : settings(_settings), dataCache(cache), lines(li)
     {
-        linesCount  = static_cast<uint32>(li.size());
+        linesCount  = li.GetCount();
         currentLine = 0;
         charIndex   = 0;
     }
@@ -288,7 +289,8 @@ Instance::Instance(Reference<GView::Object> _obj, Settings* _settings)
     if (config.Loaded == false)
         config.Initialize();
 
-    this->lineNumberWidth = 0;
+    this->lineNumberWidth     = 0;
+    this->estimatedLinesCount = 0;
     this->SubLines.entries.reserve(256); // reserve 256 sub-lines
     this->SubLines.lineNo  = INVALID_LINE_NUMBER;
     this->ViewPort.scrollX = 0;
@@ -324,107 +326,29 @@ void Instance::OpenCurrentSelection()
 }
 void Instance::RecomputeLineIndexes()
 {
-    // first --> simple estimation
+    // first --> simple estimation (used for the width of the line numbers until the entire file is indexed)
     auto buf        = this->obj->GetData().Get(0, 4096, false);
     auto sz         = this->obj->GetData().GetSize();
-    auto csz        = this->obj->GetData().GetCacheSize() & 0xFFFFFFF0; // make sure that csz is odd
     auto crlf_count = (uint64) 1;
 
     for (auto ch : buf)
         if ((ch == '\n') || (ch == '\r'))
             crlf_count++;
 
-    auto estimated_count = ((crlf_count * sz) / buf.GetLength()) + 16;
+    this->estimatedLinesCount = buf.GetLength() > 0 ? ((crlf_count * sz) / buf.GetLength()) + 16 : 16;
 
-    this->lines.clear();
-    this->lines.reserve(estimated_count);
-
-    uint64 offset    = this->sizeOfBOM;
-    uint64 start     = this->sizeOfBOM;
-    uint32 charCount = 0;
-    char16 lastChar  = 0;
-
-    CharacterEncoding::ExpandedCharacter ch;
-
-    while (offset < sz)
-    {
-        buf = this->obj->GetData().Get(offset, csz, false);
-        if (buf.Empty())
-            return;
-        // process the buffer
-        auto* p       = buf.begin();
-        auto* e       = buf.end();
-        auto* loopEnd = buf.end();
-        if (((offset + buf.GetLength()) < sz) && (buf.GetLength() > 16))
-        {
-            // if this is a partial part of the file and it has more then 16 bytes, deduct 8 bytes to make sure that any possible conversion
-            // will be made
-            loopEnd -= 8;
-        }
-        while (p < loopEnd)
-        {
-            if (ch.FromEncoding(this->settings->encoding, p, e))
-            {
-                p += ch.Length();
-                auto chr = ch.GetChar();
-                if (((chr == '\n') && (lastChar != '\r')) || ((chr == '\r') && (lastChar != '\n')))
-                {
-                    // end of the current line
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = chr;
-                    continue;
-                }
-
-                // combined CRLF or LFCR
-                if (((chr == '\n') && (lastChar == '\r')) || ((chr == '\r') && (lastChar == '\n')))
-                {
-                    // just advanced one extra char (no new line found)
-                    offset += ch.Length();
-                    start     = offset;
-                    charCount = 0;
-                    lastChar  = 0; // important as the CRLF or LFCR has ended
-                    continue;
-                }
-
-                // other character
-                lastChar = 0; // don't care
-                charCount++;
-                offset += ch.Length();
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-            else
-            {
-                // need to treat conversion error
-                // consider one character (binary format)
-                charCount++;
-                offset++;
-                p++;
-                if (charCount > 2000)
-                {
-                    // limit line to 2000 characters
-                    lines.emplace_back(start, charCount, (uint32) (offset - start));
-                    start     = offset;
-                    charCount = 0;
-                }
-            }
-        }
-        if (charCount > 0)
-        {
-            // last line
-            lines.emplace_back(start, charCount, (uint32) (offset - start));
-        }
-    }
-
-    auto linesCount = this->lines.size() + 1;
+    // large files are indexed in background --> only wait for the lines that fit on the screen
+    this->lines.Start(this->obj, this->settings->encoding, this->sizeOfBOM);
+    this->lines.WaitForLines(MAX_LINES_TO_VIEW);
+    this->lines.ConsumeUpdate();
+    UpdateLineNumberWidth();
+}
+void Instance::UpdateLineNumberWidth()
+{
+    // completed is read first => the count is final if the index is completed
+    const auto completed = this->lines.IsCompleted();
+    const uint64 count   = this->lines.GetCount();
+    auto linesCount      = (completed ? count : std::max<>(count, this->estimatedLinesCount)) + 1;
     if (linesCount < 10)
         this->lineNumberWidth = 2;
     else if (linesCount < 100)
@@ -440,21 +364,30 @@ void Instance::RecomputeLineIndexes()
     else
         this->lineNumberWidth = 8;
 }
+void Instance::OnLineIndexUpdated()
+{
+    const auto width = this->lineNumberWidth;
+    UpdateLineNumberWidth();
+    if (width == this->lineNumberWidth)
+        return;
+    // the text area has a different width => the sub-lines and the view port are recomputed
+    this->SubLines.lineNo = INVALID_LINE_NUMBER;
+    this->ComputeViewPort(this->ViewPort.Start.lineNo, this->ViewPort.Start.subLineNo, Direction::TopToBottom);
+    this->UpdateViewPort();
+}
 bool Instance::GetLineInfo(uint32 lineNo, LineInfo& li)
 {
-    if (lineNo >= this->lines.size())
-        return false;
-    li = this->lines[lineNo];
-    return true;
+    return this->lines.Get(lineNo, li);
 }
 LineInfo Instance::GetLineInfo(uint32 lineNo)
 {
-    const auto sz = this->lines.size();
-    if (lineNo < sz)
-        return this->lines[lineNo];
+    const auto sz = this->lines.GetCount();
+    LineInfo li;
+    if ((lineNo < sz) && (this->lines.Get(lineNo, li)))
+        return li;
     // if its outside --> always return the last line
-    if (sz > 0)
-        return this->lines[sz - 1];
+    if ((sz > 0) && (this->lines.Get(sz - 1, li)))
+        return li;
     // otherwise return an empty line
     return LineInfo(0, 0, 0);
 }
@@ -631,10 +564,10 @@ void Instance::CommputeViewPort_NoWrap(uint32 lineNo, Direction dir)
     }
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.GetCount() == 0)
         return;
 
-    uint32 lastLineNo = static_cast<uint32>(this->lines.size() - 1); // lines.size() will alway be bigger than 1
+    uint32 lastLineNo = this->lines.GetCount() - 1; // there is always at least one line
 
     // sets the view port
     ViewPort.Start.lineNo    = start;
@@ -662,7 +595,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
     auto h = (std::min<>(static_cast<uint32>(std::max<>(this->GetHeight(), 1)), MAX_LINES_TO_VIEW));
 
     ViewPort.Reset();
-    if (this->lines.empty())
+    if (this->lines.GetCount() == 0)
         return;
     if (dir == Direction::TopToBottom)
     {
@@ -675,7 +608,7 @@ void Instance::CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction
         auto* l                  = ViewPort.Lines;
         const auto* l_max        = l + h;
 
-        while ((l < l_max) && (start < this->lines.size()))
+        while ((l < l_max) && (start < this->lines.GetCount()))
         {
             auto lineInfo = GetLineInfo(start);
             ComputeSubLineIndexes(start);
@@ -755,14 +688,15 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
     if (select)
         sidx = this->selection.BeginSelection(this->Cursor.pos);
     // sanity checks
-    if (this->lines.size() == 0)
+    const auto linesCount = this->lines.GetCount();
+    if (linesCount == 0)
     {
         lineNo = 0;
     }
     else
     {
-        if (lineNo >= static_cast<uint32>(this->lines.size()))
-            lineNo = static_cast<uint32>(this->lines.size() - 1);
+        if (lineNo >= linesCount)
+            lineNo = linesCount - 1;
     }
     LineInfo li = GetLineInfo(lineNo);
     if (charIndex >= li.charsCount)
@@ -792,8 +726,8 @@ void Instance::MoveTo(uint32 lineNo, uint32 charIndex, bool select)
 }
 void Instance::MoveToStartOfLine(uint32 lineNo, bool select)
 {
-    if (lineNo >= this->lines.size())
-        MoveToEndOfLine(static_cast<uint32>(this->lines.size() - 1), select); // last position
+    if (lineNo >= this->lines.GetCount())
+        MoveToEndOfLine(this->lines.GetCount() - 1, select); // last position
     else
         MoveTo(lineNo, 0, select);
 }
@@ -807,9 +741,11 @@ void Instance::MoveToEndOfLine(uint32 lineNo, bool select)
 }
 void Instance::MoveToEndOfFile(bool select)
 {
-    if (this->lines.empty())
+    // while the file is indexed, this moves to the last line indexed so far (the status bar shows the count as "N+")
+    const auto linesCount = this->lines.GetCount();
+    if (linesCount == 0)
         return;
-    MoveTo(static_cast<uint32>(this->lines.size() - 1), 0xFFFFFFFF, select);
+    MoveTo(linesCount - 1, 0xFFFFFFFF, select);
 }
 void Instance::MoveLeft(bool select)
 {
@@ -847,9 +783,9 @@ void Instance::MoveToNextWord(bool select)
 }
 void Instance::MoveDown(uint32 noOfTimes, bool select)
 {
-    if (this->lines.size() == 0)
+    if (this->lines.GetCount() == 0)
         return; // safety check
-    uint32 lastLine = static_cast<uint32>(this->lines.size() - 1);
+    uint32 lastLine = this->lines.GetCount() - 1;
     if (HasWordWrap())
     {
         auto lineNo = this->Cursor.lineNo;
@@ -1255,6 +1191,10 @@ void Instance::Paint(Graphics::Renderer& renderer)
     auto lineNo      = INVALID_LINE_NUMBER;
     const auto focus = this->HasFocus();
 
+    // lines indexed in background since the last paint
+    if (this->lines.ConsumeUpdate())
+        this->OnLineIndexUpdated();
+
     if (this->ViewPort.linesCount == 0)
     {
         this->ComputeViewPort(0, 0, Direction::TopToBottom);
@@ -1420,12 +1360,13 @@ bool Instance::OnEvent(Reference<Control>, Event eventType, int ID)
 }
 void Instance::OnUpdateScrollBars()
 {
-    if (this->lines.size() > 0)
+    if (this->lines.GetCount() > 0)
     {
-        const auto& fistLine = this->lines[0];
-        const auto& lastLine = this->lines[this->lines.size() - 1];
-        const auto maxOfs    = lastLine.offset + lastLine.size;
-        auto pos             = std::max<>(this->Cursor.pos, fistLine.offset);
+        const auto fistLine = GetLineInfo(0);
+        const auto lastLine = GetLineInfo(this->lines.GetCount() - 1);
+        // while the file is still indexed, the position is relative to the entire file
+        const auto maxOfs = this->lines.IsCompleted() ? lastLine.offset + lastLine.size : this->obj->GetData().GetSize();
+        auto pos          = std::max<>(this->Cursor.pos, fistLine.offset);
         this->UpdateVScrollBar(std::min<>(pos, maxOfs), maxOfs);
     }
     else
@@ -1444,14 +1385,7 @@ void Instance::SetWrapMethod(WrapMethod method)
 }
 bool Instance::GoTo(uint64 offset)
 {
-    auto lineNo = 0U;
-    for (lineNo = 0U; lineNo < this->lines.size(); lineNo++)
-    {
-        if (offset < this->lines[lineNo].offset)
-            break;
-    }
-    if (lineNo > 0)
-        lineNo--;
+    auto lineNo = this->lines.OffsetToLine(offset);
     auto li     = GetLineInfo(lineNo);
     auto cIndex = 0U;
     CharacterStream cs(this->obj->GetData().Get(li.offset, li.size, false), 0, this->settings.ToReference());
@@ -1470,11 +1404,15 @@ bool Instance::Select(uint64 offset, uint64 size)
 }
 bool Instance::ShowGoToDialog()
 {
-    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, static_cast<uint32>(this->lines.size()));
+    // the dialog is not blocked by the indexing => the lines indexed so far are shown (completed is read first)
+    const auto completed = this->lines.IsCompleted();
+    GoToDialog dlg(this->Cursor.pos, this->obj->GetData().GetSize(), this->Cursor.lineNo + 1U, this->lines.GetCount(), completed);
     if (dlg.Show() == Dialogs::Result::Ok)
     {
         if (dlg.ShouldGoToLine())
         {
+            // only wait for the requested line (MoveTo stops at the last line if the file has less lines)
+            this->lines.WaitForLines(dlg.GetLine() + 1);
             MoveTo(dlg.GetLine(), 0, false);
         }
         else
@@ -1655,7 +1593,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
             xPoz = PrintSelectionInfo(2, xPoz, 0, 16, r);
             xPoz = PrintSelectionInfo(3, xPoz, 0, 16, r);
         }
-        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format(lines.IsCompleted() ? "%d/%d" : "%d/%d+", Cursor.lineNo + 1, lines.GetCount()));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 10, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -1665,7 +1603,7 @@ void Instance::PaintCursorInformation(AppCUI::Graphics::Renderer& r, uint32 widt
         xPoz = PrintSelectionInfo(2, 0, 1, 16, r);
         PrintSelectionInfo(1, xPoz, 0, 16, r);
         xPoz = PrintSelectionInfo(3, xPoz, 1, 16, r);
-        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format("%d/%d", Cursor.lineNo + 1, (uint32) lines.size()));
+        this->WriteCursorInfo(r, xPoz, 0, 20, "Line:", tmp.Format(lines.IsCompleted() ? "%d/%d" : "%d/%d+", Cursor.lineNo + 1, lines.GetCount()));
         xPoz = this->WriteCursorInfo(r, xPoz, 1, 20, "Col:", tmp.Format("%d", Cursor.charIndex + 1));
         xPoz = this->WriteCursorInfo(r, xPoz, 0, 20, "File ofs: ", tmp.Format("%llu", Cursor.pos));
     }
@@ -0,0 +1,318 @@
+#include "TextViewer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <filesystem>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define GVIEW_LINES_SSE2
+#endif
+
+using namespace GView::View::TextViewer;
+
+namespace
+{
+struct LineScanState
+{
+    uint64 offset;    // next byte to be decoded
+    uint64 start;     // start of the current line
+    uint32 charCount; // characters of the current line
+    char16 lastChar;  // new line character that was just processed (0 for any other character)
+};
+
+// number of bytes (at most 'size') before the first new line character - or before the first byte that is not an ASCII
+// character if 'stopOnHighBytes' is set; every one of these bytes is a character of the current line
+inline size_t CountPlainBytes(const uint8* p, size_t size, bool stopOnHighBytes)
+{
+    size_t idx = 0;
+#ifdef GVIEW_LINES_SSE2
+    const auto cr = _mm_set1_epi8('\r');
+    const auto lf = _mm_set1_epi8('\n');
+    for (; idx + 16 <= size; idx += 16)
+    {
+        const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + idx));
+        auto stop       = static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, cr), _mm_cmpeq_epi8(data, lf))));
+        if (stopOnHighBytes)
+            stop |= static_cast<uint32>(_mm_movemask_epi8(data));
+        if (stop)
+            return idx + std::countr_zero(stop);
+    }
+#endif
+    for (; idx < size; idx++)
+    {
+        if ((p[idx] == '\n') || (p[idx] == '\r') || (stopOnHighBytes && (p[idx] >= 0x80)))
+            break;
+    }
+    return idx;
+}
+
+// Splits the object in lines (starting from the state 'st'): a line ends with CR, LF, CRLF or LFCR, and lines longer than
+// MAX_CHARACTERS_PER_INDEXED_LINE characters are split. 'onLine' is called for every line (after 'st' was moved to the
+// start of the next one) and returns false to stop the scan.
+template <typename T>
+bool ScanLines(GView::Utils::DataCache& cache, CharacterEncoding::Encoding encoding, LineScanState& st, T&& onLine)
+{
+    const auto sz  = cache.GetSize();
+    const auto csz = std::max<uint32>(cache.GetCacheSize() & 0xFFFFFFF0, 16);
+
+    // in ASCII compatible encodings CR and LF are always single bytes => runs of plain bytes are skipped in bulk
+    const auto bulk            = (encoding == CharacterEncoding::Encoding::Ascii) || (encoding == CharacterEncoding::Encoding::Binary) ||
+                                 (encoding == CharacterEncoding::Encoding::UTF8);
+    const auto stopOnHighBytes = encoding == CharacterEncoding::Encoding::UTF8;
+
+    const auto endLine = [&](uint64 nextStart, char16 lastChar) {
+        const LineInfo li(st.start, st.charCount, (uint32) (st.offset - st.start));
+        st.start     = nextStart;
+        st.charCount = 0;
+        st.lastChar  = lastChar;
+        return onLine(li);
+    };
+
+    CharacterEncoding::ExpandedCharacter ch;
+    while (st.offset < sz)
+    {
+        auto buf = cache.Get(st.offset, csz, false);
+        CHECK(buf.IsValid() && (buf.GetLength() > 0), false, "Fail to read data from offset %llu", st.offset);
+
+        const auto* p       = buf.begin();
+        const auto* e       = buf.end();
+        const auto* loopEnd = buf.end();
+        if (((st.offset + buf.GetLength()) < sz) && (buf.GetLength() > 16))
+        {
+            // a partial part of the file --> leave the last 8 bytes for the next read, so that a character is never split
+            loopEnd -= 8;
+        }
+        while (p < loopEnd)
+        {
+            if ((bulk) && (st.charCount < MAX_CHARACTERS_PER_INDEXED_LINE))
+            {
+                const auto count = CountPlainBytes(
+                      p, std::min<size_t>(loopEnd - p, MAX_CHARACTERS_PER_INDEXED_LINE - st.charCount), stopOnHighBytes);
+                if (count > 0)
+                {
+                    p += count;
+                    st.offset += count;
+                    st.charCount += (uint32) count;
+                    st.lastChar = 0;
+                    if (p >= loopEnd)
+                        break;
+                }
+            }
+            if (ch.FromEncoding(encoding, p, e))
+            {
+                p += ch.Length();
+                auto chr = ch.GetChar();
+                if (((chr == '\n') && (st.lastChar != '\r')) || ((chr == '\r') && (st.lastChar != '\n')))
+                {
+                    // end of the current line
+                    const auto next = st.offset + ch.Length();
+                    if (!endLine(next, chr))
+                        return false;
+                    st.offset = next;
+                    continue;
+                }
+                // combined CRLF or LFCR
+                if (((chr == '\n') && (st.lastChar == '\r')) || ((chr == '\r') && (st.lastChar == '\n')))
+                {
+                    st.offset += ch.Length();
+                    st.start    = st.offset;
+                    st.lastChar = 0; // important as the CRLF or LFCR has ended
+                    continue;
+                }
+                st.offset += ch.Length();
+            }
+            else
+            {
+                // conversion error --> consider one character (binary format)
+                p++;
+                st.offset++;
+            }
+            st.lastChar = 0;
+            st.charCount++;
+            if (st.charCount > MAX_CHARACTERS_PER_INDEXED_LINE)
+            {
+                if (!endLine(st.offset, 0))
+                    return false;
+            }
+        }
+    }
+    if (st.charCount > 0)
+    {
+        // last line
+        return endLine(st.offset, 0);
+    }
+    return true;
+}
+} // namespace
+
+LineIndex::~LineIndex()
+{
+    Cancel();
+}
+
+void LineIndex::Cancel()
+{
+    cancelled = true;
+    if (task.valid())
+        task.wait();
+}
+
+void LineIndex::Start(Reference<GView::Object> obj, CharacterEncoding::Encoding encoding, uint64 startOffset)
+{
+    Cancel();
+
+    this->cache    = &obj->GetData();
+    this->encoding = encoding;
+    this->checkpoints.clear();
+    this->checkpoints.push_back({ startOffset, 0 });
+    this->count      = 0;
+    this->completed  = false;
+    this->cancelled  = false;
+    this->updated    = false;
+    this->useCounter = 0;
+    this->blocks.clear();
+    this->blocks.reserve(LINE_INDEX_CACHED_BLOCKS); // pointers to blocks are returned by GetBlock
+
+    // the cache of the object is used by the UI => the background task reads the file through its own cache
+    if (obj->GetObjectType() == GView::Object::Type::File)
+    {
+        const std::filesystem::path filePath{ obj->GetPath() };
+        auto file = std::make_unique<AppCUI::OS::File>();
+        GView::Utils::DataCache workerCache;
+        if (file->OpenRead(filePath) && workerCache.Init(std::move(file), this->cache->GetCacheSize(), filePath))
+        {
+            task = std::async(std::launch::async, [this, startOffset, c = std::move(workerCache)]() mutable { Index(c, startOffset); });
+            return;
+        }
+    }
+    // memory buffers / processes: index them now
+    Index(*this->cache, startOffset);
+}
+
+void LineIndex::Index(GView::Utils::DataCache& source, uint64 startOffset)
+{
+    GView::Utils::DataCache::ReadAheadScope readAhead(source);
+    LineScanState st{ startOffset, startOffset, 0, 0 };
+    uint32 lines = 0;
+
+    ScanLines(source, encoding, st, [&](const LineInfo&) {
+        if ((cancelled) || (lines == INVALID_LINE_NUMBER - 1))
+            return false;
+        lines++;
+        if ((lines % LINE_INDEX_CHECKPOINT_INTERVAL) == 0)
+        {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                checkpoints.push_back({ st.start, st.lastChar });
+                count.store(lines, std::memory_order_release);
+            }
+            updated = true;
+            progress.notify_all();
+        }
+        else
+        {
+            count.store(lines, std::memory_order_release);
+        }
+        return true;
+    });
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        count.store(lines, std::memory_order_release);
+        completed = true;
+    }
+    updated = true;
+    progress.notify_all();
+}
+
+uint32 LineIndex::WaitForLines(uint32 linesCount)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    progress.wait(guard, [this, linesCount]() { return completed || (GetCount() >= linesCount); });
+    return GetCount();
+}
+
+const LineIndex::Block* LineIndex::GetBlock(uint32 index)
+{
+    for (auto& block : blocks)
+    {
+        if (block.index == index)
+        {
+            block.lastUse = ++useCounter;
+            return &block;
+        }
+    }
+
+    Checkpoint cp;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        CHECK(index < checkpoints.size(), nullptr, "Line block %u is not indexed yet", index);
+        cp = checkpoints[index];
+    }
+
+    // reuse the least recently used block
+    Block* block = nullptr;
+    if (blocks.size() < LINE_INDEX_CACHED_BLOCKS)
+    {
+        block = &blocks.emplace_back();
+    }
+    else
+    {
+        block = &*std::min_element(blocks.begin(), blocks.end(), [](const Block& a, const Block& b) { return a.lastUse < b.lastUse; });
+    }
+    block->index   = index;
+    block->lastUse = ++useCounter;
+    block->lines.clear();
+
+    LineScanState st{ cp.offset, cp.offset, 0, cp.lastChar };
+    ScanLines(*cache, encoding, st, [block](const LineInfo& li) {
+        block->lines.push_back(li);
+        return block->lines.size() < LINE_INDEX_CHECKPOINT_INTERVAL;
+    });
+    if (block->lines.empty())
+    {
+        block->index = INVALID_LINE_NUMBER; // do not keep it
+        return nullptr;
+    }
+    return block;
+}
+
+bool LineIndex::Get(uint32 lineNo, LineInfo& li)
+{
+    if (lineNo >= GetCount())
+        return false;
+    const auto* block = GetBlock(lineNo / LINE_INDEX_CHECKPOINT_INTERVAL);
+    CHECK(block, false, "");
+    const auto idx = lineNo % LINE_INDEX_CHECKPOINT_INTERVAL;
+    CHECK(idx < block->lines.size(), false, "");
+    li = block->lines[idx];
+    return true;
+}
+
+uint32 LineIndex::OffsetToLine(uint64 offset)
+{
+    uint32 index;
+    {
+        // wait until the block that contains the offset is indexed
+        std::unique_lock<std::mutex> guard(lock);
+        if (checkpoints.empty())
+            return 0;
+        progress.wait(guard, [this, offset]() { return completed || (checkpoints.back().offset > offset); });
+        auto it = std::upper_bound(
+              checkpoints.begin(), checkpoints.end(), offset, [](uint64 value, const Checkpoint& cp) { return value < cp.offset; });
+        index = it == checkpoints.begin() ? 0 : static_cast<uint32>((it - checkpoints.begin()) - 1);
+    }
+    const auto linesCount = GetCount();
+    if (linesCount == 0)
+        return 0;
+
+    const auto* block = GetBlock(index);
+    if (block == nullptr)
+        return linesCount - 1;
+    // last line that starts before (or at) the offset
+    auto it = std::upper_bound(
+          block->lines.begin(), block->lines.end(), offset, [](uint64 value, const LineInfo& li) { return value < li.offset; });
+    const auto idx = it == block->lines.begin() ? 0 : static_cast<uint32>((it - block->lines.begin()) - 1);
+    return std::min<uint32>(index * LINE_INDEX_CHECKPOINT_INTERVAL + idx, linesCount - 1);
+}
@@ -2,6 +2,11 @@
 
 #include "Internal.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
 namespace GView
 {
 namespace View
@@ -11,8 +16,12 @@ namespace View
         using namespace AppCUI;
         using namespace GView::Utils;
 
-        constexpr uint32 MAX_CHARACTERS_PER_LINE = 1024;
-        constexpr uint32 MAX_LINES_TO_VIEW       = 256;
+        constexpr uint32 MAX_CHARACTERS_PER_LINE         = 1024;
+        constexpr uint32 MAX_LINES_TO_VIEW               = 256;
+        constexpr uint32 MAX_CHARACTERS_PER_INDEXED_LINE = 2000; // longer lines are split
+        constexpr uint32 LINE_INDEX_CHECKPOINT_INTERVAL  = 1024; // only the start of every 1024th line is stored
+        constexpr uint32 LINE_INDEX_CACHED_BLOCKS        = 16;   // blocks of decoded lines kept in memory
+        constexpr uint32 INVALID_LINE_NUMBER             = 0xFFFFFFFF;
 
         struct SettingsData
         {
@@ -59,6 +68,64 @@ namespace View
             {
             }
         };
+        // Line offsets of a text object. A checkpoint (where the line starts) is kept for every LINE_INDEX_CHECKPOINT_INTERVAL
+        // lines; the lines between two checkpoints are decoded when they are needed and the last used blocks are cached.
+        // Files are indexed in background and the checkpoints are published as they are found, so lines [0, GetCount())
+        // can be used while the rest of the file is still being indexed.
+        class LineIndex
+        {
+            struct Checkpoint
+            {
+                uint64 offset;
+                char16 lastChar; // new line character that ended the previous line (CRLF / LFCR are a single new line)
+            };
+            struct Block
+            {
+                uint32 index;
+                uint64 lastUse;
+                std::vector<LineInfo> lines;
+            };
+
+            GView::Utils::DataCache* cache{ nullptr }; // the cache of the object (blocks are decoded on the UI thread)
+            CharacterEncoding::Encoding encoding{ CharacterEncoding::Encoding::Binary };
+
+            std::mutex lock;
+            std::condition_variable progress;
+            std::vector<Checkpoint> checkpoints; // guarded by 'lock'
+            std::atomic<uint32> count{ 0 };
+            std::atomic<bool> completed{ true }; // nothing to index until Start is called
+            std::atomic<bool> cancelled{ false };
+            std::atomic<bool> updated{ false }; // set at every checkpoint and on completion, cleared by the UI thread
+            std::future<void> task;
+
+            std::vector<Block> blocks;
+            uint64 useCounter{ 0 };
+
+            void Index(GView::Utils::DataCache& source, uint64 startOffset);
+            const Block* GetBlock(uint32 index);
+
+          public:
+            ~LineIndex();
+
+            void Start(Reference<GView::Object> obj, CharacterEncoding::Encoding encoding, uint64 startOffset);
+            void Cancel();
+            uint32 WaitForLines(uint32 linesCount); // waits until 'linesCount' lines (or the entire object) are indexed
+            bool Get(uint32 lineNo, LineInfo& li);
+            uint32 OffsetToLine(uint64 offset);
+            inline uint32 GetCount() const
+            {
+                return count.load(std::memory_order_acquire);
+            }
+            inline bool IsCompleted() const
+            {
+                return completed;
+            }
+            // true (once) if lines were indexed since the last call => the UI thread refreshes the view
+            inline bool ConsumeUpdate()
+            {
+                return updated.exchange(false);
+            }
+        };
         class Instance : public View::ViewControl
         {
             enum class Direction
@@ -72,12 +139,13 @@ namespace View
                 Text,
                 Border
             };
-            std::vector<LineInfo> lines;      
+            LineIndex lines;
             Utils::Selection selection;
             Pointer<SettingsData> settings;
             Reference<GView::Object> obj;
             Character chars[MAX_CHARACTERS_PER_LINE];
             uint32 lineNumberWidth;
+            uint64 estimatedLinesCount; // used for the width of the line numbers until the entire file is indexed
             uint32 sizeOfBOM;
             MouseStatus mouseStatus;
 
@@ -125,6 +193,8 @@ namespace View
             void OpenCurrentSelection();
 
             void RecomputeLineIndexes();
+            void UpdateLineNumberWidth();
+            void OnLineIndexUpdated();
             void CommputeViewPort_NoWrap(uint32 lineNo, Direction dir);
             void CommputeViewPort_Wrap(uint32 lineNo, uint32 subLineNo, Direction dir);
             void ComputeViewPort(uint32 lineNo, uint32 subLineNo, Direction dir);
@@ -204,6 +274,7 @@ namespace View
             Reference<TextField> txFileOffset;
             uint64 maxSize;
             uint32 maxLines;
+            bool allLinesIndexed; // if false, 'maxLines' is only the number of lines indexed so far
             uint64 resultedPos;
             bool gotoLine;
             
@@ -211,7 +282,7 @@ namespace View
             void Validate();
 
           public:
-            GoToDialog(uint64 currentPos, uint64 size, uint32 currentLine, uint32 maxLines);
+            GoToDialog(uint64 currentPos, uint64 size, uint32 currentLine, uint32 maxLines, bool allLinesIndexed);
 
             virtual bool OnEvent(Reference<Control>, Event eventType, int ID) override;
             inline uint64 GetFileOffset() const
@@ -2,8 +2,12 @@
 
 #include "GView.hpp"
 
+#include <chrono>
+#include <future>
+#include <mutex>
 #include <set>
 #include <span>
+#include <unordered_map>
 
 using namespace AppCUI::Controls;
 using namespace AppCUI::Graphics;
@@ -262,11 +266,25 @@ namespace Generic
             Input::Key ShortKey;
         } Commands[MAX_PLUGINS_COMMANDS];
         uint32 CommandsCount;
+        uint64 loadTime; // microseconds
         bool (*fnRun)(const string_view command, Reference<GView::Object> currentObject);
 
       public:
         Plugin();
         bool Init(AppCUI::Utils::IniSection section);
+        bool Load();
+        inline std::string_view GetName() const
+        {
+            return Name;
+        }
+        inline bool IsLoaded() const
+        {
+            return fnRun != nullptr;
+        }
+        inline uint64 GetLoadTime() const
+        {
+            return loadTime;
+        }
         void UpdateCommandBar(AppCUI::Application::CommandBar& commandBar, uint32 commandID);
         void Run(uint32 commandIndex, Reference<GView::Object> currentObject);
     };
@@ -322,10 +340,20 @@ namespace Type
                 return std::span<uint32>(this->Lines.offsets, static_cast<size_t>(this->Lines.count));
             }
         };
+        enum class PrefixKind : uint8
+        {
+            None,   // matcher can not be reduced to a fixed prefix
+            Binary, // prefix is compared against the raw buffer
+            Text    // prefix is compared against the (unicode) text of the buffer
+        };
         struct Interface
         {
             virtual bool Init(std::string_view text)                            = 0;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) = 0;
+            virtual PrefixKind GetPrefix(std::string_view& /*prefix*/) const
+            {
+                return PrefixKind::None;
+            }
         };
         class MagicMatcher : public Interface
         {
@@ -344,6 +372,7 @@ namespace Type
             }
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual PrefixKind GetPrefix(std::string_view& prefix) const override;
         };
         class StartsWithMatcher : public Interface
         {
@@ -352,6 +381,7 @@ namespace Type
           public:
             virtual bool Init(std::string_view text) override;
             virtual bool Match(AppCUI::Utils::BufferView buf, TextParser& text) override;
+            virtual PrefixKind GetPrefix(std::string_view& prefix) const override;
         };
         class LineStartsWithMatcher : public Interface
         {
@@ -365,6 +395,34 @@ namespace Type
         Interface* CreateFromString(std::string_view stringRepresentation);
     } // namespace Matcher
 
+    class Plugin;
+    class PluginIndex
+    {
+        struct Node
+        {
+            std::vector<std::pair<uint16, uint32>> next; // sorted by character
+            std::vector<uint32> plugins;                 // plugins whose prefix ends in this node
+        };
+        std::unordered_map<uint64, std::vector<uint32>> extensions;
+        std::vector<Node> binaryTrie;
+        std::vector<Node> textTrie;
+        std::vector<uint32> unindexed; // plugins with at least one pattern that is not a prefix (e.g. linestartswith)
+
+        static void AddPrefix(std::vector<Node>& trie, std::string_view prefix, uint32 pluginIndex);
+        template <typename T>
+        static void MatchPrefix(const std::vector<Node>& trie, const T* p, size_t size, std::vector<uint32>& output);
+
+      public:
+        PluginIndex();
+        void Clear();
+        void AddExtension(uint64 extensionHash, uint32 pluginIndex);
+        void AddPattern(const Matcher::Interface* pattern, uint32 pluginIndex);
+
+        std::span<const uint32> GetExtensionCandidates(uint64 extensionHash) const;
+        void GetContentCandidates(
+              AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser, std::vector<Plugin>& plugins, std::vector<uint32>& output) const;
+    };
+
     struct PluginCommand
     {
         FixSizeString<25> name;
@@ -382,6 +440,12 @@ namespace Type
         FixSizeString<124> description;
         uint16 priority;
         bool Loaded, Invalid;
+        struct
+        {
+            uint64 load;     // microseconds spent loading the library
+            uint64 validate; // microseconds spent in 'Validate' (all calls)
+            uint32 validateCalls;
+        } timings;
 
         bool (*fnValidate)(const AppCUI::Utils::BufferView& buf, const std::string_view& extension);
         TypeInterface* (*fnCreateInstance)();
@@ -395,7 +459,9 @@ namespace Type
         void Init();
         bool MatchExtension(uint64 extensionHash);
         bool MatchContent(AppCUI::Utils::BufferView buf, Matcher::TextParser& textParser);
+        bool Load();
         bool IsOfType(AppCUI::Utils::BufferView buf, GView::Type::Matcher::TextParser& textParser, const std::string_view& extension = "");
+        void AddToIndex(PluginIndex& index, uint32 pluginIndex) const;
         bool PopulateWindow(Reference<GView::View::WindowInterface> win) const;
         TypeInterface* CreateInstance() const;
         inline bool operator<(const Plugin& plugin) const
@@ -414,6 +480,22 @@ namespace Type
         {
             return commands;
         }
+        inline bool IsLoaded() const
+        {
+            return Loaded;
+        }
+        inline uint64 GetLoadTime() const
+        {
+            return timings.load;
+        }
+        inline uint64 GetValidateTime() const
+        {
+            return timings.validate;
+        }
+        inline uint32 GetValidateCalls() const
+        {
+            return timings.validateCalls;
+        }
 
         static uint64 ExtensionToHash(std::string_view ext);
         static uint64 ExtensionToHash(std::u16string_view ext);
@@ -475,14 +557,19 @@ namespace App
         AppCUI::Controls::Menu* mnuHelp;
         AppCUI::Controls::Menu* mnuFile;
         std::vector<GView::Type::Plugin> typePlugins;
+        GView::Type::PluginIndex typePluginsIndex;
         std::vector<GView::Generic::Plugin> genericPlugins;
         GView::Type::Plugin defaultPlugin;
         GView::Utils::ErrorList errList;
         uint32 defaultCacheSize;
+        bool memoryMappedFiles;
+        bool preloadPlugins;
+        std::future<void> pluginsPreload; // plugins are loaded in background (if 'PreloadPlugins' is set)
         std::filesystem::path lastOpenedFolderLocation;
+        std::mutex identifyLock; // type plugins are loaded on first use (headless mode identifies files from multiple threads)
 
         bool BuildMainMenus();
-        bool LoadSettings();
+        bool LoadSettings(AppCUI::Utils::IniObject* ini);
         void OpenFile();
         void OpenFolder();
         void ShowErrors();
@@ -537,11 +624,20 @@ namespace App
               std::string_view typeName,
               Reference<Window> parent = nullptr);
         bool AddFolder(const std::filesystem::path& path);
+        void LoadAllPlugins();
+        void WaitForPluginsPreload();
 
       public:
         Instance();
         virtual ~Instance() {}
         bool Init();
+        bool InitHeadless();
+        bool Analyze(const std::filesystem::path& path, std::string_view typeName, AnalysisReport& report);
+        bool PreloadPlugins();
+        bool ValidateWithAllTypePlugins(const std::filesystem::path& path);
+        bool GetTypePluginTimings(uint32 index, PluginTimings& timings);
+        bool GetGenericPluginTimings(uint32 index, PluginTimings& timings);
+        uint32 GetGenericPluginsCount();
         bool AddFileWindow(const std::filesystem::path& path, OpenMethod method, string_view typeName, Reference<Window> parent = nullptr);
         bool AddBufferWindow(BufferView buf, const ConstString& name, const ConstString& path, OpenMethod method, string_view typeName, Reference<Window> parent);
         void UpdateCommandBar(AppCUI::Application::CommandBar& commandBar);
@@ -625,7 +721,7 @@ namespace App
     class FileWindowProperties : public Window
     {
       public:
-        FileWindowProperties(Reference<Tab> viewContainer);
+        FileWindowProperties(Reference<Tab> viewContainer, Reference<GView::Object> obj);
         bool OnEvent(Reference<Control>, Event eventType, int) override;
     };
 
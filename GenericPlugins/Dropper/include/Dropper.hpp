@@ -15,6 +15,7 @@
 #include "Images.hpp"
 #include "Archives.hpp"
 #include "Cryptographic.hpp"
+#include "TriggerScanner.hpp"
 
 using namespace GView::Utils;
 using namespace GView::GenericPlugins::Droppper::SpecialStrings;
@@ -31,12 +32,27 @@ constexpr std::string_view DEFAULT_BINARY_INCLUDE_CHARSET{ "\\x00-\\xff" };
 constexpr std::string_view DEFAULT_BINARY_EXCLUDE_CHARSET{ "" };
 constexpr int32 BINARY_CHARSET_MATRIX_SIZE{ 256 };
 constexpr int8 HEX_NUMBER_SIZE{ 4 };
+constexpr uint64 SCAN_CHUNK_SIZE{ 0x10000 };
+constexpr uint64 SHARD_SIZE{ 0x1000000 };
 
 struct PluginClassification {
     Category category{};
     Subcategory subcategory{};
 };
 
+// a finding + the offset where the (non recursive) scan resumes after it
+struct ScanHit {
+    Finding finding;
+    uint64 next;
+};
+
+struct ScanSetup {
+    const std::vector<std::unique_ptr<IDrop>*>& droppers;
+    const TriggerScanner& scanner;
+    bool recursive;
+    ArtefactIdentificationCallback identify;
+};
+
 class Instance
 {
   private:
@@ -48,6 +64,7 @@ class Instance
         bool initialized;
 
         bool binaryCharSetMatrix[BINARY_CHARSET_MATRIX_SIZE];
+        GView::Utils::StringsExtractor binaryCharSetFilter; // same character set as binaryCharSetMatrix
 
         GView::Utils::ZonesList zones;
         std::vector<Finding> findings;
@@ -82,7 +99,6 @@ class Instance
 
     bool Init(Reference<GView::Object> object);
 
-    BufferView GetPrecachedBuffer(uint64 offset, DataCache& cache);
     std::optional<std::ofstream> InitLogFile(const std::filesystem::path& p, const std::vector<std::pair<uint64, uint64>>& areas, bool noHeader = false);
     bool WriteSummaryToLog(std::ofstream& f, std::map<std::string_view, uint32>& occurences);
     bool WriteToLog(std::ofstream& f, uint64 start, uint64 end, Result result, std::unique_ptr<IDrop>& dropper, bool addValue = false, bool writeValueOnly = false);
@@ -95,6 +111,7 @@ class Instance
           bool writeLog,
           bool highlightObjects);
     bool ProcessObjects(const std::vector<PluginClassification>& plugins, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify = nullptr);
+    bool ProcessObjectsSharded(const ScanSetup& setup, uint64 offset, uint64 size, uint32 workersCount, std::vector<ScanHit>& hits, uint32 objectsCount);
     bool SetHighlighting(bool value, bool warn = false);
 
     bool HandleComputationAreas();
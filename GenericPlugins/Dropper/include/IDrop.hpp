@@ -18,8 +18,16 @@ class IDrop
     virtual bool ShouldGroupInOneFile() const                 = 0; // URLs, IPs, etc
 
     // prechachedBufferSize -> max 8
+    // the same instance is used by all the workers of a sharded scan => everything that was found is reported through
+    // 'finding' (Check must not keep per-call state in the dropper)
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) = 0;
 
+    // byte sequences every finding of this dropper starts with (ASCII letters compare case insensitive) - Check() is only
+    // called at offsets where one of them occurs; droppers that declare no triggers are checked at every offset
+    virtual void GetTriggers(std::vector<std::string>& triggers) const
+    {
+    }
+
     // helpers
     inline bool IsMagicU16(BufferView precachedBuffer, uint16 magic) const
     {
@@ -45,6 +53,12 @@ class IDrop
         return false;
     }
 
+    template <typename T>
+    inline static std::string MagicToTrigger(T magic)
+    {
+        return std::string(reinterpret_cast<const char*>(&magic), sizeof(magic));
+    }
+
     inline static bool IsAsciiPrintable(char c)
     {
         return 0x20 <= c && c <= 0x7e;
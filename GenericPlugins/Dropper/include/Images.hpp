@@ -18,6 +18,7 @@ class PNG : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 
 class JPG : public IDrop
@@ -34,5 +35,6 @@ class JPG : public IDrop
     virtual bool ShouldGroupInOneFile() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 } // namespace GView::GenericPlugins::Droppper::Images
@@ -65,6 +65,7 @@ class IpAddress : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 class EmailAddress : public SpecialStrings
 {
@@ -76,6 +77,7 @@ class EmailAddress : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 class Filepath : public SpecialStrings
 {
@@ -87,6 +89,7 @@ class Filepath : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 class URL : public SpecialStrings
 {
@@ -98,12 +101,10 @@ class URL : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 class Wallet : public SpecialStrings
 {
-  public:
-    WalletType checkResult{};
-
   public:
     Wallet(bool caseSensitive, bool unicode);
 
@@ -112,8 +113,7 @@ class Wallet : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
-
-    WalletType GetLastCheckResult() const;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 class Registry : public SpecialStrings
 {
@@ -125,6 +125,7 @@ class Registry : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 };
 
 // text class has a separate purpose
@@ -135,6 +136,7 @@ class Text : public SpecialStrings
     uint32 minLength{ 8 };
     uint32 maxLength{ 128 };
     bool stringsCharSetMatrix[STRINGS_CHARSET_MATRIX_SIZE]{};
+    GView::Utils::StringsExtractor extractor; // same character set as stringsCharSetMatrix
 
   public:
     Text(bool caseSensitive, bool unicode);
@@ -144,12 +146,13 @@ class Text : public SpecialStrings
     virtual Subcategory GetSubcategory() const override;
 
     virtual bool Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding) override;
+    virtual void GetTriggers(std::vector<std::string>& triggers) const override;
 
     bool SetMinLength(uint32 minLength);
     bool SetMaxLength(uint32 maxLength);
     bool SetAscii(bool value);
     bool SetUnicode(bool value);
     void SetMatrix(bool stringsCharSetMatrix[STRINGS_CHARSET_MATRIX_SIZE]);
-    bool IsValidChar(char c) const;
+    bool IsValidChar(uint8 c) const;
 };
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "IDrop.hpp"
+
+namespace GView::GenericPlugins::Droppper
+{
+// Aho-Corasick automaton over the triggers of a set of droppers - a single pass over the data yields every offset where at
+// least one dropper could match, regardless of how many droppers are enabled
+class TriggerScanner
+{
+  public:
+    struct Candidate {
+        uint64 offset;
+        uint32 dropper; // index in the droppers list given to Build
+    };
+
+  private:
+    struct Output {
+        uint32 dropper;
+        uint32 length;
+    };
+
+    std::vector<uint32> transitions;   // states x 256, fully resolved (no failure links at scan time)
+    std::vector<uint32> outputsStart;  // states + 1 entries -> [outputsStart[s], outputsStart[s + 1]) in outputs
+    std::vector<Output> outputs;
+    std::vector<uint32> unconditional; // droppers without triggers
+    uint32 maxLength{ 0 };
+    uint32 state{ 0 };
+
+  public:
+    bool Build(const std::vector<std::vector<std::string>>& triggers);
+    void Reset();
+    void Scan(BufferView buffer, uint64 offset, std::vector<Candidate>& candidates);
+
+    uint32 GetMaxTriggerLength() const
+    {
+        return maxLength;
+    }
+    const std::vector<uint32>& GetUnconditionalDroppers() const
+    {
+        return unconditional;
+    }
+};
+} // namespace GView::GenericPlugins::Droppper
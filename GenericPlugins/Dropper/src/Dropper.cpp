@@ -3,8 +3,11 @@
 #include "Artefacts.hpp"
 
 #include <array>
+#include <atomic>
 #include <regex>
 #include <charconv>
+#include <future>
+#include <thread>
 
 using namespace AppCUI;
 using namespace AppCUI::Utils;
@@ -84,11 +87,6 @@ bool Instance::Init(Reference<GView::Object> object)
     return true;
 }
 
-BufferView Instance::GetPrecachedBuffer(uint64 offset, DataCache& cache)
-{
-    return cache.Get(offset, MAX_PRECACHED_BUFFER_SIZE, true);
-}
-
 std::optional<std::ofstream> Instance::InitLogFile(const std::filesystem::path& p, const std::vector<std::pair<uint64, uint64>>& areas, bool noHeader)
 {
     std::ofstream logFile;
@@ -267,11 +265,130 @@ bool Instance::DropObjects(
     return true;
 }
 
+// progress callback -> (offset reached, findings so far); returning false stops the scan
+using ScanProgress = std::function<bool(uint64, uint32)>;
+
+// Runs the droppers over the candidates that start in [offset, size). Does not touch the shared context, so it can be
+// called concurrently as long as every caller uses its own cache. 'endOffset' receives the offset the scan would resume from.
+static bool ScanRange(const ScanSetup& setup, DataCache& cache, uint64 offset, uint64 size, std::vector<ScanHit>& hits, uint64& endOffset, const ScanProgress& progress)
+{
+    TriggerScanner scanner  = setup.scanner;
+    const auto& unconditional = scanner.GetUnconditionalDroppers();
+    scanner.Reset();
+
+    DataCache::ReadAheadScope readAhead(cache);
+    const uint64 chunkSize  = std::min<uint64>(SCAN_CHUNK_SIZE, cache.GetCacheSize());
+    const uint64 lookBehind = std::max<uint32>(scanner.GetMaxTriggerLength(), 1) - 1;
+    const uint64 scanEnd    = std::min<uint64>(size + lookBehind, cache.GetSize()); // triggers that start before size may end after it
+    uint64 scanOffset       = offset;
+    size_t processed        = 0;
+    std::vector<TriggerScanner::Candidate> candidates;
+    while (offset < size) {
+        CHECKBK(scanOffset < scanEnd || processed < candidates.size(), "");
+
+        // read the next chunk - the candidates are collected before any Check() call, as those may evict cache pages
+        candidates.erase(candidates.begin(), candidates.begin() + processed);
+        processed        = 0;
+        const auto chunk = scanOffset;
+        if (scanOffset < scanEnd) {
+            auto buffer = cache.Get(scanOffset, static_cast<uint32>(std::min<uint64>(chunkSize, scanEnd - scanOffset)), false);
+            CHECKBK(buffer.GetLength() > 0, "");
+            scanner.Scan(buffer, scanOffset, candidates);
+            scanOffset += buffer.GetLength();
+        }
+        for (const auto dropper : unconditional) {
+            for (auto o = std::max<uint64>(chunk, offset); o < std::min<uint64>(scanOffset, size); o++) {
+                candidates.push_back({ o, dropper });
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const TriggerScanner::Candidate& a, const TriggerScanner::Candidate& b) {
+            return a.offset < b.offset || (a.offset == b.offset && a.dropper < b.dropper);
+        });
+
+        // a trigger that starts before this limit ends inside the data scanned so far -> all its candidates are known
+        const auto limit = std::min<uint64>(size, scanOffset >= scanEnd ? scanEnd : scanOffset - std::min<uint64>(lookBehind, scanOffset));
+        while (processed < candidates.size() && candidates[processed].offset < limit) {
+            const auto candidateOffset = candidates[processed].offset;
+            auto groupEnd              = processed;
+            while (groupEnd < candidates.size() && candidates[groupEnd].offset == candidateOffset) {
+                groupEnd++;
+            }
+            if (candidateOffset < offset) {
+                // inside an object that was already found (non recursive mode)
+                processed = groupEnd;
+                continue;
+            }
+
+            auto buffer = cache.Get(candidateOffset, MAX_PRECACHED_BUFFER_SIZE, true);
+            if (buffer.GetLength() == 0) {
+                // nothing can be read from here on
+                processed = candidates.size();
+                offset    = size;
+                break;
+            }
+            uint64 nextOffset = candidateOffset + 1;
+
+            for (uint32 i = 0; i < static_cast<uint32>(Priority::Count); i++) {
+                const auto priority = static_cast<Priority>(i);
+                if (priority == Priority::Text) {
+                    if (!IDrop::IsAsciiPrintable(buffer.GetData()[0])) {
+                        continue;
+                    }
+                }
+
+                for (auto c = processed; c < groupEnd; c++) {
+                    if (c > processed && candidates[c].dropper == candidates[c - 1].dropper) {
+                        continue; // more than one trigger of the same dropper starts here
+                    }
+                    auto& dropper = *setup.droppers[candidates[c].dropper];
+                    if (dropper->GetPriority() != priority) {
+                        continue;
+                    }
+
+                    Finding finding{ .dropperName = dropper->GetName(), .category = dropper->GetCategory(), .subcategory = dropper->GetSubcategory() };
+                    const auto result = dropper->Check(candidateOffset, cache, buffer, finding);
+
+                    if (result && finding.result != Result::NotFound) {
+                        if (!setup.recursive) {
+                            nextOffset = finding.end;
+                        }
+                        auto& hit = hits.emplace_back(ScanHit{ finding, nextOffset });
+                        auto& f   = hit.finding;
+
+                        // adjust for zones
+                        if (f.result == Result::Unicode) {
+                            f.end -= 2;
+                        } else if (f.result == Result::Ascii) {
+                            f.end -= 1;
+                        } else {
+                            f.end += 1;
+                        }
+
+                        if (setup.identify != nullptr) {
+                            f.artefact = setup.identify(cache, f.subcategory, f.start, f.end, f.result);
+                        }
+
+                        break;
+                    }
+                }
+            }
+
+            offset    = nextOffset;
+            processed = groupEnd;
+        }
+        offset = std::max<uint64>(offset, limit);
+
+        CHECKBK(progress == nullptr || progress(std::min<uint64>(offset, size), static_cast<uint32>(hits.size())), "");
+    }
+
+    endOffset = offset;
+    return true;
+}
+
 bool Instance::ProcessObjects(
       const std::vector<PluginClassification>& plugins, uint64 offset, uint64 size, bool recursive, ArtefactIdentificationCallback identify)
 {
-    DataCache& cache  = object->GetData();
-    uint64 nextOffset = offset;
+    DataCache& cache = object->GetData();
 
     std::vector<std::unique_ptr<IDrop>*> whitelistedPlugins;
     whitelistedPlugins.reserve(context.objectDroppers.size());
@@ -291,81 +408,130 @@ bool Instance::ProcessObjects(
         whitelistedPlugins.push_back(&context.textDropper);
     }
 
-    ProgressStatus::Init("Searching...", size);
-    LocalString<512> ls;
-    const char* format          = "[%llu/%llu] bytes... Found [%u] object(s).";
-    constexpr uint64 CHUNK_SIZE = 10000;
-    uint64 chunks               = offset / CHUNK_SIZE;
-    uint64 toUpdate             = chunks * CHUNK_SIZE;
-    while (offset < size) {
-        if (offset >= toUpdate) {
-            uint32 objectsCount = 0;
-            for (const auto& [_, v] : context.occurences) {
-                objectsCount += v;
-            }
-
-            CHECKBK(ProgressStatus::Update(offset, ls.Format(format, offset, size, objectsCount)) == false, "");
-            chunks += 1;
-            toUpdate = chunks * CHUNK_SIZE;
-
-            cache.Get(offset, cache.GetCacheSize(), false); // optimization
-        }
-
-        auto buffer = GetPrecachedBuffer(offset, cache);
-        CHECKBK(buffer.GetLength() > 0, "");
-        nextOffset = offset + 1;
+    // one automaton for the triggers of all the whitelisted droppers -> Check() only runs at candidate offsets
+    std::vector<std::vector<std::string>> triggers(whitelistedPlugins.size());
+    for (size_t i = 0; i < whitelistedPlugins.size(); i++) {
+        (*whitelistedPlugins[i])->GetTriggers(triggers[i]);
+    }
+    TriggerScanner scanner;
+    CHECK(scanner.Build(triggers), false, "");
+    const ScanSetup setup{ .droppers = whitelistedPlugins, .scanner = scanner, .recursive = recursive, .identify = identify };
 
-        for (uint32 i = 0; i < static_cast<uint32>(Priority::Count); i++) {
-            const auto priority = static_cast<Priority>(i);
-            if (priority == Priority::Text) {
-                if (!IDrop::IsAsciiPrintable(buffer.GetData()[0])) {
-                    continue;
-                }
-            }
+    uint32 objectsCount = 0;
+    for (const auto& [_, v] : context.occurences) {
+        objectsCount += v;
+    }
 
-            for (auto& dropper : whitelistedPlugins) {
-                if ((*dropper)->GetPriority() != priority) {
-                    continue;
-                }
+    ProgressStatus::Init("Searching...", size);
+    LocalString<512> ls;
+    const char* format = "[%llu/%llu] bytes... Found [%u] object(s).";
+
+    // large ranges of local files are split into shards scanned in parallel (falls back to a single pass if the file can not be reopened)
+    std::vector<ScanHit> hits;
+    const auto workers = std::min<uint64>(std::max<uint32>(std::thread::hardware_concurrency(), 1U), (size - std::min(offset, size)) / SHARD_SIZE);
+    const auto sharded = workers > 1 && object->GetObjectType() == GView::Object::Type::File &&
+                         ProcessObjectsSharded(setup, offset, size, static_cast<uint32>(workers), hits, objectsCount);
+    if (!sharded) {
+        uint64 endOffset = offset;
+        ScanRange(setup, cache, offset, size, hits, endOffset, [&](uint64 reached, uint32 found) {
+            return ProgressStatus::Update(reached, ls.Format(format, reached, size, objectsCount + found)) == false;
+        });
+    }
 
-                Finding finding{ .dropperName = (*dropper)->GetName(), .category = (*dropper)->GetCategory(), .subcategory = (*dropper)->GetSubcategory() };
-                const auto result = (*dropper)->Check(offset, cache, buffer, finding);
+    for (const auto& hit : hits) {
+        const auto& f = context.findings.emplace_back(hit.finding);
+        context.occurences[f.dropperName] += 1;
+        context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
+    }
 
-                if (result && finding.result != Result::NotFound) {
-                    auto& f = context.findings.emplace_back(finding);
-                    context.occurences[f.dropperName] += 1;
+    objectsCount += static_cast<uint32>(hits.size());
+    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
 
-                    if (!recursive) {
-                        nextOffset = f.end;
-                    }
+    return true;
+}
 
-                    // adjust for zones
-                    if (f.result == Result::Unicode) {
-                        f.end -= 2;
-                    } else if (f.result == Result::Ascii) {
-                        f.end -= 1;
-                    } else {
-                        f.end += 1;
-                    }
-                    context.zones.Add(f.start, f.end, OBJECT_CATEGORY_COLOR_MAP.at(f.category), f.dropperName);
+bool Instance::ProcessObjectsSharded(const ScanSetup& setup, uint64 offset, uint64 size, uint32 workersCount, std::vector<ScanHit>& hits, uint32 objectsCount)
+{
+    // every worker reads through its own cache over the same file (DataCache is not thread safe)
+    DataCache& cache = object->GetData();
+    const std::filesystem::path path{ std::u16string{ object->GetPath() } };
+    std::vector<DataCache> caches(workersCount);
+    for (auto& c : caches) {
+        auto file = std::make_unique<AppCUI::OS::File>();
+        CHECK(file->OpenRead(path), false, "");
+        CHECK(c.Init(std::move(file), cache.GetCacheSize(), path), false, "");
+    }
 
-                    if (identify != nullptr) {
-                        f.artefact = identify(cache, f.subcategory, f.start, f.end, f.result);
-                    }
+    // shards own the candidates that start inside them; Check() may read past the shard end through the worker cache
+    const auto shardsCount = static_cast<size_t>((size - offset + SHARD_SIZE - 1) / SHARD_SIZE);
+    struct Shard {
+        std::vector<ScanHit> hits;
+        uint64 endOffset{ 0 };
+        bool done{ false };
+    };
+    std::vector<Shard> shards(shardsCount);
+    std::atomic<size_t> nextShard{ 0 };
+    std::atomic<uint64> scanned{ 0 };
+    std::atomic<uint32> found{ 0 };
+    std::atomic<bool> cancelled{ false };
+
+    std::vector<std::future<void>> workers;
+    for (uint32 w = 0; w < workersCount; w++) {
+        workers.push_back(std::async(std::launch::async, [&, w]() {
+            for (auto index = nextShard++; index < shardsCount && cancelled == false; index = nextShard++) {
+                const auto start = offset + index * SHARD_SIZE;
+                const auto end   = std::min<uint64>(start + SHARD_SIZE, size);
+                auto reached     = start;
+                auto reported    = 0U;
+                auto& shard      = shards[index];
+                ScanRange(setup, caches[w], start, end, shard.hits, shard.endOffset, [&](uint64 current, uint32 count) {
+                    scanned += current - reached;
+                    found += count - reported;
+                    reached  = current;
+                    reported = count;
+                    return cancelled == false;
+                });
+                shard.done = cancelled == false;
+            }
+        }));
+    }
 
-                    break;
-                }
+    LocalString<512> ls;
+    const char* format = "[%llu/%llu] bytes... Found [%u] object(s).";
+    for (auto& worker : workers) {
+        while (worker.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout) {
+            const auto current = offset + scanned.load();
+            if (ProgressStatus::Update(current, ls.Format(format, current, size, objectsCount + found.load()))) {
+                cancelled = true;
             }
         }
-
-        offset = nextOffset;
     }
 
-    uint32 objectsCount = 0;
-    for (const auto& [_, v] : context.occurences) {
-        objectsCount += v;
+    // merge in offset order: a shard was scanned as if nothing was found before its start - in non recursive mode the real
+    // scan may still be inside an object found in a previous shard, so the hits covered by it are dropped and, where the
+    // shard had skipped data because of such a hit, that data is rescanned sequentially until both scans are in sync again
+    uint64 position = offset;
+    for (auto& shard : shards) {
+        CHECKBK(shard.done, "");
+
+        size_t h = 0;
+        while (true) {
+            auto conflictEnd = position;
+            for (; h < shard.hits.size() && shard.hits[h].finding.start < position; h++) {
+                conflictEnd = std::max<uint64>(conflictEnd, shard.hits[h].next);
+            }
+            if (setup.recursive || conflictEnd <= position || position >= size) {
+                break;
+            }
+            const auto rescanEnd = std::min<uint64>(conflictEnd, size);
+            ScanRange(setup, cache, position, rescanEnd, hits, position, nullptr);
+            position = std::max<uint64>(position, rescanEnd);
+        }
+        for (; h < shard.hits.size(); h++) {
+            hits.push_back(shard.hits[h]);
+        }
+        position = std::max<uint64>(position, shard.endOffset);
     }
-    ProgressStatus::Update(size, ls.Format(format, size, size, objectsCount));
 
     return true;
 }
@@ -490,18 +656,20 @@ bool Instance::DropBinaryData(
     auto& cache          = this->object->GetData();
     const auto cacheSize = cache.GetCacheSize();
 
+    // write the runs of allowed bytes at once instead of byte by byte
+    const auto WriteFiltered = [&droppedFile](BufferView bf) {
+        context.binaryCharSetFilter.Find(bf, 0, 1, 0, true, false, [&droppedFile, bf](uint64 start, uint64 end, GView::Utils::StringsExtractor::StringType) {
+            droppedFile.write(reinterpret_cast<const char*>(bf.GetData() + start), static_cast<std::streamsize>(end - start));
+            return true;
+        });
+    };
+
     for (const auto& area : areas) {
         const auto size = area.second - area.first;
         if (size < cacheSize) {
             auto bf = cache.Get(area.first, static_cast<int32>(size), true);
             CHECK(bf.IsValid(), false, "");
-
-            for (int32 i = 0; i < bf.GetLength(); i++) {
-                const auto c = bf[i];
-                if (context.binaryCharSetMatrix[c]) {
-                    droppedFile << c;
-                }
-            }
+            WriteFiltered(bf);
         } else {
             auto sizeLeft = size - cacheSize;
             auto offset   = area.first;
@@ -509,12 +677,7 @@ bool Instance::DropBinaryData(
             offset += cacheSize;
 
             while (bf.IsValid() && !bf.Empty()) {
-                for (int32 i = 0; i < bf.GetLength(); i++) {
-                    const auto c = bf[i];
-                    if (context.binaryCharSetMatrix[c]) {
-                        droppedFile << c;
-                    }
-                }
+                WriteFiltered(bf);
 
                 const auto sizeToRead = std::min<int64>(sizeLeft, cacheSize);
                 sizeLeft -= sizeToRead;
@@ -629,12 +792,14 @@ bool Instance::ProcessBinaryDataCharset(std::string_view include, std::string_vi
 {
     if (include == DEFAULT_BINARY_INCLUDE_CHARSET && exclude == DEFAULT_BINARY_EXCLUDE_CHARSET) {
         memset(context.binaryCharSetMatrix, true, BINARY_CHARSET_MATRIX_SIZE);
+        context.binaryCharSetFilter.SetMask(context.binaryCharSetMatrix);
         return true;
     }
 
     memset(context.binaryCharSetMatrix, false, BINARY_CHARSET_MATRIX_SIZE);
     CHECK(FillCharSetMatrix(context.binaryCharSetMatrix, include, true), false, "");
     CHECK(FillCharSetMatrix(context.binaryCharSetMatrix, exclude, false), false, "");
+    context.binaryCharSetFilter.SetMask(context.binaryCharSetMatrix);
 
     return true;
 }
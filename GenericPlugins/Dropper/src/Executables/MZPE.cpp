@@ -199,6 +199,11 @@ bool MZPE::ShouldGroupInOneFile() const
     return false;
 }
 
+void MZPE::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.push_back(MagicToTrigger(IMAGE_DOS_SIGNATURE));
+}
+
 bool MZPE::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(IsMagicU16(precachedBuffer, IMAGE_DOS_SIGNATURE), false, "");
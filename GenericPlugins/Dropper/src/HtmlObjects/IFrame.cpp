@@ -35,6 +35,11 @@ bool IFrame::ShouldGroupInOneFile() const
     return false;
 }
 
+void IFrame::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.emplace_back(START);
+}
+
 bool IFrame::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() >= START.size(), false, "");
@@ -35,6 +35,11 @@ bool PHP::ShouldGroupInOneFile() const
     return false;
 }
 
+void PHP::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.emplace_back(START);
+}
+
 bool PHP::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() >= START.size(), false, "");
@@ -35,6 +35,11 @@ bool Script::ShouldGroupInOneFile() const
     return false;
 }
 
+void Script::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.emplace_back(START);
+}
+
 bool Script::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() >= START.size(), false, "");
@@ -35,6 +35,11 @@ bool XML::ShouldGroupInOneFile() const
     return false;
 }
 
+void XML::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.emplace_back(START);
+}
+
 bool XML::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() >= START.size(), false, "");
@@ -34,6 +34,11 @@ bool JPG::ShouldGroupInOneFile() const
     return false;
 }
 
+void JPG::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.push_back(MagicToTrigger(IMAGE_JPG_MAGIC_SOI));
+}
+
 bool JPG::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(IsMagicU16(precachedBuffer, IMAGE_JPG_MAGIC_SOI), false, "");
@@ -35,6 +35,11 @@ bool PNG::ShouldGroupInOneFile() const
     return false;
 }
 
+void PNG::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.push_back(MagicToTrigger(IMAGE_PNG_MAGIC));
+}
+
 bool PNG::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(IsMagicU64(precachedBuffer, IMAGE_PNG_MAGIC), false, "");
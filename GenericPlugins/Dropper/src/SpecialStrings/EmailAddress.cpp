@@ -30,6 +30,18 @@ Subcategory EmailAddress::GetSubcategory() const
     return Subcategory::Email;
 }
 
+void EmailAddress::GetTriggers(std::vector<std::string>& triggers) const
+{
+    for (char c = 'a'; c <= 'z'; c++) {
+        triggers.emplace_back(1, c);
+    }
+    for (char c = '0'; c <= '9'; c++) {
+        triggers.emplace_back(1, c);
+    }
+    triggers.emplace_back("_");
+    triggers.emplace_back(".");
+}
+
 bool EmailAddress::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
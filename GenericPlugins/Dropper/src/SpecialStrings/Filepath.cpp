@@ -32,6 +32,19 @@ Subcategory Filepath::GetSubcategory() const
     return Subcategory::Filepath;
 }
 
+void Filepath::GetTriggers(std::vector<std::string>& triggers) const
+{
+    // drive letter paths or paths starting with '/' or ".."
+    for (char c = 'a'; c <= 'z'; c++) {
+        triggers.emplace_back(1, c);
+    }
+    triggers.emplace_back("/");
+    triggers.emplace_back("..");
+    if (unicode) {
+        triggers.emplace_back(std::string_view{ ".\0.\0", 4 });
+    }
+}
+
 bool Filepath::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
@@ -32,6 +32,13 @@ Subcategory IpAddress::GetSubcategory() const
     return Subcategory::IP;
 }
 
+void IpAddress::GetTriggers(std::vector<std::string>& triggers) const
+{
+    for (char c = '0'; c <= '9'; c++) {
+        triggers.emplace_back(1, c);
+    }
+}
+
 bool IpAddress::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
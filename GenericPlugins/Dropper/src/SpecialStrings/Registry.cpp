@@ -34,6 +34,15 @@ Subcategory Registry::GetSubcategory() const
     return Subcategory::Registry;
 }
 
+void Registry::GetTriggers(std::vector<std::string>& triggers) const
+{
+    // every root key alternative starts with "HK"
+    triggers.emplace_back("HK");
+    if (unicode) {
+        triggers.emplace_back(std::string_view{ "H\0K\0", 4 });
+    }
+}
+
 bool Registry::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
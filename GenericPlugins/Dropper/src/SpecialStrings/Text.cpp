@@ -8,6 +8,7 @@ Text::Text(bool caseSensitive, bool unicode)
 {
     this->unicode       = unicode;
     this->caseSensitive = caseSensitive;
+    this->extractor.SetMask(this->stringsCharSetMatrix);
 }
 
 const std::string_view Text::GetName() const
@@ -25,62 +26,54 @@ Subcategory Text::GetSubcategory() const
     return Subcategory::Text;
 }
 
+void Text::GetTriggers(std::vector<std::string>& triggers) const
+{
+    // any printable character except space
+    for (char c = 0x21; c <= 0x7e; c++) {
+        triggers.emplace_back(1, c);
+    }
+}
+
 bool Text::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
     CHECK(IsAsciiPrintable(precachedBuffer.GetData()[0]), false, "");
     CHECK(precachedBuffer.GetData()[0] != ' ', false, "");
 
-    const auto isUnicode = precachedBuffer.GetData()[1] == 0;
+    const auto isUnicode = (precachedBuffer.GetLength() > 1) && (precachedBuffer.GetData()[1] == 0);
     if (isUnicode) {
         CHECK(unicode, false, "");
     }
 
-    auto buffer = file.Get(offset, file.GetCacheSize() / 12, false);
-    CHECK(buffer.GetLength() >= this->minLength * (isUnicode ? 2 : 1), false, "");
-
-    finding.start = offset;
-    finding.end   = offset;
-
-    uint64 i = 0;
-    while (finding.end - finding.start < this->maxLength) {
-        const auto c = buffer.GetData()[i];
-        CHECKBK(IsValidChar(c), "");
-
-        if (isUnicode && unicode) {
-            CHECKBK(buffer.GetData()[i + 1] == 0, "");
-            finding.end += 1;
-            i++;
+    // maxLength may be (uint32) -1 (no limit) and a read is clipped to the cache size => the string is measured one
+    // chunk at a time, until a character that is not part of it (or maxLength) is reached
+    const uint64 charSize  = isUnicode ? 2 : 1;
+    const uint64 maxChars  = isUnicode ? (static_cast<uint64>(this->maxLength) + 1) / 2 : static_cast<uint64>(this->maxLength);
+    const uint64 chunkSize = std::max<uint32>(file.GetCacheSize() & 0xFFFFFFFE, 2);
+
+    uint64 count = 0;
+    while (count < maxChars) {
+        const auto position = offset + count * charSize;
+        auto buffer         = file.Get(position, static_cast<uint32>(std::min<uint64>((maxChars - count) * charSize, chunkSize)), false);
+        if (buffer.GetLength() < charSize) {
+            break; // end of file
         }
-
-        finding.end += 1;
-        i++;
-
-        if (i + 1 >= buffer.GetLength()) {
-            offset += i + 1;
-            buffer = file.Get(offset, file.GetCacheSize() / 12, false);
-            if (buffer.GetLength() == 0) {
-                break;
-            }
-            i = 0;
+        const auto limit = static_cast<uint32>(std::min<uint64>(maxChars - count, 0xFFFFFFFF));
+        const auto chars = isUnicode ? extractor.GetUnicodeLength(buffer, limit) : extractor.GetAsciiLength(buffer, limit);
+        count += chars;
+        if (chars * charSize < (buffer.GetLength() & ~(charSize - 1))) {
+            break; // the string ends inside this chunk
         }
     }
 
-    CHECK(finding.start < finding.end, false, "");
-
-    if (isUnicode && unicode) {
-        if ((finding.end - finding.start) / 2 > this->minLength) {
-            finding.result = Result::Unicode;
-            return true;
-        }
-    } else {
-        if ((finding.end - finding.start) > this->minLength) {
-            finding.result = Result::Ascii;
-            return true;
-        }
+    finding.start = offset;
+    finding.end   = offset + count * charSize;
+    if (count > this->minLength) {
+        finding.result = isUnicode ? Result::Unicode : Result::Ascii;
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 bool Text::SetMaxLength(uint32 maxLength)
@@ -117,9 +110,10 @@ bool Text::SetUnicode(bool value)
 void Text::SetMatrix(bool matrix[STRINGS_CHARSET_MATRIX_SIZE])
 {
     memcpy(this->stringsCharSetMatrix, matrix, STRINGS_CHARSET_MATRIX_SIZE);
+    this->extractor.SetMask(this->stringsCharSetMatrix);
 }
 
-bool Text::IsValidChar(char c) const
+bool Text::IsValidChar(uint8 c) const
 {
     return this->stringsCharSetMatrix[c];
 }
@@ -32,6 +32,16 @@ Subcategory URL::GetSubcategory() const
     return Subcategory::URL;
 }
 
+void URL::GetTriggers(std::vector<std::string>& triggers) const
+{
+    triggers.emplace_back("http");
+    triggers.emplace_back("www");
+    if (unicode) {
+        triggers.emplace_back(std::string_view{ "h\0t\0t\0p\0", 8 });
+        triggers.emplace_back(std::string_view{ "w\0w\0w\0", 6 });
+    }
+}
+
 bool URL::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
@@ -45,6 +45,21 @@ Subcategory Wallet::GetSubcategory() const
     return Subcategory::Wallet;
 }
 
+void Wallet::GetTriggers(std::vector<std::string>& triggers) const
+{
+    for (const auto& [_, prefix] : WALLET_PREFIX) {
+        triggers.emplace_back(prefix);
+        if (unicode) {
+            std::string wide;
+            for (const auto c : prefix) {
+                wide.push_back(c);
+                wide.push_back(0);
+            }
+            triggers.push_back(std::move(wide));
+        }
+    }
+}
+
 bool Wallet::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, Finding& finding)
 {
     CHECK(precachedBuffer.GetLength() > 0, false, "");
@@ -95,18 +110,12 @@ bool Wallet::Check(uint64 offset, DataCache& file, BufferView precachedBuffer, F
 
     for (const auto& [k, v] : WALLET_PREFIX) {
         if (sMagic == v && length == WALLET_ADDRESS_LENGTH.at(k)) {
-            this->checkResult = k;
-            finding.result    = isUnicode ? Result::Unicode : Result::Ascii;
-            finding.details   = static_cast<uint32>(k);
+            finding.result  = isUnicode ? Result::Unicode : Result::Ascii;
+            finding.details = static_cast<uint32>(k); // the wallet type
             return true;
         }
     }
 
     return true;
 }
-
-WalletType Wallet::GetLastCheckResult() const
-{
-    return this->checkResult;
-}
 } // namespace GView::GenericPlugins::Droppper::SpecialStrings
@@ -0,0 +1,116 @@
+#include "TriggerScanner.hpp"
+
+#include <queue>
+
+namespace GView::GenericPlugins::Droppper
+{
+constexpr uint32 ALPHABET_SIZE = 256;
+
+static inline uint8 FoldCase(uint8 c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<uint8>(c | 0x20) : c;
+}
+
+bool TriggerScanner::Build(const std::vector<std::vector<std::string>>& triggers)
+{
+    transitions.clear();
+    outputsStart.clear();
+    outputs.clear();
+    unconditional.clear();
+    maxLength = 0;
+    state     = 0;
+
+    // trie (0 = no edge, root is state 0 so it can never be a target)
+    std::vector<uint32> next(ALPHABET_SIZE, 0);
+    std::vector<std::vector<Output>> stateOutputs(1);
+    for (uint32 dropper = 0; dropper < static_cast<uint32>(triggers.size()); dropper++) {
+        if (triggers[dropper].empty()) {
+            unconditional.push_back(dropper);
+            continue;
+        }
+        for (const auto& trigger : triggers[dropper]) {
+            CHECK(trigger.empty() == false, false, "");
+            uint32 current = 0;
+            for (const auto c : trigger) {
+                const auto edge = static_cast<size_t>(current) * ALPHABET_SIZE + FoldCase(static_cast<uint8>(c));
+                if (next[edge] == 0) {
+                    next[edge] = static_cast<uint32>(stateOutputs.size());
+                    stateOutputs.emplace_back();
+                    next.resize(next.size() + ALPHABET_SIZE, 0);
+                }
+                current = next[edge];
+            }
+            stateOutputs[current].push_back({ dropper, static_cast<uint32>(trigger.size()) });
+            maxLength = std::max<uint32>(maxLength, static_cast<uint32>(trigger.size()));
+        }
+    }
+
+    // BFS over the trie: resolve missing edges through the failure links and inherit the outputs of the failure state
+    const auto statesCount = static_cast<uint32>(stateOutputs.size());
+    std::vector<uint32> failure(statesCount, 0);
+    std::queue<uint32> pending;
+    for (uint32 c = 0; c < ALPHABET_SIZE; c++) {
+        if (next[c] != 0) {
+            pending.push(next[c]);
+        }
+    }
+    while (pending.empty() == false) {
+        const auto current = pending.front();
+        pending.pop();
+
+        const auto& inherited = stateOutputs[failure[current]];
+        stateOutputs[current].insert(stateOutputs[current].end(), inherited.begin(), inherited.end());
+
+        for (uint32 c = 0; c < ALPHABET_SIZE; c++) {
+            auto& edge          = next[static_cast<size_t>(current) * ALPHABET_SIZE + c];
+            const auto fallback = next[static_cast<size_t>(failure[current]) * ALPHABET_SIZE + c];
+            if (edge != 0) {
+                failure[edge] = fallback;
+                pending.push(edge);
+            } else {
+                edge = fallback;
+            }
+        }
+    }
+
+    // fold the case once here so the scan loop is a plain table walk
+    for (uint32 current = 0; current < statesCount; current++) {
+        for (uint32 c = 'A'; c <= 'Z'; c++) {
+            next[static_cast<size_t>(current) * ALPHABET_SIZE + c] = next[static_cast<size_t>(current) * ALPHABET_SIZE + (c | 0x20)];
+        }
+    }
+
+    transitions = std::move(next);
+    outputsStart.reserve(statesCount + 1);
+    for (const auto& o : stateOutputs) {
+        outputsStart.push_back(static_cast<uint32>(outputs.size()));
+        outputs.insert(outputs.end(), o.begin(), o.end());
+    }
+    outputsStart.push_back(static_cast<uint32>(outputs.size()));
+
+    return true;
+}
+
+void TriggerScanner::Reset()
+{
+    state = 0;
+}
+
+void TriggerScanner::Scan(BufferView buffer, uint64 offset, std::vector<Candidate>& candidates)
+{
+    CHECKRET(transitions.empty() == false, "");
+
+    auto current     = state;
+    const auto* data = buffer.GetData();
+    const auto size  = buffer.GetLength();
+    for (size_t i = 0; i < size; i++) {
+        current          = transitions[static_cast<size_t>(current) * ALPHABET_SIZE + data[i]];
+        const auto first = outputsStart[current];
+        const auto last  = outputsStart[current + 1];
+        for (auto o = first; o < last; o++) {
+            candidates.push_back({ offset + i + 1 - outputs[o].length, outputs[o].dropper });
+        }
+    }
+    state = current;
+}
+} // namespace GView::GenericPlugins::Droppper
@@ -2,6 +2,10 @@
 
 #include "GView.hpp"
 
+#include <atomic>
+#include <future>
+#include <memory>
+
 namespace GView::GenericPlugins::EntropyVisualizer
 {
 static const SpecialChars BLOCK_SPECIAL_CHARACTER                   = SpecialChars::Block75;
@@ -17,6 +21,10 @@ static const uint32 EMBEDDED_OBJECTS_MAX_VALUE                      = 6;
 static const uint32 EMBEDDED_OBJECTS_LEGEND_HEIGHT                  = 12 + 8;
 static const std::string_view EMBEDDED_OBJECTS_OPTION_NAME          = "Embedded Objects";
 static const uint32 MINIMUM_BLOCK_SIZE                              = 4;
+static const uint32 SLIDING_WINDOW_MAX_BLOCK_SIZE                   = 0x100000;
+static const uint32 PYRAMID_BASE_BLOCK_SIZE                         = 256;
+static const uint64 PYRAMID_MAX_BASE_BLOCKS                         = 0x400000;
+static const uint32 PYRAMID_MAX_CACHED_OBJECTS                      = 4;
 
 static const uint32 COMBO_BOX_ITEM_SHANNON_ENTROPY           = 0;
 static const uint32 COMBO_BOX_ITEM_RENYI_ENTROPY             = 1;
@@ -29,6 +37,58 @@ enum class EntropyType {
   Renyi = 2
 };
 
+// entropy of the object computed once for blocks of 256 bytes and then for 2x larger blocks (merged histograms) up to
+// a single block - drawing with one of these block sizes is just a read of a level. Computed in background for files,
+// kept per object, so reopening the visualizer or changing the block size does not read the object again.
+class EntropyPyramid
+{
+  public:
+    struct Level {
+        uint64 blockSize{ 0 };
+        uint64 blocksCount{ 0 };
+        std::vector<float> shannon;
+        std::vector<float> renyi; // empty if the pyramid was not requested with Renyi entropy
+        std::atomic<uint64> ready{ 0 }; // blocks [0, ready) are computed
+    };
+
+  private:
+    std::vector<std::unique_ptr<Level>> levels;
+    uint64 size{ 0 };
+    double renyiAlpha{ 0.0 };
+    bool hasRenyi{ false };
+    std::atomic<bool> cancelled{ false };
+    std::atomic<bool> completed{ false };
+    std::future<void> task;
+
+    bool Compute(GView::Utils::DataCache& cache);
+
+  public:
+    EntropyPyramid(uint64 size, double renyiAlpha, bool hasRenyi);
+    ~EntropyPyramid();
+
+    // returns the (possibly still computing) pyramid of the object; renyiAlpha matters only if needRenyi is set
+    static std::shared_ptr<EntropyPyramid> Get(Reference<Object> object, double renyiAlpha, bool needRenyi);
+
+    void Cancel();
+    inline bool IsCompleted() const
+    {
+        return completed;
+    }
+    inline bool IsCancelled() const
+    {
+        return cancelled;
+    }
+    inline double GetRenyiAlpha() const
+    {
+        return renyiAlpha;
+    }
+    inline bool HasRenyi() const
+    {
+        return hasRenyi;
+    }
+    const Level* GetLevel(uint64 blockSize) const;
+};
+
 class Plugin : public Window
 {
   private:
@@ -43,9 +103,16 @@ class Plugin : public Window
 
     Reference<NumericSelector> alphaSelector;
 
-    uint32 blockSize  = MINIMUM_BLOCK_SIZE;
+    uint32 blockSize  = PYRAMID_BASE_BLOCK_SIZE;
     double renyiAlpha = 0.5;
 
+    std::shared_ptr<EntropyPyramid> pyramid;
+
+    // the level of the pyramid being drawn while it is computed in background => the blocks are drawn as they become ready
+    const EntropyPyramid::Level* streamedLevel = nullptr;
+    EntropyType streamedType                   = EntropyType::Shannon;
+    uint64 streamedBlocks                      = 0; // blocks [0, streamedBlocks) of the level are drawn
+
   private:
     void ResizeLegendCanvas();
     static Color ShannonEntropyValueToColor(int32 value);
@@ -54,9 +121,12 @@ class Plugin : public Window
     static double ComputeEpsilon(uint64 size);
     static Color EmbeddedObjectValueToColor(std::string_view name);
     bool InitializeBlocksForCanvas();
+    void DrawEntropyBlock(uint64 index, EntropyType type, double value, double epsilon);
+    bool DrawReadyBlocks();
 
   public:
     Plugin(Reference<Object> object);
+    ~Plugin();
 
     bool DrawEntropy(EntropyType type);
     bool DrawEntropyLegend(EntropyType type);
@@ -65,6 +135,7 @@ class Plugin : public Window
     bool DrawEmbeddedObjectsLegend();
     std::optional<GView::Utils::Zone> IsOffsetInZone(const GView::Utils::ZonesList& zones, uint64 offset) const;
 
+    virtual void Paint(Graphics::Renderer& renderer) override;
     virtual void OnAfterResize(int newWidth, int newHeight) override;
     bool OnEvent(Reference<Control> sender, Event eventType, int controlID) override;
 };
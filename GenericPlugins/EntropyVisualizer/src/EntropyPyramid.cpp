@@ -0,0 +1,176 @@
+#include "EntropyVisualizer.hpp"
+
+#include <filesystem>
+
+namespace GView::GenericPlugins::EntropyVisualizer
+{
+namespace
+{
+    struct CachedPyramid {
+        const GView::Utils::DataCache* key; // the object that owns the cache
+        uint64 size;
+        std::u16string path;
+        std::shared_ptr<EntropyPyramid> pyramid;
+    };
+    std::vector<CachedPyramid> cachedPyramids; // most recently used last (UI thread only)
+} // namespace
+
+EntropyPyramid::EntropyPyramid(uint64 size, double renyiAlpha, bool hasRenyi) : size(size), renyiAlpha(renyiAlpha), hasRenyi(hasRenyi)
+{
+    // keep the number of base blocks (and the memory of the levels) bounded for very large objects
+    uint64 baseBlockSize = PYRAMID_BASE_BLOCK_SIZE;
+    while (size / baseBlockSize > PYRAMID_MAX_BASE_BLOCKS) {
+        baseBlockSize <<= 1;
+    }
+
+    for (auto blockSize = baseBlockSize;; blockSize <<= 1) {
+        auto level         = std::make_unique<Level>();
+        level->blockSize   = blockSize;
+        level->blocksCount = (size + blockSize - 1) / blockSize;
+        level->shannon.resize(level->blocksCount);
+        if (hasRenyi) {
+            level->renyi.resize(level->blocksCount);
+        }
+        levels.push_back(std::move(level));
+        if (blockSize >= size) {
+            break;
+        }
+    }
+}
+
+EntropyPyramid::~EntropyPyramid()
+{
+    Cancel();
+}
+
+void EntropyPyramid::Cancel()
+{
+    cancelled = true;
+    if (task.valid()) {
+        task.wait();
+    }
+}
+
+const EntropyPyramid::Level* EntropyPyramid::GetLevel(uint64 blockSize) const
+{
+    for (const auto& level : levels) {
+        if (level->blockSize == blockSize) {
+            return level.get();
+        }
+    }
+    return nullptr;
+}
+
+bool EntropyPyramid::Compute(GView::Utils::DataCache& cache)
+{
+    std::vector<GView::Entropy::Histogram> parents(levels.size()); // the first half of the next block of each level
+    std::vector<uint64> computed(levels.size(), 0);
+
+    // a block of a level is published as soon as it is complete; it is merged into its parent, and the parent is
+    // complete after its second child (or after the last block of the level)
+    const auto publish = [&](GView::Entropy::Histogram histogram) {
+        for (size_t idx = 0; idx < levels.size(); idx++) {
+            auto& level          = *levels[idx];
+            const auto index     = computed[idx]++;
+            level.shannon[index] = static_cast<float>(histogram.ShannonEntropy());
+            if (hasRenyi) {
+                level.renyi[index] = static_cast<float>(histogram.RenyiEntropy(renyiAlpha));
+            }
+            level.ready.store(index + 1, std::memory_order_release);
+
+            if (idx + 1 == levels.size()) {
+                break;
+            }
+            auto& parent = parents[idx + 1];
+            parent.Add(histogram);
+            if (((index & 1) == 0) && (index + 1 < level.blocksCount)) {
+                break;
+            }
+            histogram = parent;
+            parent.Reset();
+        }
+    };
+
+    const auto baseBlockSize = levels[0]->blockSize;
+    const auto chunkSize     = std::max<uint32>(cache.GetCacheSize(), 1);
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+    GView::Entropy::Histogram block;
+
+    uint64 offset  = 0;
+    uint64 inBlock = 0;
+    while (offset < size) {
+        if (cancelled) {
+            return false;
+        }
+        auto bf = cache.Get(offset, static_cast<uint32>(std::min<uint64>(size - offset, chunkSize)), false);
+        CHECK(bf.IsValid() && bf.GetLength() > 0, false, "Fail to read data from offset %llu", offset);
+
+        for (uint32 i = 0; i < bf.GetLength();) {
+            const auto count = static_cast<uint32>(std::min<uint64>(bf.GetLength() - i, baseBlockSize - inBlock));
+            block.Add(BufferView(bf.GetData() + i, count));
+            i += count;
+            inBlock += count;
+            if (inBlock == baseBlockSize) {
+                publish(block);
+                block.Reset();
+                inBlock = 0;
+            }
+        }
+        offset += bf.GetLength();
+    }
+    if (inBlock > 0) {
+        publish(block);
+    }
+
+    completed = true;
+    return true;
+}
+
+std::shared_ptr<EntropyPyramid> EntropyPyramid::Get(Reference<Object> object, double renyiAlpha, bool needRenyi)
+{
+    auto& cache     = object->GetData();
+    const auto size = cache.GetSize();
+    const std::u16string path{ object->GetPath() };
+
+    for (auto it = cachedPyramids.begin(); it != cachedPyramids.end(); it++) {
+        if (it->key != &cache) {
+            continue;
+        }
+        auto entry = std::move(*it);
+        cachedPyramids.erase(it);
+        // a cancelled pyramid is incomplete, and the Renyi values (if computed) depend on alpha
+        if ((entry.size == size) && (entry.path == path) && (entry.pyramid->IsCancelled() == false) &&
+            ((needRenyi == false) || (entry.pyramid->HasRenyi() && entry.pyramid->GetRenyiAlpha() == renyiAlpha))) {
+            cachedPyramids.push_back(std::move(entry));
+            return cachedPyramids.back().pyramid;
+        }
+        entry.pyramid->Cancel();
+        break;
+    }
+
+    auto pyramid = std::make_shared<EntropyPyramid>(size, renyiAlpha, needRenyi);
+
+    // the object's cache is used by the UI => the background task reads the file through its own cache
+    auto started = false;
+    if (object->GetObjectType() == Object::Type::File) {
+        const std::filesystem::path filePath{ path };
+        auto file = std::make_unique<AppCUI::OS::File>();
+        GView::Utils::DataCache workerCache;
+        if (file->OpenRead(filePath) && workerCache.Init(std::move(file), cache.GetCacheSize(), filePath)) {
+            pyramid->task = std::async(std::launch::async, [p = pyramid.get(), c = std::move(workerCache)]() mutable { p->Compute(c); });
+            started       = true;
+        }
+    }
+    if (started == false) {
+        // memory buffers / processes: compute it now (only once, it is kept for the next requests)
+        pyramid->Compute(cache);
+    }
+
+    cachedPyramids.push_back({ &cache, size, path, pyramid });
+    if (cachedPyramids.size() > PYRAMID_MAX_CACHED_OBJECTS) {
+        cachedPyramids.front().pyramid->Cancel();
+        cachedPyramids.erase(cachedPyramids.begin());
+    }
+    return pyramid;
+}
+} // namespace GView::GenericPlugins::EntropyVisualizer
@@ -111,7 +111,8 @@ Plugin::Plugin(Reference<Object> object) : Window("Entropy Visualizer", "d:c,w:1
     }
     {
         Factory::Label::Create(this, "Block size", "x:81%,y:3,w:19%,h:1");
-        this->blockSizeSelector = Factory::NumericSelector::Create(this, MINIMUM_BLOCK_SIZE, object->GetData().GetSize(), 32, "x:81%,y:4,w:19%,h:1");
+        this->blockSizeSelector =
+              Factory::NumericSelector::Create(this, MINIMUM_BLOCK_SIZE, object->GetData().GetSize(), this->blockSize, "x:81%,y:4,w:19%,h:1");
         blockSizeSelector->SetHotKey('B');
     }
     {
@@ -132,57 +133,127 @@ Plugin::Plugin(Reference<Object> object) : Window("Entropy Visualizer", "d:c,w:1
     this->canvasEntropy->SetFocus();
 }
 
+Plugin::~Plugin()
+{
+    // an incomplete pyramid is not worth finishing once the window is closed
+    if (this->pyramid && this->pyramid->IsCompleted() == false) {
+        this->pyramid->Cancel();
+    }
+}
+
+void Plugin::DrawEntropyBlock(uint64 index, EntropyType type, double value, double epsilon)
+{
+    auto canvas = this->canvasEntropy->GetCanvas();
+    auto fColor = Color::Black;
+    switch (type) {
+    case EntropyType::Shannon:
+    case EntropyType::Renyi:
+        fColor = ShannonEntropyValueToColor(static_cast<uint32>(std::llround(value)));
+        break;
+    case EntropyType::ShannonDataType:
+        fColor = ShannonEntropyDataTypeValueToColor(value, epsilon);
+    default:
+        break;
+    }
+
+    const auto maxX = std::max<uint32>(canvas->GetWidth(), 1);
+    canvas->WriteSpecialCharacter(
+          static_cast<int32>(index % maxX), static_cast<int32>(index / maxX), BLOCK_SPECIAL_CHARACTER, ColorPair{ fColor, CANVAS_ENTROPY_BACKGROUND });
+}
+
+bool Plugin::DrawReadyBlocks()
+{
+    CHECK(this->streamedLevel, false, "");
+    const auto level   = this->streamedLevel;
+    const auto ready   = level->ready.load(std::memory_order_acquire);
+    const auto epsilon = ComputeEpsilon(this->blockSize);
+    for (; this->streamedBlocks < ready; this->streamedBlocks++) {
+        const auto i = this->streamedBlocks;
+        DrawEntropyBlock(i, this->streamedType, this->streamedType == EntropyType::Renyi ? level->renyi[i] : level->shannon[i], epsilon);
+    }
+    if ((ready == level->blocksCount) || this->pyramid->IsCancelled()) {
+        // blocks that could not be computed (read errors / cancelled) keep the placeholder
+        if ((ready == level->blocksCount) && (object->GetData().GetSize() % this->blockSize == 0)) {
+            DrawEntropyBlock(ready, this->streamedType, 0.0, epsilon); // same trailing (empty) block as the direct computation
+        }
+        this->streamedLevel = nullptr;
+    }
+    return true;
+}
+
 bool Plugin::DrawEntropy(EntropyType type)
 {
     CHECK(this->canvasEntropy.IsValid(), false, "");
-    auto canvas = this->canvasEntropy->GetCanvas();
+    auto canvas         = this->canvasEntropy->GetCanvas();
+    this->streamedLevel = nullptr;
 
     auto& cache              = object->GetData();
     const auto size          = cache.GetSize();
     const auto epsilon       = ComputeEpsilon(this->blockSize);
     const uint32 blocksCount = static_cast<uint32>(size / this->blockSize + 1);
 
-    uint32 x         = 0;
-    uint32 y         = 0;
     uint32 maxX      = canvas->GetWidth();
     uint32 maxY      = std::max<uint32>(blocksCount / maxX + 1 + 1, canvas->GetHeight());
     const auto color = ColorPair{ Color::White, this->GetConfig()->Window.Background.Normal };
     canvas->Resize(maxX, maxY, 'X', color);
     canvas->ClearEntireSurface('X', color);
 
-    for (uint32 i = 0; i < blocksCount; i++) {
-        auto bf    = cache.Get(i * static_cast<uint64>(this->blockSize), this->blockSize, false);
-        auto value = 0.0;
-        switch (type) {
-        case EntropyType::Shannon:
-        case EntropyType::ShannonDataType:
-            value = GView::Entropy::ShannonEntropy(bf);
-            break;
-        case EntropyType::Renyi:
-            value = GView::Entropy::RenyiEntropy(bf, this->renyiAlpha);
-        default:
-            break;
-        }
-
-        auto fColor = Color::Black;
-        switch (type) {
-        case EntropyType::Shannon:
-        case EntropyType::Renyi:
-            fColor = ShannonEntropyValueToColor(static_cast<uint32>(std::llround(value)));
-            break;
-        case EntropyType::ShannonDataType:
-            fColor = ShannonEntropyDataTypeValueToColor(value, epsilon);
-        default:
-            break;
-        }
+    // block sizes of the pyramid are just read: the blocks computed so far are drawn now and the rest (placeholders for now)
+    // on the next paints, as the background computation progresses. Closing the window cancels an incomplete computation.
+    this->pyramid = EntropyPyramid::Get(this->object, this->renyiAlpha, type == EntropyType::Renyi);
+    if (const auto level = this->pyramid->GetLevel(this->blockSize)) {
+        this->streamedLevel  = level;
+        this->streamedType   = type;
+        this->streamedBlocks = 0;
+        return DrawReadyBlocks();
+    }
 
-        canvas->WriteSpecialCharacter(x++, y, BLOCK_SPECIAL_CHARACTER, ColorPair{ fColor, CANVAS_ENTROPY_BACKGROUND });
-        if (x == maxX) {
-            x = 0;
-            y++;
+    uint64 blockIndex    = 0;
+    const auto drawBlock = [&](double value) { DrawEntropyBlock(blockIndex++, type, value, epsilon); };
+
+    // small blocks: the window is as large as a block => once a block was pushed, the window holds exactly that block and
+    // both entropies are available in O(1) (no per block histogram reset / scan). Large blocks and the last (partial)
+    // block are counted with a histogram.
+    const auto lastBlockStart = size - size % this->blockSize;
+    const auto useWindow      = this->blockSize <= SLIDING_WINDOW_MAX_BLOCK_SIZE;
+    GView::Entropy::SlidingWindow window(useWindow ? this->blockSize : 1, this->renyiAlpha);
+    GView::Entropy::Histogram histogram;
+
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+    const auto chunkSize = std::max<uint32>(cache.GetCacheSize(), 1);
+
+    uint64 offset  = 0;
+    uint32 inBlock = 0;
+    while (offset < size) {
+        auto bf = cache.Get(offset, static_cast<uint32>(std::min<uint64>(size - offset, chunkSize)), false);
+        CHECK(bf.IsValid() && bf.GetLength() > 0, false, "Fail to read data from offset %llu", offset);
+
+        for (uint32 i = 0; i < bf.GetLength();) {
+            const auto count = std::min<uint32>(static_cast<uint32>(bf.GetLength()) - i, this->blockSize - inBlock);
+            const auto block = BufferView(bf.GetData() + i, count);
+            if (useWindow && (offset + i < lastBlockStart)) {
+                window.Push(block);
+            } else {
+                histogram.Add(block);
+            }
+            i += count;
+            inBlock += count;
+            if (inBlock == this->blockSize) {
+                if (useWindow) {
+                    drawBlock(type == EntropyType::Renyi ? window.RenyiEntropy() : window.ShannonEntropy());
+                } else {
+                    drawBlock(type == EntropyType::Renyi ? histogram.RenyiEntropy(this->renyiAlpha) : histogram.ShannonEntropy());
+                    histogram.Reset();
+                }
+                inBlock = 0;
+            }
         }
+        offset += bf.GetLength();
     }
 
+    // last block (partial or empty)
+    drawBlock(type == EntropyType::Renyi ? histogram.RenyiEntropy(this->renyiAlpha) : histogram.ShannonEntropy());
+
     return true;
 }
 
@@ -259,6 +330,7 @@ bool Plugin::DrawEntropyLegend(EntropyType type)
 bool Plugin::DrawEmbeddedObjects()
 {
     constexpr std::string_view VIEW_NAME{ "Buffer View" };
+    this->streamedLevel = nullptr;
 
     auto interface = this->parent.ToObjectRef<GView::View::WindowInterface>();
 
@@ -389,17 +461,16 @@ bool Plugin::DrawEmbeddedObjectsLegend()
 
 std::optional<GView::Utils::Zone> Plugin::IsOffsetInZone(const GView::Utils::ZonesList& zones, uint64 offset) const
 {
-    const auto zonesNo = zones.GetCount();
-    for (uint32 i = 0; i < zonesNo; i++) {
-        const auto zone = zones.GetZone(i);
-        if (zone.has_value()) {
-            if (offset >= zone->interval.low && offset <= zone->interval.high) {
-                return zone;
-            }
-        }
-    }
+    return zones.OffsetToZone(offset);
+}
 
-    return std::nullopt;
+void Plugin::Paint(Graphics::Renderer& renderer)
+{
+    // blocks of the pyramid computed (in background) since the last paint
+    if (this->streamedLevel) {
+        DrawReadyBlocks();
+    }
+    Window::Paint(renderer);
 }
 
 void Plugin::OnAfterResize(int, int)
@@ -476,7 +547,7 @@ bool Plugin::OnEvent(Reference<Control> sender, Event eventType, int controlID)
             this->blockSize = this->blockSizeSelector->GetValue();
             return drawSelectedEntropyType();
         } else if (sender == this->alphaSelector.ToBase<Control>()) {
-            this->renyiAlpha = this->alphaSelector->GetValue() / 10;
+            this->renyiAlpha = this->alphaSelector->GetValue() / 10.0;
             return drawSelectedEntropyType();
         }
         break;
@@ -4,6 +4,8 @@
 
 #include <any>
 #include <array>
+#include <atomic>
+#include <filesystem>
 #include <map>
 
 namespace GView::GenericPlugins::Hashes
@@ -106,7 +108,97 @@ class HashesDialog : public Window, public Handlers::OnButtonPressedInterface
     void SetSettingsFromFlags();
 };
 
-static bool ComputeHash(
+enum class ManifestChunking : uint8
+{
+    FixedSize,
+    ContentDefined
+};
+
+enum class ManifestFormat : uint8
+{
+    Binary,
+    JSON
+};
+
+// per-block digests of an object (with a single algorithm) - objects that share content share some of their digests
+class HashManifest
+{
+  public:
+    struct Chunk
+    {
+        uint64 offset;
+        uint32 size;
+    };
+
+  private:
+    struct HashingState
+    {
+        std::vector<std::pair<size_t, size_t>> shards; // [first, last) chunk indexes
+        std::atomic<size_t> nextShard{ 0 };
+        std::atomic<uint64> hashed{ 0 };
+        std::atomic<bool> cancelled{ false };
+    };
+
+    Hashes algorithm;
+    ManifestChunking chunking;
+    uint32 blockSize; // the size of a block, or the average size of a content defined chunk
+    uint32 digestSize;
+    uint64 objectSize;
+    std::u16string objectPath;
+    std::vector<Chunk> chunks;
+    std::vector<uint8> digests; // 'digestSize' bytes for every chunk
+
+    bool SplitFixedSize();
+    bool SplitContentDefined(DataCache& cache);
+    bool HashShards(DataCache& cache, HashingState& state, uint64 progressBase, uint64 progressTotal);
+
+  public:
+    HashManifest(Hashes algorithm, ManifestChunking chunking, uint32 blockSize);
+
+    bool Compute(Reference<GView::Object> object);
+    std::vector<uint8> ToBinary() const;
+    std::string ToJSON() const;
+    bool Save(const std::filesystem::path& path, ManifestFormat format) const;
+
+    inline size_t GetChunksCount() const
+    {
+        return chunks.size();
+    }
+    inline const Chunk& GetChunk(size_t index) const
+    {
+        return chunks[index];
+    }
+    inline BufferView GetDigest(size_t index) const
+    {
+        return { digests.data() + index * digestSize, digestSize };
+    }
+
+    static std::string_view GetAlgorithmName(Hashes algorithm);
+    static uint32 GetDigestSize(Hashes algorithm);
+};
+
+class HashManifestDialog : public Window, public Handlers::OnButtonPressedInterface
+{
+  private:
+    Reference<GView::Object> object;
+
+    Reference<ComboBox> algorithms;
+    Reference<RadioBox> fixedSize;
+    Reference<RadioBox> contentDefined;
+    Reference<NumericSelector> blockSize;
+    Reference<RadioBox> binaryFormat;
+    Reference<RadioBox> jsonFormat;
+
+    Reference<Button> cancel;
+    Reference<Button> ok;
+
+  public:
+    HashManifestDialog(Reference<GView::Object> object);
+    void OnButtonPressed(Reference<Button> b) override;
+    bool OnEvent(Reference<Control> c, Event eventType, int id) override;
+};
+
+bool ComputeHash(
       std::map<std::string, std::string>& outputs,
       uint32 hashFlags,
       Reference<GView::Object> object,
@@ -0,0 +1,656 @@
+#include "Hashes.hpp"
+
+#include <bit>
+#include <future>
+#include <optional>
+#include <thread>
+
+namespace GView::GenericPlugins::Hashes
+{
+constexpr int32 CMD_BUTTON_OK     = 1;
+constexpr int32 CMD_BUTTON_CANCEL = 2;
+
+constexpr uint32 RADIO_GROUP_CHUNKING = 1;
+constexpr uint32 RADIO_GROUP_FORMAT   = 2;
+
+constexpr uint32 MANIFEST_MIN_BLOCK_SIZE     = 512;
+constexpr uint32 MANIFEST_MAX_BLOCK_SIZE     = 0x4000000; // 64 MB
+constexpr uint32 MANIFEST_DEFAULT_BLOCK_SIZE = 0x10000;   // 64 KB
+constexpr uint64 MANIFEST_SHARD_SIZE         = 0x400000;  // 4 MB - the unit of work of a hashing thread
+constexpr uint32 MANIFEST_MAX_WORKERS        = 8;
+constexpr uint32 MANIFEST_FORMAT_VERSION     = 1;
+constexpr char MANIFEST_MAGIC[4]             = { 'G', 'V', 'H', 'M' };
+
+// content defined chunks are between 1/4 and 8 times the average size
+constexpr uint32 CDC_MIN_SIZE_SHIFT = 2;
+constexpr uint32 CDC_MAX_SIZE_SHIFT = 3;
+
+// random values for the gear rolling hash - fixed (splitmix64 with a constant seed), so that the boundaries of the chunks
+// (and the manifests) can be compared between different runs and machines
+static constexpr auto GearTable = []() {
+    std::array<uint64, 256> table{};
+    uint64 state = 0x4756696577434443ULL;
+    for (auto& value : table)
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+        auto z = state;
+        z      = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z      = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        value  = z ^ (z >> 31);
+    }
+    return table;
+}();
+
+static std::optional<OpenSSLHashKind> GetOpenSSLKind(Hashes algorithm)
+{
+    switch (algorithm)
+    {
+    case Hashes::MD5:
+        return OpenSSLHashKind::Md5;
+    case Hashes::BLAKE2S256:
+        return OpenSSLHashKind::Blake2s256;
+    case Hashes::BLAKE2B512:
+        return OpenSSLHashKind::Blake2b512;
+    case Hashes::SHA1:
+        return OpenSSLHashKind::Sha1;
+    case Hashes::SHA224:
+        return OpenSSLHashKind::Sha224;
+    case Hashes::SHA256:
+        return OpenSSLHashKind::Sha256;
+    case Hashes::SHA384:
+        return OpenSSLHashKind::Sha384;
+    case Hashes::SHA512:
+        return OpenSSLHashKind::Sha512;
+    case Hashes::SHA512_224:
+        return OpenSSLHashKind::Sha512_224;
+    case Hashes::SHA512_256:
+        return OpenSSLHashKind::Sha512_256;
+    case Hashes::SHA3_224:
+        return OpenSSLHashKind::Sha3_224;
+    case Hashes::SHA3_256:
+        return OpenSSLHashKind::Sha3_256;
+    case Hashes::SHA3_384:
+        return OpenSSLHashKind::Sha3_384;
+    case Hashes::SHA3_512:
+        return OpenSSLHashKind::Sha3_512;
+    case Hashes::SHAKE128:
+        return OpenSSLHashKind::Shake128;
+    case Hashes::SHAKE256:
+        return OpenSSLHashKind::Shake256;
+    default:
+        return std::nullopt;
+    }
+}
+
+// the digest of a single chunk (the checksums are written big endian - the same digits as their hex values)
+class ChunkHasher
+{
+    Hashes algorithm;
+    Adler32 adler32{};
+    CRC16 crc16{};
+    CRC32 crc32{};
+    CRC64 crc64{};
+    std::unique_ptr<OpenSSLHash> openssl;
+
+    static void WriteBigEndian(uint64 value, uint8* digest, uint32 size)
+    {
+        for (uint32 idx = 0; idx < size; idx++)
+        {
+            digest[idx] = static_cast<uint8>(value >> ((size - 1 - idx) * 8));
+        }
+    }
+
+  public:
+    ChunkHasher(Hashes algorithm) : algorithm(algorithm)
+    {
+    }
+
+    bool Init()
+    {
+        switch (algorithm)
+        {
+        case Hashes::Adler32:
+            return adler32.Init();
+        case Hashes::CRC16:
+            return crc16.Init();
+        case Hashes::CRC32_JAMCRC_0:
+            return crc32.Init(CRC32Type::JAMCRC_0);
+        case Hashes::CRC32_JAMCRC:
+            return crc32.Init(CRC32Type::JAMCRC);
+        case Hashes::CRC64_ECMA_182:
+            return crc64.Init(CRC64Type::ECMA_182);
+        case Hashes::CRC64_WE:
+            return crc64.Init(CRC64Type::WE);
+        default:
+            break;
+        }
+        const auto kind = GetOpenSSLKind(algorithm);
+        CHECK(kind.has_value(), false, "Unknown hash algorithm: 0x%X", static_cast<uint32>(algorithm));
+        openssl = std::make_unique<OpenSSLHash>(*kind);
+        return true;
+    }
+
+    bool Update(const BufferView& buffer)
+    {
+        switch (algorithm)
+        {
+        case Hashes::Adler32:
+            return adler32.Update(buffer);
+        case Hashes::CRC16:
+            return crc16.Update(buffer);
+        case Hashes::CRC32_JAMCRC_0:
+        case Hashes::CRC32_JAMCRC:
+            return crc32.Update(buffer);
+        case Hashes::CRC64_ECMA_182:
+        case Hashes::CRC64_WE:
+            return crc64.Update(buffer);
+        default:
+            return openssl->Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength()));
+        }
+    }
+
+    // 'digest' has room for GetDigestSize(algorithm) bytes
+    bool Final(uint8* digest, uint32 size)
+    {
+        switch (algorithm)
+        {
+        case Hashes::Adler32:
+        {
+            uint32 value = 0;
+            CHECK(adler32.Final(value), false, "");
+            WriteBigEndian(value, digest, size);
+            return true;
+        }
+        case Hashes::CRC16:
+        {
+            uint16 value = 0;
+            CHECK(crc16.Final(value), false, "");
+            WriteBigEndian(value, digest, size);
+            return true;
+        }
+        case Hashes::CRC32_JAMCRC_0:
+        case Hashes::CRC32_JAMCRC:
+        {
+            uint32 value = 0;
+            CHECK(crc32.Final(value), false, "");
+            WriteBigEndian(value, digest, size);
+            return true;
+        }
+        case Hashes::CRC64_ECMA_182:
+        case Hashes::CRC64_WE:
+        {
+            uint64 value = 0;
+            CHECK(crc64.Final(value), false, "");
+            WriteBigEndian(value, digest, size);
+            return true;
+        }
+        default:
+            CHECK(openssl->Final(), false, "");
+            CHECK(openssl->GetSize() == size, false, "");
+            memcpy(digest, openssl->Get(), size);
+            return true;
+        }
+    }
+};
+
+std::string_view HashManifest::GetAlgorithmName(Hashes algorithm)
+{
+    switch (algorithm)
+    {
+    case Hashes::Adler32:
+        return Adler32::GetName();
+    case Hashes::CRC16:
+        return CRC16::GetName();
+    case Hashes::CRC32_JAMCRC_0:
+        return CRC32::GetName(CRC32Type::JAMCRC_0);
+    case Hashes::CRC32_JAMCRC:
+        return CRC32::GetName(CRC32Type::JAMCRC);
+    case Hashes::CRC64_ECMA_182:
+        return CRC64::GetName(CRC64Type::ECMA_182);
+    case Hashes::CRC64_WE:
+        return CRC64::GetName(CRC64Type::WE);
+    case Hashes::MD5:
+        return "MD5";
+    case Hashes::BLAKE2S256:
+        return "BLAKE2S256";
+    case Hashes::BLAKE2B512:
+        return "BLAKE2B512";
+    case Hashes::SHA1:
+        return "SHA1";
+    case Hashes::SHA224:
+        return "SHA224";
+    case Hashes::SHA256:
+        return "SHA256";
+    case Hashes::SHA384:
+        return "SHA384";
+    case Hashes::SHA512:
+        return "SHA512";
+    case Hashes::SHA512_224:
+        return "SHA512_224";
+    case Hashes::SHA512_256:
+        return "SHA512_256";
+    case Hashes::SHA3_224:
+        return "SHA3_224";
+    case Hashes::SHA3_256:
+        return "SHA3_256";
+    case Hashes::SHA3_384:
+        return "SHA3_384";
+    case Hashes::SHA3_512:
+        return "SHA3_512";
+    case Hashes::SHAKE128:
+        return "SHAKE128";
+    case Hashes::SHAKE256:
+        return "SHAKE256";
+    default:
+        return "";
+    }
+}
+
+uint32 HashManifest::GetDigestSize(Hashes algorithm)
+{
+    switch (algorithm)
+    {
+    case Hashes::Adler32:
+        return Adler32::ResultBytesLength;
+    case Hashes::CRC16:
+        return sizeof(uint16);
+    case Hashes::CRC32_JAMCRC_0:
+    case Hashes::CRC32_JAMCRC:
+        return CRC32::ResultBytesLength;
+    case Hashes::CRC64_ECMA_182:
+    case Hashes::CRC64_WE:
+        return CRC64::ResultBytesLength;
+    default:
+        break;
+    }
+    const auto kind = GetOpenSSLKind(algorithm);
+    CHECK(kind.has_value(), 0, "Unknown hash algorithm: 0x%X", static_cast<uint32>(algorithm));
+    // the size of the digest of an empty input
+    OpenSSLHash hash(*kind);
+    CHECK(hash.Final(), 0, "");
+    return hash.GetSize();
+}
+
+HashManifest::HashManifest(Hashes algorithm, ManifestChunking chunking, uint32 blockSize)
+    : algorithm(algorithm), chunking(chunking), digestSize(0), objectSize(0)
+{
+    this->blockSize = std::clamp<uint32>(blockSize, MANIFEST_MIN_BLOCK_SIZE, MANIFEST_MAX_BLOCK_SIZE);
+    if (chunking == ManifestChunking::ContentDefined)
+    {
+        // the boundaries are found with a mask => the average size is a power of 2
+        this->blockSize = std::bit_floor(this->blockSize);
+    }
+}
+
+bool HashManifest::SplitFixedSize()
+{
+    chunks.reserve(static_cast<size_t>((objectSize + blockSize - 1) / blockSize));
+    for (uint64 offset = 0; offset < objectSize; offset += blockSize)
+    {
+        chunks.push_back({ offset, static_cast<uint32>(std::min<uint64>(blockSize, objectSize - offset)) });
+    }
+    return true;
+}
+
+/*
+    Gear based content defined chunking: hash = (hash << 1) + Gear[byte] depends only on the last 64 bytes, and a chunk
+    ends where the top log2(average) bits of the hash are 0 (but not before the minimum and not after the maximum size).
+    An insertion or a deletion only changes the chunks around it - the following boundaries are found again at the same
+    content, so most of the digests of two versions of a file are still the same.
+*/
+bool HashManifest::SplitContentDefined(DataCache& cache)
+{
+    const auto minSize = blockSize >> CDC_MIN_SIZE_SHIFT;
+    const auto maxSize = blockSize << CDC_MAX_SIZE_SHIFT;
+    const auto bits    = static_cast<uint32>(std::countr_zero(blockSize));
+    const auto mask    = ~(~0ULL >> bits);
+    const auto step    = std::max<uint32>(cache.GetCacheSize(), 1);
+
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+    LocalString<128> ls;
+
+    uint64 start = 0;
+    uint64 hash  = 0;
+    for (uint64 offset = 0; offset < objectSize;)
+    {
+        CHECK(ProgressStatus::Update(offset, ls.Format("Splitting [0x%llX/0x%llX] bytes...", offset, objectSize)) == false, false, "");
+        auto buffer = cache.Get(offset, static_cast<uint32>(std::min<uint64>(step, objectSize - offset)), false);
+        CHECK(buffer.IsValid() && buffer.GetLength() > 0, false, "Fail to read data from offset %llu", offset);
+
+        const auto* data = buffer.GetData();
+        for (size_t idx = 0; idx < buffer.GetLength(); idx++)
+        {
+            hash              = (hash << 1) + GearTable[data[idx]];
+            const auto length = offset + idx + 1 - start;
+            if ((length >= maxSize) || ((length >= minSize) && ((hash & mask) == 0)))
+            {
+                chunks.push_back({ start, static_cast<uint32>(length) });
+                start = offset + idx + 1;
+                hash  = 0;
+            }
+        }
+        offset += buffer.GetLength();
+    }
+    if (start < objectSize)
+    {
+        chunks.push_back({ start, static_cast<uint32>(objectSize - start) });
+    }
+    return true;
+}
+
+// hashes shards until there are none left; the progress is only reported (and can only be cancelled) on the UI thread
+bool HashManifest::HashShards(DataCache& cache, HashingState& state, uint64 progressBase, uint64 progressTotal)
+{
+    const auto step       = std::max<uint32>(cache.GetCacheSize(), 1);
+    const auto onUIThread = progressTotal > 0;
+    ChunkHasher hasher(algorithm);
+    LocalString<128> ls;
+
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+    for (auto shard = state.nextShard++; shard < state.shards.size(); shard = state.nextShard++)
+    {
+        for (auto index = state.shards[shard].first; index < state.shards[shard].second; index++)
+        {
+            if (state.cancelled)
+            {
+                return false;
+            }
+            if (onUIThread)
+            {
+                const auto done = progressBase + state.hashed;
+                if (ProgressStatus::Update(done, ls.Format("Hashing [0x%llX/0x%llX] bytes...", done, progressTotal)))
+                {
+                    state.cancelled = true;
+                    return false;
+                }
+            }
+
+            const auto& chunk = chunks[index];
+            CHECK(hasher.Init(), false, "");
+            for (uint64 offset = 0; offset < chunk.size;)
+            {
+                auto buffer = cache.Get(chunk.offset + offset, static_cast<uint32>(std::min<uint64>(step, chunk.size - offset)), true);
+                CHECK(buffer.IsValid(), false, "Fail to read data from offset %llu", chunk.offset + offset);
+                CHECK(hasher.Update(buffer), false, "");
+                offset += buffer.GetLength();
+            }
+            CHECK(hasher.Final(digests.data() + index * digestSize, digestSize), false, "");
+            state.hashed += chunk.size;
+        }
+    }
+    return true;
+}
+
+bool HashManifest::Compute(Reference<GView::Object> object)
+{
+    auto& cache = object->GetData();
+    objectSize  = cache.GetSize();
+    objectPath  = object->GetPath();
+    digestSize  = GetDigestSize(algorithm);
+    CHECK(digestSize > 0, false, "");
+    chunks.clear();
+
+    // content defined chunking reads the object twice (once to find the boundaries and once to hash the chunks)
+    const auto progressBase  = chunking == ManifestChunking::ContentDefined ? objectSize : 0;
+    const auto progressTotal = progressBase + objectSize;
+    ProgressStatus::Init("Hash manifest", progressTotal);
+
+    if (chunking == ManifestChunking::ContentDefined)
+    {
+        CHECK(SplitContentDefined(cache), false, "");
+    }
+    else
+    {
+        CHECK(SplitFixedSize(), false, "");
+    }
+    digests.resize(chunks.size() * digestSize);
+
+    // chunks are grouped in shards of a few MB (for small blocks, a thread per chunk would spend more time on scheduling)
+    HashingState state;
+    for (size_t first = 0; first < chunks.size();)
+    {
+        auto last   = first;
+        uint64 size = 0;
+        while ((last < chunks.size()) && (size < MANIFEST_SHARD_SIZE))
+        {
+            size += chunks[last++].size;
+        }
+        state.shards.emplace_back(first, last);
+        first = last;
+    }
+
+    const auto workersCount = std::min<uint32>(std::max<uint32>(std::thread::hardware_concurrency(), 1U), MANIFEST_MAX_WORKERS);
+    if ((object->GetObjectType() != Object::Type::File) || (workersCount < 2) || (state.shards.size() < 2))
+    {
+        return HashShards(cache, state, progressBase, progressTotal);
+    }
+
+    // DataCache is not thread safe => every worker reads the file through its own cache
+    std::vector<std::future<bool>> workers;
+    const std::filesystem::path path{ objectPath };
+    for (uint32 idx = 0; idx < std::min<size_t>(workersCount, state.shards.size()); idx++)
+    {
+        auto file = std::make_unique<AppCUI::OS::File>();
+        GView::Utils::DataCache workerCache;
+        if ((file->OpenRead(path) == false) || (workerCache.Init(std::move(file), cache.GetCacheSize(), path) == false))
+        {
+            break;
+        }
+        workers.push_back(std::async(
+              std::launch::async, [this, &state, c = std::move(workerCache)]() mutable { return HashShards(c, state, 0, 0); }));
+    }
+    if (workers.empty())
+    {
+        return HashShards(cache, state, progressBase, progressTotal);
+    }
+
+    LocalString<128> ls;
+    auto result = true;
+    for (auto& worker : workers)
+    {
+        while (worker.wait_for(std::chrono::milliseconds(100)) == std::future_status::timeout)
+        {
+            const auto done = progressBase + state.hashed;
+            if (ProgressStatus::Update(done, ls.Format("Hashing [0x%llX/0x%llX] bytes...", done, progressTotal)))
+            {
+                state.cancelled = true;
+            }
+        }
+        result &= worker.get();
+    }
+    // a worker that failed leaves its shard unfinished
+    return result && (state.cancelled == false);
+}
+
+/*
+    Binary format (little endian):
+    magic "GVHM" | version (uint16) | chunking (uint8) | digest size (uint8) | algorithm (uint32, Hashes flag)
+    | block size (uint32) | object size (uint64) | chunks count (uint64)
+    followed by every chunk: size (uint32) | digest - the chunks cover the object, so their offsets are not stored
+*/
+std::vector<uint8> HashManifest::ToBinary() const
+{
+    std::vector<uint8> output;
+    output.reserve(32 + chunks.size() * (sizeof(uint32) + digestSize));
+    const auto Write = [&output](uint64 value, uint32 size) {
+        for (uint32 idx = 0; idx < size; idx++)
+        {
+            output.push_back(static_cast<uint8>(value >> (idx * 8)));
+        }
+    };
+
+    output.insert(output.end(), std::begin(MANIFEST_MAGIC), std::end(MANIFEST_MAGIC));
+    Write(MANIFEST_FORMAT_VERSION, sizeof(uint16));
+    Write(static_cast<uint8>(chunking), sizeof(uint8));
+    Write(digestSize, sizeof(uint8));
+    Write(static_cast<uint32>(algorithm), sizeof(uint32));
+    Write(blockSize, sizeof(uint32));
+    Write(objectSize, sizeof(uint64));
+    Write(chunks.size(), sizeof(uint64));
+    for (size_t idx = 0; idx < chunks.size(); idx++)
+    {
+        Write(chunks[idx].size, sizeof(uint32));
+        const auto digest = GetDigest(idx);
+        output.insert(output.end(), digest.GetData(), digest.GetData() + digest.GetLength());
+    }
+    return output;
+}
+
+std::string HashManifest::ToJSON() const
+{
+    static constexpr char hexDigits[] = "0123456789ABCDEF";
+
+    std::string path;
+    const auto u8path = std::filesystem::path(objectPath).u8string();
+    for (const auto ch : u8path)
+    {
+        const auto c = static_cast<uint8>(ch);
+        if ((c == '"') || (c == '\\'))
+        {
+            path += '\\';
+            path += static_cast<char>(c);
+        }
+        else if (c < 0x20)
+        {
+            path += "\\u00";
+            path += hexDigits[c >> 4];
+            path += hexDigits[c & 0xF];
+        }
+        else
+        {
+            path += static_cast<char>(c);
+        }
+    }
+
+    LocalString<256> ls;
+    std::string output;
+    output.reserve(256 + path.size() + chunks.size() * (64 + digestSize * 2));
+    output += "{\n";
+    output += ls.Format("  \"object\": \"%s\",\n", path.c_str());
+    output += ls.Format("  \"size\": %llu,\n", objectSize);
+    output += ls.Format("  \"algorithm\": \"%s\",\n", std::string(GetAlgorithmName(algorithm)).c_str());
+    output += ls.Format("  \"chunking\": \"%s\",\n", chunking == ManifestChunking::ContentDefined ? "content-defined" : "fixed");
+    output += ls.Format("  \"blockSize\": %u,\n", blockSize);
+    output += "  \"chunks\": [";
+    for (size_t idx = 0; idx < chunks.size(); idx++)
+    {
+        output += ls.Format("%s\n    { \"offset\": %llu, \"size\": %u, \"digest\": \"", idx == 0 ? "" : ",", chunks[idx].offset, chunks[idx].size);
+        const auto digest = GetDigest(idx);
+        for (size_t pos = 0; pos < digest.GetLength(); pos++)
+        {
+            output += hexDigits[digest[pos] >> 4];
+            output += hexDigits[digest[pos] & 0xF];
+        }
+        output += "\" }";
+    }
+    output += chunks.empty() ? "]\n}\n" : "\n  ]\n}\n";
+    return output;
+}
+
+bool HashManifest::Save(const std::filesystem::path& path, ManifestFormat format) const
+{
+    if (format == ManifestFormat::JSON)
+    {
+        const auto json = ToJSON();
+        return AppCUI::OS::File::WriteContent(path, BufferView{ json.data(), json.size() });
+    }
+    const auto binary = ToBinary();
+    return AppCUI::OS::File::WriteContent(path, BufferView{ binary.data(), binary.size() });
+}
+
+HashManifestDialog::HashManifestDialog(Reference<GView::Object> object)
+    : Window("Hash manifest", "d:c,w:64,h:14", WindowFlags::ProcessReturn), object(object)
+{
+    Factory::Label::Create(this, "&Algorithm", "x:1,y:1,w:16");
+    algorithms = Factory::ComboBox::Create(this, "x:18,y:1,w:43", "");
+    algorithms->SetHotKey('A');
+    uint32 itemsCount = 0;
+    for (const auto& hash : hashList)
+    {
+        if (hash == Hashes::None)
+        {
+            continue;
+        }
+        algorithms->AddItem(HashManifest::GetAlgorithmName(hash), static_cast<uint64>(hash));
+        if (hash == Hashes::SHA256)
+        {
+            algorithms->SetCurentItemIndex(itemsCount);
+        }
+        itemsCount++;
+    }
+
+    fixedSize      = Factory::RadioBox::Create(this, "&Fixed size blocks", "x:1,y:3,w:28", RADIO_GROUP_CHUNKING);
+    contentDefined = Factory::RadioBox::Create(this, "Content &defined chunks", "x:30,y:3,w:31", RADIO_GROUP_CHUNKING);
+    fixedSize->SetChecked(true);
+
+    Factory::Label::Create(this, "Block &size", "x:1,y:5,w:16");
+    blockSize = Factory::NumericSelector::Create(
+          this, MANIFEST_MIN_BLOCK_SIZE, MANIFEST_MAX_BLOCK_SIZE, MANIFEST_DEFAULT_BLOCK_SIZE, "x:18,y:5,w:43");
+    blockSize->SetHotKey('S');
+    Factory::Label::Create(this, "(content defined: the average size, as a power of 2)", "x:1,y:6,w:61");
+
+    binaryFormat = Factory::RadioBox::Create(this, "&Binary manifest", "x:1,y:8,w:28", RADIO_GROUP_FORMAT);
+    jsonFormat   = Factory::RadioBox::Create(this, "&JSON manifest", "x:30,y:8,w:31", RADIO_GROUP_FORMAT);
+    jsonFormat->SetChecked(true);
+
+    ok                              = Factory::Button::Create(this, "&Ok", "x:25%,y:100%,a:b,w:12", CMD_BUTTON_OK);
+    ok->Handlers()->OnButtonPressed = this;
+    ok->SetFocus();
+
+    cancel                              = Factory::Button::Create(this, "&Cancel", "x:75%,y:100%,a:b,w:12", CMD_BUTTON_CANCEL);
+    cancel->Handlers()->OnButtonPressed = this;
+}
+
+void HashManifestDialog::OnButtonPressed(Reference<Button> b)
+{
+    if (b->GetControlID() != CMD_BUTTON_OK)
+    {
+        Exit();
+        return;
+    }
+
+    const auto algorithm = static_cast<Hashes>(algorithms->GetCurrentItemUserData(static_cast<uint64>(Hashes::SHA256)));
+    const auto chunking  = contentDefined->IsChecked() ? ManifestChunking::ContentDefined : ManifestChunking::FixedSize;
+    const auto format    = jsonFormat->IsChecked() ? ManifestFormat::JSON : ManifestFormat::Binary;
+
+    HashManifest manifest(algorithm, chunking, static_cast<uint32>(blockSize->GetValue()));
+    if (manifest.Compute(object) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error!", "Failed computing the hash manifest!");
+        return;
+    }
+
+    std::u16string name{ object->GetName() };
+    name += format == ManifestFormat::JSON ? u".manifest.json" : u".manifest.bin";
+    const auto path = Dialogs::FileDialog::ShowSaveFileWindow(name, "", "");
+    if (path.has_value() == false)
+    {
+        return;
+    }
+    if (manifest.Save(path.value(), format) == false)
+    {
+        Dialogs::MessageBox::ShowError("Error!", "Failed saving the hash manifest!");
+        return;
+    }
+
+    LocalString<128> ls;
+    Dialogs::MessageBox::ShowNotification("Hash manifest", ls.Format("Saved the digests of %llu blocks.", (uint64) manifest.GetChunksCount()));
+    Exit();
+}
+
+bool HashManifestDialog::OnEvent(Reference<Control> c, Event eventType, int id)
+{
+    if (Window::OnEvent(c, eventType, id))
+    {
+        return true;
+    }
+
+    if (eventType == Event::WindowAccept)
+    {
+        OnButtonPressed(ok);
+        return true;
+    }
+
+    return false;
+}
+} // namespace GView::GenericPlugins::Hashes
@@ -1,5 +1,10 @@
 #include "Hashes.hpp"
 
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+
 namespace GView::GenericPlugins::Hashes
 {
 constexpr int32 CMD_BUTTON_CLOSE  = 1;
@@ -9,10 +14,12 @@ constexpr int32 CMD_BUTTON_CANCEL = 3;
 constexpr std::string_view CMD_SHORT_NAME_HASHES         = "Hashes";
 constexpr std::string_view CMD_SHORT_NAME_COMPUTE_MD5    = "ComputeMD5";
 constexpr std::string_view CMD_SHORT_NAME_COMPUTE_SHA256 = "ComputeSHA256";
+constexpr std::string_view CMD_SHORT_NAME_HASH_MANIFEST  = "HashManifest";
 
 constexpr std::string_view CMD_FULL_NAME_HASHES         = "Command.Hashes";
 constexpr std::string_view CMD_FULL_NAME_COMPUTE_MD5    = "Command.ComputeMD5";
 constexpr std::string_view CMD_FULL_NAME_COMPUTE_SHA256 = "Command.ComputeSHA256";
+constexpr std::string_view CMD_FULL_NAME_HASH_MANIFEST  = "Command.HashManifest";
 
 constexpr std::string_view TYPES_ADLER32        = "Types.Adler32";
 constexpr std::string_view TYPES_CRC16          = "Types.CRC16";
@@ -37,6 +44,8 @@ constexpr std::string_view TYPES_SHA3_512       = "Types.SHA3_512";
 constexpr std::string_view TYPES_SHAKE128       = "Types.SHAKE128";
 constexpr std::string_view TYPES_SHAKE256       = "Types.SHAKE256";
 
+constexpr uint32 HASH_PIPELINE_SLOTS = 8;
+
 const uint32 widthPicking = 70;
 const uint32 widthShowing = 160;
 
@@ -591,7 +600,129 @@ void HashesDialog::SetSettingsFromFlags()
     allSettings->Save(Application::GetAppSettingsFile());
 }
 
-static bool ComputeHash(
+// The reader fills a ring of blocks, every lane (one per hash algorithm) consumes all the blocks, in order, on its own
+// thread. A block is read once and shared by all the lanes; its slot is reused only after the slowest lane is done with it.
+class HashPipeline
+{
+  public:
+    using Lane = std::function<bool(const BufferView& buffer)>;
+
+  private:
+    struct Slot
+    {
+        Buffer buffer;
+        size_t pendingLanes{ 0 };
+    };
+
+    std::vector<Slot> ring;
+    std::vector<Lane> lanes;
+    std::vector<std::future<bool>> workers;
+    std::mutex lock;
+    std::condition_variable slotReady;
+    std::condition_variable slotFree;
+    uint64 produced{ 0 };
+    bool finished{ false };
+    bool cancelled{ false };
+
+    bool RunLane(const Lane& lane)
+    {
+        for (uint64 sequence = 0;; sequence++)
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            slotReady.wait(guard, [&]() { return produced > sequence || finished || cancelled; });
+            if (cancelled)
+                return false;
+            if (produced <= sequence)
+                return true; // finished
+            auto& slot = ring[sequence % ring.size()];
+            guard.unlock();
+
+            const auto result = lane(BufferView{ slot.buffer.GetData(), slot.buffer.GetLength() });
+
+            guard.lock();
+            if (!result)
+                cancelled = true;
+            if (--slot.pendingLanes == 0 || cancelled)
+                slotFree.notify_all();
+            if (cancelled)
+            {
+                slotReady.notify_all();
+                return false;
+            }
+        }
+    }
+
+  public:
+    HashPipeline(uint32 slotsCount) : ring(slotsCount)
+    {
+    }
+    ~HashPipeline()
+    {
+        Cancel();
+    }
+
+    void AddLane(Lane lane)
+    {
+        lanes.push_back(std::move(lane));
+    }
+    void Start()
+    {
+        for (const auto& lane : lanes)
+            workers.push_back(std::async(std::launch::async, [this, &lane]() { return RunLane(lane); }));
+    }
+    bool IsRunning() const
+    {
+        return !workers.empty();
+    }
+
+    // the slot for the next block (waits for the lanes to release it); nullptr if a lane failed
+    Buffer* AcquireSlot()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        auto& slot = ring[produced % ring.size()];
+        slotFree.wait(guard, [&]() { return slot.pendingLanes == 0 || cancelled; });
+        return cancelled ? nullptr : &slot.buffer;
+    }
+    void Publish()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ring[produced % ring.size()].pendingLanes = lanes.size();
+            produced++;
+        }
+        slotReady.notify_all();
+    }
+
+    // no more blocks - waits for every lane to consume what was published
+    bool Finish()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            finished = true;
+        }
+        slotReady.notify_all();
+
+        auto result = true;
+        for (auto& worker : workers)
+            result &= worker.get();
+        workers.clear();
+        return result;
+    }
+    void Cancel()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            cancelled = true;
+        }
+        slotReady.notify_all();
+        slotFree.notify_all();
+        for (auto& worker : workers)
+            worker.wait();
+        workers.clear();
+    }
+};
+
+bool ComputeHash(
       std::map<std::string, std::string>& outputs,
       uint32 hashFlags,
       Reference<GView::Object> object,
@@ -683,81 +814,79 @@ static bool ComputeHash(
         }
     }
 
-    const auto UpdateHashOnBuffer = [&](const Buffer& buffer)
+    // each algorithm only touches its own state => different algorithms can be updated from different threads
+    const auto UpdateHash = [&](Hashes hash, const BufferView& buffer)
     {
-        for (const auto& hash : hashList)
+        switch (hash)
         {
-            switch (static_cast<Hashes>(hashFlags & static_cast<uint32>(hash)))
-            {
-            case Hashes::Adler32:
-                CHECK(adler32.Update(buffer), false, "");
-                break;
-            case Hashes::CRC16:
-                CHECK(crc16.Update(buffer), false, "");
-                break;
-            case Hashes::CRC32_JAMCRC_0:
-                CHECK(crc32JAMCRC0.Update(buffer), false, "");
-                break;
-            case Hashes::CRC32_JAMCRC:
-                CHECK(crc32JAMCRC.Update(buffer), false, "");
-                break;
-            case Hashes::CRC64_ECMA_182:
-                CHECK(crc64ECMA182.Update(buffer), false, "");
-                break;
-            case Hashes::CRC64_WE:
-                CHECK(crc64WE.Update(buffer), false, "");
-                break;
-            case Hashes::MD5:
-                CHECK(md5.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::BLAKE2S256:
-                CHECK(blake2s256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::BLAKE2B512:
-                CHECK(blake2b512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA1:
-                CHECK(sha1.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA224:
-                CHECK(sha224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA256:
-                CHECK(sha256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA384:
-                CHECK(sha384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512:
-                CHECK(sha512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512_224:
-                CHECK(sha512_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA512_256:
-                CHECK(sha512_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_224:
-                CHECK(sha3_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_256:
-                CHECK(sha3_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_384:
-                CHECK(sha3_384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHA3_512:
-                CHECK(sha3_512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHAKE128:
-                CHECK(shake128.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            case Hashes::SHAKE256:
-                CHECK(shake256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
-                break;
-            default:
-                break;
-            }
+        case Hashes::Adler32:
+            CHECK(adler32.Update(buffer), false, "");
+            break;
+        case Hashes::CRC16:
+            CHECK(crc16.Update(buffer), false, "");
+            break;
+        case Hashes::CRC32_JAMCRC_0:
+            CHECK(crc32JAMCRC0.Update(buffer), false, "");
+            break;
+        case Hashes::CRC32_JAMCRC:
+            CHECK(crc32JAMCRC.Update(buffer), false, "");
+            break;
+        case Hashes::CRC64_ECMA_182:
+            CHECK(crc64ECMA182.Update(buffer), false, "");
+            break;
+        case Hashes::CRC64_WE:
+            CHECK(crc64WE.Update(buffer), false, "");
+            break;
+        case Hashes::MD5:
+            CHECK(md5.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::BLAKE2S256:
+            CHECK(blake2s256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::BLAKE2B512:
+            CHECK(blake2b512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA1:
+            CHECK(sha1.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA224:
+            CHECK(sha224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA256:
+            CHECK(sha256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA384:
+            CHECK(sha384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA512:
+            CHECK(sha512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA512_224:
+            CHECK(sha512_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA512_256:
+            CHECK(sha512_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA3_224:
+            CHECK(sha3_224.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA3_256:
+            CHECK(sha3_256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA3_384:
+            CHECK(sha3_384.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHA3_512:
+            CHECK(sha3_512.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHAKE128:
+            CHECK(shake128.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        case Hashes::SHAKE256:
+            CHECK(shake256.Update(buffer.GetData(), static_cast<uint32>(buffer.GetLength())), false, "");
+            break;
+        default:
+            break;
         }
 
         return true;
@@ -771,7 +900,29 @@ static bool ComputeHash(
         format = "[0x%.16llX/0x%.16llX] bytes...";
     }
 
+    // the selected algorithms; with more than one, each of them runs on its own lane of a pipeline (the total time is
+    // closer to the slowest algorithm than to the sum of all of them)
+    std::vector<Hashes> selected;
+    for (const auto& hash : hashList)
+    {
+        if (hash != Hashes::None && (hashFlags & static_cast<uint32>(hash)) == static_cast<uint32>(hash))
+        {
+            selected.push_back(hash);
+        }
+    }
+
+    HashPipeline pipeline(HASH_PIPELINE_SLOTS);
+    if (selected.size() > 1)
+    {
+        for (const auto hash : selected)
+        {
+            pipeline.AddLane([&UpdateHash, hash](const BufferView& buffer) { return UpdateHash(hash, buffer); });
+        }
+        pipeline.Start();
+    }
+
     const auto block = object->GetData().GetCacheSize();
+    GView::Utils::DataCache::ReadAheadScope readAhead(object->GetData());
 
     const auto UpdateHashOnBlock = [&](uint64 offset, uint64 left)
     {
@@ -782,10 +933,27 @@ static bool ComputeHash(
             const auto sizeToRead = (left >= block ? block : left);
             left -= (left >= block ? block : left);
 
-            const Buffer buffer = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
-            CHECK(buffer.IsValid(), false, "");
+            if (pipeline.IsRunning())
+            {
+                // read the next block while the lanes are still busy with the previous ones
+                auto slot = pipeline.AcquireSlot();
+                CHECK(slot != nullptr, false, "");
 
-            CHECK(UpdateHashOnBuffer(buffer), false, "");
+                *slot = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
+                CHECK(slot->IsValid(), false, "");
+
+                pipeline.Publish();
+            }
+            else
+            {
+                const Buffer buffer = object->GetData().CopyToBuffer(offset, static_cast<uint32>(sizeToRead), true);
+                CHECK(buffer.IsValid(), false, "");
+
+                for (const auto hash : selected)
+                {
+                    CHECK(UpdateHash(hash, BufferView{ buffer.GetData(), buffer.GetLength() }), false, "");
+                }
+            }
 
             offset += sizeToRead;
         } while (left > 0);
@@ -809,6 +977,11 @@ static bool ComputeHash(
         }
     }
 
+    if (pipeline.IsRunning())
+    {
+        CHECK(pipeline.Finish(), false, "");
+    }
+
     NumericFormatter nf;
     for (const auto& hash : hashList)
     {
@@ -886,7 +1059,7 @@ static bool ComputeHash(
             outputs.emplace(std::pair{ "SHA3_384", sha3_384.GetHexValue() });
             break;
         case Hashes::SHA3_512:
-            sha3_384.Final();
+            sha3_512.Final();
             outputs.emplace(std::pair{ "SHA3_512", sha3_512.GetHexValue() });
             break;
         case Hashes::SHAKE128:
@@ -916,6 +1089,12 @@ extern "C"
             dlg.Show();
             return true;
         }
+        if (command == GView::GenericPlugins::Hashes::CMD_SHORT_NAME_HASH_MANIFEST)
+        {
+            GView::GenericPlugins::Hashes::HashManifestDialog dlg(object);
+            dlg.Show();
+            return true;
+        }
 
         std::vector<GView::TypeInterface::SelectionZone> selectedZones;
         for (auto i = 0U; i < object->GetContentType()->GetSelectionZonesCount(); i++)
@@ -981,6 +1160,7 @@ extern "C"
         sect[GView::GenericPlugins::Hashes::CMD_FULL_NAME_HASHES]         = Input::Key::Shift | Input::Key::F5;
         sect[GView::GenericPlugins::Hashes::CMD_FULL_NAME_COMPUTE_MD5]    = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F5;
         sect[GView::GenericPlugins::Hashes::CMD_FULL_NAME_COMPUTE_SHA256] = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F6;
+        sect[GView::GenericPlugins::Hashes::CMD_FULL_NAME_HASH_MANIFEST]  = Input::Key::Ctrl | Input::Key::Shift | Input::Key::F8;
 
         sect[GView::GenericPlugins::Hashes::TYPES_ADLER32]        = true;
         sect[GView::GenericPlugins::Hashes::TYPES_CRC16]          = true;
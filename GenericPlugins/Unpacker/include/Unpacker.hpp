@@ -28,6 +28,7 @@ class Plugin : public Window, public Handlers::OnButtonPressedInterface
     bool DecodeBase64(BufferView input, uint64 start, uint64 end);
     bool DecodeQuotedPrintable(BufferView input, uint64 start, uint64 end);
     bool DecodeZLib(BufferView input, uint64 start, uint64 end);
+    bool DecodeZLib(uint64 start, uint64 end);
 
     void OnButtonPressed(Reference<Button> button) override;
     bool OnEvent(Reference<Control> control, Event eventType, int32 id) override;
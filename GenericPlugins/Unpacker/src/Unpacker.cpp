@@ -73,8 +73,13 @@ void Plugin::OnButtonPressed(Reference<Button> button)
             DecodeQuotedPrintable(bv, start, end);
             break;
         case ITEM_ZLIB:
-            SetAreaToDecode(b, bv, start, end);
-            DecodeZLib(bv, start, end);
+            if (this->selectedZones.empty()) {
+                // stream it from the cache - the file might not fit in memory
+                DecodeZLib(start, end);
+            } else {
+                SetAreaToDecode(b, bv, start, end);
+                DecodeZLib(bv, start, end);
+            }
             break;
         case ITEM_INVALID:
         default:
@@ -246,6 +251,52 @@ bool Plugin::DecodeZLib(BufferView input, uint64 start, uint64 end)
     return !outputs.empty();
 }
 
+bool Plugin::DecodeZLib(uint64 start, uint64 end)
+{
+    struct Data {
+        Buffer buffer;
+        String name;
+        String path;
+    };
+
+    std::vector<Data> outputs;
+    String message;
+    uint64 sizeConsumed = 0;
+    auto& cache         = this->object->GetData();
+
+    do {
+        Buffer output;
+        if (GView::Decoding::ZLIB::DecompressStream(cache, start, end - start, output, message, sizeConsumed)) {
+            LocalString<128> name;
+            name.Format("Buffer_zlib_%llx_%llx", start, start + sizeConsumed);
+
+            start += sizeConsumed;
+
+            LocalUnicodeStringBuilder<2048> fullPath;
+            fullPath.Add(this->object->GetPath());
+            fullPath.AddChar((char16_t) std::filesystem::path::preferred_separator);
+            fullPath.Add(name);
+
+            std::string path;
+            fullPath.ToString(path);
+
+            Data data{ output, name, String{ path } };
+            outputs.emplace_back(data);
+        } else {
+            LocalString<256> title;
+            title.Format("Error for area %llx -> %llx!", start, end);
+            AppCUI::Dialogs::MessageBox::ShowError(title, message);
+            break;
+        }
+    } while (start < end && sizeConsumed > 0);
+
+    for (const auto& output : outputs) {
+        GView::App::OpenBuffer(output.buffer, output.name, output.path, GView::App::OpenMethod::BestMatch, "", this->parent);
+    }
+
+    return !outputs.empty();
+}
+
 extern "C" {
 PLUGIN_EXPORT bool Run(const string_view command, Reference<GView::Object> object)
 {
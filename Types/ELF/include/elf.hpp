@@ -82,7 +82,10 @@ class ELFFile : public TypeInterface, public GView::View::BufferViewer::OffsetTr
     bool ParseGoData();
     bool ParseSymbols();
 
+    bool IsIntelMachine() const;
     bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
+    bool GetColorsForRange(uint64 offset, uint64 size, BufferView buf, std::vector<GView::View::BufferViewer::BufferColor>& spans) override;
+    bool GetColorForOpcode(uint64 offset, BufferView buf, bool executable, GView::View::BufferViewer::BufferColor& result);
     bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
 
     uint64 TranslateToFileOffset(uint64 value, uint32 fromTranslationIndex) override;
@@ -102,6 +105,11 @@ class ELFFile : public TypeInterface, public GView::View::BufferViewer::OffsetTr
     void RunCommand(std::string_view) override
     {
     }
+    bool Analyze(std::vector<std::pair<std::string, std::string>>& properties) override;
+    bool IsAnalyzeSupported() const override
+    {
+        return true;
+    }
     virtual bool UpdateKeys(KeyboardControlsInterface* interface) override
     {
         return true;
@@ -578,14 +578,58 @@ bool ELFFile::GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View:
     return false;
 }
 
+bool ELFFile::IsIntelMachine() const
+{
+    switch (is64 ? header64.e_machine : header32.e_machine)
+    {
+    case EM_386:
+    case EM_486:
+    case EM_860:
+    case EM_960:
+    case EM_8051:
+    case EM_X86_64:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool ELFFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result)
 {
     CHECK(buf.IsValid(), false, "");
     result.color = ColorPair{ Color::Transparent, Color::Transparent };
     CHECK(showOpcodesMask != 0, false, "");
 
-    const auto machine = is64 ? header64.e_machine : header32.e_machine;
-    auto* p            = buf.begin();
+    auto executable = false;
+    for (const auto& [start, end] : executableZonesFAs)
+    {
+        if (offset >= start && offset < end)
+        {
+            executable = true;
+            break;
+        }
+    }
+    return GetColorForOpcode(offset, buf, executable, result);
+}
+
+bool ELFFile::GetColorsForRange(uint64 offset, uint64 size, BufferView buf, std::vector<GView::View::BufferViewer::BufferColor>& spans)
+{
+    CHECK(buf.IsValid(), false, "");
+    CHECK(showOpcodesMask != 0, true, ""); // nothing to color
+
+    // code is only colored for x86 / x86-64 - for the other machines the headers are still checked
+    static const std::vector<std::pair<uint64, uint64>> noZones;
+    const auto checkHeaders = (showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Header) == (uint32) GView::Dissasembly::Opcodes::Header;
+    auto colorOpcode        = [this](uint64 pos, BufferView view, bool executable, GView::View::BufferViewer::BufferColor& color) {
+        return GetColorForOpcode(pos, view, executable, color);
+    };
+    GView::View::BufferViewer::ColorRangeByZones(offset, size, buf, IsIntelMachine() ? executableZonesFAs : noZones, checkHeaders, colorOpcode, spans);
+    return true;
+}
+
+bool ELFFile::GetColorForOpcode(uint64 offset, BufferView buf, bool executable, GView::View::BufferViewer::BufferColor& result)
+{
+    auto* p = buf.begin();
     switch (*p)
     {
     case 0x7F:
@@ -603,26 +647,34 @@ bool ELFFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Buff
             }
         }
     default:
-        switch (machine)
+        if (executable && IsIntelMachine())
         {
-        case EM_386:
-        case EM_486:
-        case EM_860:
-        case EM_960:
-        case EM_8051:
-        case EM_X86_64:
-            for (const auto& [start, end] : executableZonesFAs)
-            {
-                if (offset >= start && offset < end)
-                {
-                    return GetColorForBufferIntel(offset, buf, result);
-                }
-            }
-            break;
-        default:
-            break;
+            return GetColorForBufferIntel(offset, buf, result);
         }
+        break;
     }
 
     return false;
 }
+
+bool ELFFile::Analyze(std::vector<std::pair<std::string, std::string>>& properties)
+{
+    CHECK(Update(), false, "");
+
+    LocalString<128> tmp;
+    const auto type    = is64 ? header64.e_type : header32.e_type;
+    const auto machine = is64 ? header64.e_machine : header32.e_machine;
+    const auto entry   = is64 ? header64.e_entry : (uint64) header32.e_entry;
+
+    properties.emplace_back("Class", is64 ? "ELF64" : "ELF32");
+    properties.emplace_back("Endianness", isLittleEndian ? "little" : "big");
+    properties.emplace_back("Type", GetNameAndDecriptionFromElfType(type).first);
+    properties.emplace_back("Machine", GetNameFromElfMachine(machine));
+    properties.emplace_back("EntryPoint", tmp.Format("0x%llX", entry));
+    properties.emplace_back("Segments", tmp.Format("%u", (uint32) (is64 ? segments64.size() : segments32.size())));
+    properties.emplace_back("Sections", tmp.Format("%u", (uint32) (is64 ? sections64.size() : sections32.size())));
+    properties.emplace_back("StaticSymbols", tmp.Format("%u", (uint32) staticSymbolsNames.size()));
+    properties.emplace_back("DynamicSymbols", tmp.Format("%u", (uint32) dynamicSymbolsNames.size()));
+
+    return true;
+}
@@ -206,6 +206,11 @@ class MachOFile : public TypeInterface,
     }
 
     void RunCommand(std::string_view) override;
+    bool Analyze(std::vector<std::pair<std::string, std::string>>& properties) override;
+    bool IsAnalyzeSupported() const override
+    {
+        return true;
+    }
 
   public:
     MachOFile(Reference<GView::Utils::DataCache> file);
@@ -243,6 +248,8 @@ private:
     bool ComputeHash(const Buffer& buffer, uint8 hashType, std::string& output) const;
 
     bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
+    bool GetColorsForRange(uint64 offset, uint64 size, BufferView buf, std::vector<GView::View::BufferViewer::BufferColor>& spans) override;
+    bool GetColorForOpcode(uint64 offset, BufferView buf, bool executable, GView::View::BufferViewer::BufferColor& result);
     bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
 
   public:
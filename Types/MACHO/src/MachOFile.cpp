@@ -1245,6 +1245,34 @@ bool MachOFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Bu
     result.color = ColorPair{ Color::Transparent, Color::Transparent };
     CHECK(showOpcodesMask != 0, false, "");
 
+    auto executable = false;
+    for (const auto& [start, end] : executableZonesFAs) {
+        if (offset >= start && offset < end) {
+            executable = true;
+            break;
+        }
+    }
+    return GetColorForOpcode(offset, buf, executable, result);
+}
+
+bool MachOFile::GetColorsForRange(uint64 offset, uint64 size, BufferView buf, std::vector<GView::View::BufferViewer::BufferColor>& spans)
+{
+    CHECK(buf.IsValid(), false, "");
+    CHECK(showOpcodesMask != 0, true, ""); // nothing to color
+    if ((header.cputype != MAC::CPU_TYPE_I386) && (header.cputype != MAC::CPU_TYPE_X86_64)) {
+        return true; // only x86 / x86-64 code is colored
+    }
+
+    const auto checkHeaders = (showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Header) == (uint32) GView::Dissasembly::Opcodes::Header;
+    auto colorOpcode        = [this](uint64 pos, BufferView view, bool executable, GView::View::BufferViewer::BufferColor& color) {
+        return GetColorForOpcode(pos, view, executable, color);
+    };
+    GView::View::BufferViewer::ColorRangeByZones(offset, size, buf, executableZonesFAs, checkHeaders, colorOpcode, spans);
+    return true;
+}
+
+bool MachOFile::GetColorForOpcode(uint64 offset, BufferView buf, bool executable, GView::View::BufferViewer::BufferColor& result)
+{
     switch (header.cputype) {
     case MAC::CPU_TYPE_I386:
     case MAC::CPU_TYPE_X86_64: {
@@ -1263,10 +1291,8 @@ bool MachOFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Bu
                 }
             }
         default:
-            for (const auto& [start, end] : executableZonesFAs) {
-                if (offset >= start && offset < end) {
-                    return GetColorForBufferIntel(offset, buf, result);
-                }
+            if (executable) {
+                return GetColorForBufferIntel(offset, buf, result);
             }
             break;
         }
@@ -1299,4 +1325,29 @@ void MachOFile::RunCommand(std::string_view commandName)
         }
     }
 }
+
+bool MachOFile::Analyze(std::vector<std::pair<std::string, std::string>>& properties)
+{
+    CHECK(Update(), false, "");
+
+    LocalString<128> tmp;
+    if (isFat) {
+        properties.emplace_back("Format", "Universal (fat)");
+        properties.emplace_back("Architectures", tmp.Format("%u", (uint32) archs.size()));
+        return true;
+    }
+
+    const auto& info = MAC::GetArchInfoFromCPUTypeAndSubtype(header.cputype, header.cpusubtype);
+    properties.emplace_back("Format", is64 ? "Mach-O 64" : "Mach-O");
+    properties.emplace_back("CPU Type", info.name);
+    properties.emplace_back("CPU Subtype", info.description);
+    const auto fileType = MAC::FileTypeNames.find(header.filetype);
+    properties.emplace_back("File Type", fileType != MAC::FileTypeNames.end() ? fileType->second : std::string_view{ tmp.Format("0x%X", header.filetype) });
+    properties.emplace_back("Load Commands", tmp.Format("%u", header.ncmds));
+    properties.emplace_back("Segments", tmp.Format("%u", (uint32) segments.size()));
+    properties.emplace_back("Dylibs", tmp.Format("%u", (uint32) dylibs.size()));
+    properties.emplace_back("Signed", codeSignature.has_value() ? "true" : "false");
+
+    return true;
+}
 } // namespace GView::Type::MachO
@@ -38,8 +38,36 @@ struct ConnectionCallbackInterface {
 };
 
 struct PayloadInformation {
-    StreamPayload* payload;
-    std::vector<StreamPacketData>* packets;
+    StreamData* stream;
+    GView::Utils::DataCache* cache;
+
+    /**
+     * \brief Size of the reassembled payload of the connection (both directions, in sequence order)
+     */
+    uint64 GetSize() const
+    {
+        return stream->totalPayload;
+    }
+    /**
+     * \brief Copy a part of the reassembled payload without building all of it (enough to check a signature)
+     * \return the number of bytes copied
+     */
+    uint32 Peek(uint64 position, uint8* buffer, uint32 size) const
+    {
+        return stream->CopyPayload(*cache, position, buffer, size);
+    }
+    /**
+     * \brief The reassembled payload as contiguous bytes. It is read from the capture on the first call and it is kept with the connection.
+     * \return nullptr if the payload can not be built
+     */
+    const StreamPayload* GetPayload() const
+    {
+        return stream->GetContiguousPayload(*cache);
+    }
+    const std::vector<StreamPacketData>& GetPackets() const
+    {
+        return stream->packetsOffsets;
+    }
 };
 
 struct PayloadDataParserInterface {
@@ -441,6 +441,12 @@ static const std::map<LinkType, std::string_view> LinkTypeDescriptions
 };
 // clang-format on
 
+static std::string_view GetLinkTypeName(LinkType type)
+{
+    const auto it = LinkTypeNames.find(type);
+    return it != LinkTypeNames.end() ? it->second : "Unknown";
+}
+
 struct Header
 {
     Magic magicNumber;   /* Used to detect the file format itself and the byte ordering. The writing application writes 0xa1b2c3d4 with it's
@@ -484,6 +490,173 @@ struct PacketHeader
 
 static_assert(sizeof(PacketHeader) == 16);
 
+static void Swap(PacketHeader& packetHeader)
+{
+    packetHeader.tsSec   = AppCUI::Endian::BigToNative(packetHeader.tsSec);
+    packetHeader.tsUsec  = AppCUI::Endian::BigToNative(packetHeader.tsUsec);
+    packetHeader.inclLen = AppCUI::Endian::BigToNative(packetHeader.inclLen);
+    packetHeader.origLen = AppCUI::Endian::BigToNative(packetHeader.origLen);
+}
+
+// an entry of the packet index: the packet bytes stay in the capture and are read only when they are needed
+struct PacketRecord
+{
+    uint64 offset;      // of the packet header (pcap) / of the packet block (pcapng)
+    uint32 size;        // of the packet header and data (pcap) / of the packet block (pcapng)
+    uint16 dataStart;   // the packet data is found at 'offset + dataStart'
+    uint16 interfaceId; // index in the interfaces of the capture
+    uint32 tsSec;
+    uint32 tsUsec;
+    uint32 inclLen;
+    uint32 origLen;
+};
+
+/*
+    PCAPNG
+    Section Header Block
+    Interface Description Block(s)
+    Enhanced Packet Block / Simple Packet Block / other blocks
+    ....
+    (Section Header Block - a new section, with its own byte order and interfaces)
+    ....
+*/
+
+constexpr uint32 PCAPNG_BYTE_ORDER_MAGIC         = 0x1A2B3C4D;
+constexpr uint32 PCAPNG_BYTE_ORDER_MAGIC_SWAPPED = 0x4D3C2B1A;
+constexpr uint16 PCAPNG_OPTION_END               = 0;
+constexpr uint16 PCAPNG_OPTION_IF_TSRESOL        = 9;
+
+enum class BlockType : uint32
+{
+    InterfaceDescription = 0x00000001,
+    ObsoletePacket       = 0x00000002,
+    SimplePacket         = 0x00000003,
+    NameResolution       = 0x00000004,
+    InterfaceStatistics  = 0x00000005,
+    EnhancedPacket       = 0x00000006,
+    DecryptionSecrets    = 0x0000000A,
+    SectionHeader        = 0x0A0D0D0A, // a palindrome => the same in both byte orders
+};
+
+static const std::map<BlockType, std::string_view> BlockTypeNames{
+    GET_PAIR_FROM_ENUM(BlockType::InterfaceDescription), GET_PAIR_FROM_ENUM(BlockType::ObsoletePacket),
+    GET_PAIR_FROM_ENUM(BlockType::SimplePacket),         GET_PAIR_FROM_ENUM(BlockType::NameResolution),
+    GET_PAIR_FROM_ENUM(BlockType::InterfaceStatistics),  GET_PAIR_FROM_ENUM(BlockType::EnhancedPacket),
+    GET_PAIR_FROM_ENUM(BlockType::DecryptionSecrets),    GET_PAIR_FROM_ENUM(BlockType::SectionHeader),
+};
+
+#pragma pack(push, 1)
+struct BlockHeader
+{
+    BlockType type;
+    uint32 totalLength; /* of the entire block (the trailing copy of this length included) */
+};
+
+struct SectionHeaderBlock
+{
+    BlockHeader header;
+    uint32 byteOrderMagic; /* 0x1A2B3C4D written in the byte order of the section */
+    uint16 versionMajor;
+    uint16 versionMinor;
+    int64 sectionLength; /* -1 if not specified */
+};
+
+struct InterfaceDescriptionBlock
+{
+    BlockHeader header;
+    uint16 linkType;
+    uint16 reserved;
+    uint32 snapLen;
+};
+
+struct EnhancedPacketBlock
+{
+    BlockHeader header;
+    uint32 interfaceId;
+    uint32 tsHigh; /* in units of the interface (if_tsresol, microseconds by default) */
+    uint32 tsLow;
+    uint32 capturedLen;
+    uint32 originalLen;
+};
+
+struct SimplePacketBlock
+{
+    BlockHeader header;
+    uint32 originalLen; /* captured length = min(originalLen, snapLen of the first interface, block data) */
+};
+
+struct ObsoletePacketBlock
+{
+    BlockHeader header;
+    uint16 interfaceId;
+    uint16 dropsCount;
+    uint32 tsHigh;
+    uint32 tsLow;
+    uint32 capturedLen;
+    uint32 originalLen;
+};
+
+struct BlockOption
+{
+    uint16 code;
+    uint16 length; /* the value is padded to 4 bytes */
+};
+#pragma pack(pop)
+
+static_assert(sizeof(BlockHeader) == 8);
+static_assert(sizeof(SectionHeaderBlock) == 24);
+static_assert(sizeof(InterfaceDescriptionBlock) == 16);
+static_assert(sizeof(EnhancedPacketBlock) == 28);
+static_assert(sizeof(SimplePacketBlock) == 12);
+static_assert(sizeof(ObsoletePacketBlock) == 28);
+
+constexpr uint32 PCAPNG_BLOCK_TRAILER_SIZE = sizeof(uint32);
+constexpr uint32 PCAPNG_MIN_BLOCK_SIZE     = sizeof(BlockHeader) + PCAPNG_BLOCK_TRAILER_SIZE;
+
+// an entry of the block index (pcapng), for the blocks that are not packets
+struct BlockRecord
+{
+    uint64 offset;
+    uint32 size;
+    BlockType type;
+};
+
+static void Swap(SectionHeaderBlock& shb)
+{
+    shb.header.totalLength = AppCUI::Endian::BigToNative(shb.header.totalLength);
+    shb.byteOrderMagic     = AppCUI::Endian::BigToNative(shb.byteOrderMagic);
+    shb.versionMajor       = AppCUI::Endian::BigToNative(shb.versionMajor);
+    shb.versionMinor       = AppCUI::Endian::BigToNative(shb.versionMinor);
+
+    const auto length = (uint64) shb.sectionLength;
+    shb.sectionLength = (int64) (((uint64) AppCUI::Endian::BigToNative((uint32) length) << 32) | AppCUI::Endian::BigToNative((uint32) (length >> 32)));
+}
+
+static void Swap(InterfaceDescriptionBlock& idb)
+{
+    idb.linkType = AppCUI::Endian::BigToNative(idb.linkType);
+    idb.snapLen  = AppCUI::Endian::BigToNative(idb.snapLen);
+}
+
+static void Swap(EnhancedPacketBlock& epb)
+{
+    epb.interfaceId = AppCUI::Endian::BigToNative(epb.interfaceId);
+    epb.tsHigh      = AppCUI::Endian::BigToNative(epb.tsHigh);
+    epb.tsLow       = AppCUI::Endian::BigToNative(epb.tsLow);
+    epb.capturedLen = AppCUI::Endian::BigToNative(epb.capturedLen);
+    epb.originalLen = AppCUI::Endian::BigToNative(epb.originalLen);
+}
+
+static void Swap(ObsoletePacketBlock& opb)
+{
+    opb.interfaceId = AppCUI::Endian::BigToNative(opb.interfaceId);
+    opb.dropsCount  = AppCUI::Endian::BigToNative(opb.dropsCount);
+    opb.tsHigh      = AppCUI::Endian::BigToNative(opb.tsHigh);
+    opb.tsLow       = AppCUI::Endian::BigToNative(opb.tsLow);
+    opb.capturedLen = AppCUI::Endian::BigToNative(opb.capturedLen);
+    opb.originalLen = AppCUI::Endian::BigToNative(opb.originalLen);
+}
+
 enum class EtherType : uint16 // https://www.liveaction.com/resources/glossary/ethertype-values
 {
     Unknown                                      = 0,
@@ -1966,11 +2139,13 @@ struct PacketData {
     std::optional<TransportLayerInfo> transportLayer; // TCP, UDP, etc. with structs: TCPHeader, UDPHeader, etc.
 };
 
+// the packet bytes are not kept in memory => the payload is referenced by its position in the capture
 struct StreamPacketData {
-    const PacketHeader* header;
-    StreamPayload payload;
+    uint32 packetIndex;   // in the capture
+    uint64 payloadOffset; // in the capture
+    uint32 payloadSize;
     StreamTCPOrder order;
-    PacketData packetData;
+    uint8 direction; // 0 = sent by the initiator of the connection, 1 = sent by the other endpoint
 
     // TODO
     bool operator<(const StreamPacketData& other) const
@@ -2031,6 +2206,62 @@ struct StreamTcpLayer
     }
 };
 
+// the endpoints of a connection, as found in the packet headers (network byte order)
+struct FlowKey
+{
+    uint8 addresses[2][16]; // IPv4 addresses use the first 4 bytes
+    uint16 ports[2];
+    uint16 ipProtocol;        // EtherType
+    uint16 transportProtocol; // IP_Protocol
+
+    // orders the endpoints so that both directions of a connection have the same key
+    void Canonicalize()
+    {
+        const auto result = memcmp(addresses[0], addresses[1], sizeof(addresses[0]));
+        if (result < 0 || (result == 0 && ports[0] <= ports[1]))
+            return;
+        std::swap(addresses[0], addresses[1]);
+        std::swap(ports[0], ports[1]);
+    }
+
+    bool operator==(const FlowKey& other) const
+    {
+        return memcmp(this, &other, sizeof(FlowKey)) == 0;
+    }
+};
+
+static_assert(sizeof(FlowKey) == 40);
+
+struct FlowKeyHash
+{
+    size_t operator()(const FlowKey& key) const noexcept
+    {
+        uint64 words[sizeof(FlowKey) / sizeof(uint64)];
+        memcpy(words, &key, sizeof(FlowKey));
+
+        uint64 hash = 0x9E3779B97F4A7C15ULL;
+        for (const auto word : words)
+        {
+            hash ^= word;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 32;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+// a piece of the reassembled payload of a connection
+struct StreamSegment
+{
+    static constexpr uint64 NOT_CAPTURED = static_cast<uint64>(-1); // a gap: the bytes are missing from the capture (read as 0)
+
+    uint64 offset; // in the capture
+    uint32 size;
+    uint8 direction;
+};
+
+constexpr uint32 STREAM_MAX_FILLED_GAP = 0x100000; // bigger gaps are only counted (most likely not lost data, but a jump of the sequence)
+
 // TODO: for the future maybe change structure for a more generic structure
 constexpr uint32 PCAP_MAX_SUMMARY_SIZE = 100;
 struct StreamData
@@ -2041,7 +2272,7 @@ struct StreamData
     uint16 ipProtocol                                        = INVALID_IP_PROTOCOL_VALUE;
     uint16 transportProtocol                                 = INVALID_TRANSPORT_PROTOCOL_VALUE;
     uint64 totalPayload                                      = 0;
-    std::string name                                         = {};
+    FlowKey flow                                             = {}; // the source of the first packet is the initiator
     bool isFinished                                          = false;
     uint8 finFlagsFound                                      = 0;
     std::string appLayerName                                 = "";
@@ -2050,7 +2281,16 @@ struct StreamData
     std::deque<StreamTcpLayer> applicationLayers;
     struct PayloadDataParserInterface* payloadParserFound = nullptr;
 
-    StreamPayload connPayload;
+    // the payload of both directions, in sequence order, as ranges of the capture (retransmitted bytes appear only once)
+    std::vector<StreamSegment> segments;
+    uint32 gapsCount          = 0;
+    uint64 missingBytes       = 0;
+    uint64 retransmittedBytes = 0;
+
+    // contiguous copy of 'segments', built only when a payload parser asks for it
+    StreamPayload connPayload = {};
+    std::unique_ptr<uint8[]> connPayloadBuffer;
+
     // Delete copy constructor and assignment operator
     StreamData(const StreamData&)            = delete;
     StreamData& operator=(const StreamData&) = delete;
@@ -2093,7 +2333,13 @@ struct StreamData
         std::sort(packetsOffsets.begin(), packetsOffsets.end());
     }
 
-    void ComputeFinalPayload();
+    // builds 'segments' from the packets (sets 'totalPayload' to the reassembled size)
+    void Reassemble();
+    // copies up to 'size' bytes of the reassembled payload, starting at 'position'
+    uint32 CopyPayload(GView::Utils::DataCache& cache, uint64 position, uint8* buffer, uint32 size) const;
+    const StreamPayload* GetContiguousPayload(GView::Utils::DataCache& cache);
+    // "ip:port -> ip:port" (only needed when the streams are listed => it is not kept)
+    std::string GetName() const;
     //void TryParsePayload();
 };
 
@@ -9,10 +9,20 @@ namespace GView::Type::PCAP
 class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateInterface, public View::ContainerViewer::OpenItemInterface
 {
   public:
-    Buffer data; // it's maximum 0xFFFF so just save it here
+    struct Interface
+    {
+        LinkType linkType;
+        uint32 snapLen;
+        uint64 tsUnitsPerSecond;
+    };
 
-    Header header;
-    std::vector<std::pair<PacketHeader*, uint32>> packetHeaders;
+    bool isPcapNG{ false };
+    Header header;                      // pcap
+    SectionHeaderBlock sectionHeader{}; // pcapng: the first section (native byte order)
+    uint32 sectionsCount{ 0 };
+    std::vector<Interface> interfaces; // pcap: a single one, described by the header
+    std::vector<BlockRecord> blocks;   // pcapng: the blocks that are not packets
+    std::vector<PacketRecord> packets; // memory scales with the packet count, not with the size of the capture
     StreamManager streamManager;
 
 	uint32 currentItemIndex{ 0 };
@@ -23,6 +33,19 @@ class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateIn
     ~PCAPFile() override = default;
 
     bool Update();
+    bool UpdatePcap();
+    bool UpdatePcapNG();
+    bool AddInterface(uint64 offset, uint32 blockSize, bool swapped);
+    bool AddPacketBlock(uint64 offset, BlockType type, uint32 blockSize, bool swapped, uint32 firstInterface);
+
+    LinkType GetLinkType(const PacketRecord& record) const
+    {
+        return record.interfaceId < interfaces.size() ? interfaces[record.interfaceId].linkType : header.network;
+    }
+
+    // the packet header (byte swapped if needed) followed by the captured bytes
+    Buffer GetPacket(uint32 index);
+    void AddPacketsToStreamManager();
 
     std::string_view GetTypeName() override
     {
@@ -31,6 +54,11 @@ class PCAPFile : public TypeInterface, public View::ContainerViewer::EnumerateIn
     void RunCommand(std::string_view) override
     {
     }
+    bool Analyze(std::vector<std::pair<std::string, std::string>>& properties) override;
+    bool IsAnalyzeSupported() const override
+    {
+        return true;
+    }
 
     virtual bool BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent) override;
     virtual bool PopulateItem(TreeViewItem item) override;
@@ -113,6 +141,7 @@ namespace Panels
 
         void UpdateGeneralInformation();
         void UpdatePcapHeader();
+        void UpdatePcapNGHeader();
         void UpdateIssues();
         void RecomputePanelsPositions();
 
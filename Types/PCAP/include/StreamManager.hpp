@@ -6,28 +6,42 @@ namespace GView::Type::PCAP
 {
 class StreamManager
 {
-    std::unordered_map<std::string, std::deque<StreamData>> streams;
+    struct Flow {
+        FlowKey key; // as found in the first packet
+        std::deque<StreamData> connections;
+    };
+    std::unordered_map<FlowKey, uint32, FlowKeyHash> flowIndexes; // canonical key -> index in 'flows'
+    std::vector<Flow> flows;                                      // in the order they appear in the capture
     std::vector<StreamData> finalStreams;
     std::vector<std::string> protocolsFound;
     std::vector<unique_ptr<PayloadDataParserInterface>> payloadParsers;
     Reference<GView::View::WindowInterface> window;
 
+    // the packet that is being added; its bytes are valid only during AddPacket
+    struct PacketSource {
+        uint32 index;      // in the capture
+        uint64 dataOffset; // of the first byte after the packet header
+        const uint8* data;
+    };
+
     // TODO: maybe sync functions with those used in Panels?
-    void Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet);
-    void Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet);
+    void Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketSource& packet);
+    void Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketSource& packet);
 
-    void Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet);
-    void Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet);
+    void Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketSource& packet);
+    void Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketSource& packet);
 
-    void Add_TCPHeader(PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet);
+    void Add_TCPHeader(PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketSource& packet);
 
     void AddToKnownProtocols(const std::string& layerName);
 
   public:
     StreamManager() = default;
 
-    void AddPacket(const PacketHeader* packet, LinkType network);
-    void FinishedAdding();
+    // 'data' = the captured bytes of the packet 'packetIndex', found at 'dataOffset' in the capture
+    void AddPacket(uint32 packetIndex, uint64 dataOffset, BufferView data, LinkType network);
+    // the payloads of the streams are read from 'cache' (the capture)
+    void FinishedAdding(GView::Utils::DataCache& cache);
     bool RegisterPayloadParser(unique_ptr<PayloadDataParserInterface> parser);
 
     void InitStreamManager(Reference<GView::View::WindowInterface> windowParam);
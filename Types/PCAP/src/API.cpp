@@ -28,24 +28,23 @@ struct ConnectionCallbackInterfaceImpl : public ConnectionCallbackInterface {
     }
 };
 
-void StreamManager::FinishedAdding()
+void StreamManager::FinishedAdding(GView::Utils::DataCache& cache)
 {
-    if (streams.empty())
+    if (flows.empty())
         return;
 
-    finalStreams.reserve(streams.size());
+    finalStreams.reserve(flows.size());
 
-    for (auto& [streamName, connections] : streams) {
+    for (auto& [key, connections] : flows) {
         for (auto& conn : connections) {
-            conn.name = streamName;
-            // conn.SortPackets();
-            conn.ComputeFinalPayload();
+            conn.flow = key;
+            conn.Reassemble();
 
             ConnectionCallbackInterfaceImpl callbackInterface = {};
             callbackInterface.streamData                      = &conn;
 
-            if (conn.connPayload.size) {
-                PayloadInformation payloadInfo{ &conn.connPayload, &conn.packetsOffsets };
+            if (conn.totalPayload) {
+                PayloadInformation payloadInfo{ &conn, &cache };
                 for (auto& parser : payloadParsers) {
                     auto result = parser->ParsePayload(payloadInfo, &callbackInterface);
                     if (result) {
@@ -61,5 +60,6 @@ void StreamManager::FinishedAdding()
         }
     }
 
-    streams.clear();
+    flowIndexes.clear();
+    flows.clear();
 }
\ No newline at end of file
@@ -35,6 +35,12 @@ extern "C"
     {
         CHECK(buf.GetLength() > sizeof(PCAP::Header), false, "");
 
+        auto shb = buf.GetObject<PCAP::SectionHeaderBlock>(0);
+        if (shb.IsValid() && shb->header.type == PCAP::BlockType::SectionHeader)
+        {
+            return shb->byteOrderMagic == PCAP::PCAPNG_BYTE_ORDER_MAGIC || shb->byteOrderMagic == PCAP::PCAPNG_BYTE_ORDER_MAGIC_SWAPPED;
+        }
+
         auto header = buf.GetObject<PCAP::Header>(0);
         CHECK(header.IsValid(), false, "");
 
@@ -56,16 +62,28 @@ extern "C"
     {
         BufferViewer::Settings settings;
 
-        auto offset = 0ULL;
-        settings.AddZone(offset, sizeof(pcap->header), ColorPair{ Color::Magenta, Color::DarkBlue }, "Header");
-        offset += sizeof(pcap->header);
+        LocalString<32> ls;
+        if (pcap->isPcapNG)
+        {
+            for (const auto& block : pcap->blocks)
+            {
+                const auto name = PCAP::BlockTypeNames.find(block.type);
+                if (name != PCAP::BlockTypeNames.end())
+                    settings.AddZone(block.offset, block.size, ColorPair{ Color::Magenta, Color::DarkBlue }, name->second);
+                else
+                    settings.AddZone(block.offset, block.size, ColorPair{ Color::Magenta, Color::DarkBlue }, ls.Format("Block_%X", (uint32) block.type));
+            }
+        }
+        else
+        {
+            settings.AddZone(0, sizeof(pcap->header), ColorPair{ Color::Magenta, Color::DarkBlue }, "Header");
+        }
 
         auto count = 0;
-        LocalString<32> ls;
-        for (const auto& [header, offset] : pcap->packetHeaders)
+        for (const auto& packet : pcap->packets)
         {
             const auto& c = *(colors.begin() + (count % 2));
-            settings.AddZone(offset, sizeof(PCAP::PacketHeader) + header->inclLen, c, ls.Format("Packet_%u", count));
+            settings.AddZone(packet.offset, packet.size, c, ls.Format("Packet_%u", count));
             count++;
         }
 
@@ -91,9 +109,7 @@ extern "C"
         settings.SetEnumerateCallback(win->GetObject()->GetContentType<GView::Type::PCAP::PCAPFile>().ToObjectRef<ContainerViewer::EnumerateInterface>());
         settings.SetOpenItemCallback(win->GetObject()->GetContentType<GView::Type::PCAP::PCAPFile>().ToObjectRef<ContainerViewer::OpenItemInterface>());
 
-        for (const auto& [header, offset] : pcap->packetHeaders)
-            pcap->streamManager.AddPacket(header, pcap->header.network);
-        pcap->streamManager.FinishedAdding();
+        pcap->AddPacketsToStreamManager();
 
 		const auto properties = pcap->GetPropertiesForContainerView();
         for (const auto& property : properties)
@@ -122,8 +138,8 @@ extern "C"
 
     PLUGIN_EXPORT void UpdateSettings(IniSection sect)
     {
-        sect["Pattern"]     = { "magic:A1 B2 C3 D4", "magic:D4 C3 B2 A1" };
-        sect["Extension"]   = "pcap";
+        sect["Pattern"]     = { "magic:A1 B2 C3 D4", "magic:D4 C3 B2 A1", "magic:0A 0D 0D 0A" };
+        sect["Extension"]   = { "pcap", "pcapng" };
         sect["Priority"]    = 1;
         sect["Description"] = "Network Packet capture file format";
     }
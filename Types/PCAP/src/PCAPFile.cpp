@@ -2,34 +2,294 @@
 
 using namespace GView::Type::PCAP;
 
+constexpr uint64 DEFAULT_TS_UNITS_PER_SECOND = 1000000; // microseconds
+
 PCAPFile::PCAPFile()
 {
 }
 
 bool PCAPFile::Update()
 {
-    auto offset = 0;
+    packets.clear();
+    blocks.clear();
+    interfaces.clear();
+    sectionsCount = 0;
+
+    BlockType firstBlock;
+    CHECK(obj->GetData().Copy<BlockType>(0, firstBlock), false, "");
+    isPcapNG = firstBlock == BlockType::SectionHeader;
+
+    return isPcapNG ? UpdatePcapNG() : UpdatePcap();
+}
+
+bool PCAPFile::UpdatePcap()
+{
+    uint64 offset = 0;
     CHECK(obj->GetData().Copy<Header>(offset, header), false, "");
     offset += sizeof(Header);
     if (header.magicNumber == Magic::Swapped)
     {
         Swap(header);
     }
+    interfaces.push_back({ header.network, header.snaplen, DEFAULT_TS_UNITS_PER_SECOND });
 
-    // TODO: check for future, is this really ok? test with big pcap files
-    data = obj->GetData().CopyToBuffer(offset, (uint32) obj->GetData().GetSize() - offset);
-    CHECK(data.IsValid(), false, "");
+    // only the packet headers are read (sequentially, through the cache) => the packet bytes are loaded on demand
+    auto& cache         = obj->GetData();
+    const auto fileSize = cache.GetSize();
+    CHECK(fileSize > offset, false, "");
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
 
-    const auto delta = offset;
-    do
+    PacketHeader packetHeader{};
+    while (offset + sizeof(PacketHeader) <= fileSize)
     {
-        const auto& [header, _] = packetHeaders.emplace_back((PacketHeader*) (data.GetData() + offset - delta), offset);
-        offset += (sizeof(PacketHeader) + header->origLen);
-    } while (offset < obj->GetData().GetSize());
+        CHECKBK(cache.Copy<PacketHeader>(offset, packetHeader), "Fail to read packet header at %llu", offset);
+        if (header.magicNumber == Magic::Swapped)
+        {
+            Swap(packetHeader);
+        }
+        CHECKBK(offset + sizeof(PacketHeader) + packetHeader.inclLen <= fileSize, "Truncated packet at %llu", offset);
+        CHECKBK(packetHeader.inclLen <= 0xFFFFFFFF - sizeof(PacketHeader), "Invalid packet size at %llu", offset);
+        CHECKBK(packets.size() < 0xFFFFFFFF, "Too many packets");
+
+        const auto size = (uint32) sizeof(PacketHeader) + packetHeader.inclLen;
+        packets.push_back(
+              { offset, size, sizeof(PacketHeader), 0, packetHeader.tsSec, packetHeader.tsUsec, packetHeader.inclLen, packetHeader.origLen });
+        offset += size;
+    }
 
     return true;
 }
 
+static uint64 GetTimestampUnits(uint8 tsResolution)
+{
+    // MSB = 0 => a negative power of 10, MSB = 1 => a negative power of 2
+    const auto exponent = tsResolution & 0x7F;
+    if (tsResolution & 0x80)
+        return exponent < 64 ? (1ULL << exponent) : 0;
+
+    uint64 units = 1;
+    for (auto i = 0; i < exponent; i++)
+    {
+        if (units > 0xFFFFFFFFFFFFFFFFULL / 10)
+            return 0;
+        units *= 10;
+    }
+    return units;
+}
+
+static void SetTimestamp(PacketRecord& record, uint64 timestamp, uint64 unitsPerSecond)
+{
+    record.tsSec  = (uint32) (timestamp / unitsPerSecond);
+    record.tsUsec = (uint32) ((double) (timestamp % unitsPerSecond) * 1000000.0 / (double) unitsPerSecond);
+}
+
+bool PCAPFile::UpdatePcapNG()
+{
+    // the block structure is walked once (sequentially, through the cache) => the packet bytes are loaded on demand
+    auto& cache         = obj->GetData();
+    const auto fileSize = cache.GetSize();
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+
+    bool swapped          = false;
+    uint32 firstInterface = 0; // the interface ids of the packets are relative to their section
+    uint64 offset         = 0;
+    while (offset + PCAPNG_MIN_BLOCK_SIZE <= fileSize)
+    {
+        BlockHeader block{};
+        CHECKBK(cache.Copy<BlockHeader>(offset, block), "Fail to read block header at %llu", offset);
+        if (block.type == BlockType::SectionHeader)
+        {
+            SectionHeaderBlock shb{};
+            CHECKBK(cache.Copy<SectionHeaderBlock>(offset, shb), "Fail to read section header at %llu", offset);
+            CHECKBK(shb.byteOrderMagic == PCAPNG_BYTE_ORDER_MAGIC || shb.byteOrderMagic == PCAPNG_BYTE_ORDER_MAGIC_SWAPPED,
+                    "Invalid byte order magic at %llu",
+                    offset);
+            swapped = shb.byteOrderMagic == PCAPNG_BYTE_ORDER_MAGIC_SWAPPED;
+            if (swapped)
+            {
+                Swap(shb);
+            }
+            if (sectionsCount == 0)
+            {
+                sectionHeader = shb;
+            }
+            sectionsCount++;
+            firstInterface    = (uint32) interfaces.size();
+            block.totalLength = shb.header.totalLength;
+        }
+        else if (swapped)
+        {
+            block.type        = (BlockType) AppCUI::Endian::BigToNative((uint32) block.type);
+            block.totalLength = AppCUI::Endian::BigToNative(block.totalLength);
+        }
+
+        const auto blockSize = block.totalLength;
+        CHECKBK(blockSize >= PCAPNG_MIN_BLOCK_SIZE && (blockSize % 4) == 0 && offset + blockSize <= fileSize, "Invalid block at %llu", offset);
+
+        if (block.type == BlockType::InterfaceDescription)
+        {
+            CHECKBK(AddInterface(offset, blockSize, swapped), "Invalid interface description block at %llu", offset);
+        }
+        if (block.type == BlockType::EnhancedPacket || block.type == BlockType::SimplePacket || block.type == BlockType::ObsoletePacket)
+        {
+            CHECKBK(AddPacketBlock(offset, block.type, blockSize, swapped, firstInterface), "Invalid packet block at %llu", offset);
+        }
+        else
+        {
+            blocks.push_back({ offset, blockSize, block.type });
+        }
+        offset += blockSize;
+    }
+
+    return sectionsCount > 0;
+}
+
+bool PCAPFile::AddInterface(uint64 offset, uint32 blockSize, bool swapped)
+{
+    auto& cache = obj->GetData();
+    CHECK(blockSize >= sizeof(InterfaceDescriptionBlock) + PCAPNG_BLOCK_TRAILER_SIZE, false, "");
+
+    InterfaceDescriptionBlock idb{};
+    CHECK(cache.Copy<InterfaceDescriptionBlock>(offset, idb), false, "");
+    if (swapped)
+    {
+        Swap(idb);
+    }
+
+    Interface iface{ (LinkType) idb.linkType, idb.snapLen, DEFAULT_TS_UNITS_PER_SECOND };
+
+    // the only option needed is the timestamp resolution
+    const auto optionsSize = blockSize - (uint32) sizeof(InterfaceDescriptionBlock) - PCAPNG_BLOCK_TRAILER_SIZE;
+    const auto options     = optionsSize > 0 ? cache.Get(offset + sizeof(InterfaceDescriptionBlock), optionsSize, true) : BufferView();
+    for (uint32 position = 0; options.IsValid() && position + sizeof(BlockOption) <= options.GetLength();)
+    {
+        BlockOption option;
+        memcpy(&option, options.GetData() + position, sizeof(BlockOption));
+        if (swapped)
+        {
+            option.code   = AppCUI::Endian::BigToNative(option.code);
+            option.length = AppCUI::Endian::BigToNative(option.length);
+        }
+        if (option.code == PCAPNG_OPTION_END)
+            break;
+        if (option.code == PCAPNG_OPTION_IF_TSRESOL && option.length >= 1 && position + sizeof(BlockOption) < options.GetLength())
+        {
+            const auto units = GetTimestampUnits(options[position + sizeof(BlockOption)]);
+            if (units > 0)
+                iface.tsUnitsPerSecond = units;
+        }
+        position += sizeof(BlockOption) + ((option.length + 3U) & ~3U);
+    }
+
+    interfaces.push_back(iface);
+    return true;
+}
+
+bool PCAPFile::AddPacketBlock(uint64 offset, BlockType type, uint32 blockSize, bool swapped, uint32 firstInterface)
+{
+    auto& cache = obj->GetData();
+    CHECK(packets.size() < 0xFFFFFFFF, false, "Too many packets");
+
+    PacketRecord record{ offset, blockSize, 0, 0, 0, 0, 0, 0 };
+    uint32 interfaceId = 0;
+    uint64 timestamp   = 0;
+    if (type == BlockType::EnhancedPacket)
+    {
+        EnhancedPacketBlock epb{};
+        CHECK(blockSize >= sizeof(EnhancedPacketBlock) + PCAPNG_BLOCK_TRAILER_SIZE, false, "");
+        CHECK(cache.Copy<EnhancedPacketBlock>(offset, epb), false, "");
+        if (swapped)
+        {
+            Swap(epb);
+        }
+        record.dataStart = sizeof(EnhancedPacketBlock);
+        record.inclLen   = epb.capturedLen;
+        record.origLen   = epb.originalLen;
+        interfaceId      = epb.interfaceId;
+        timestamp        = ((uint64) epb.tsHigh << 32) | epb.tsLow;
+    }
+    else if (type == BlockType::ObsoletePacket)
+    {
+        ObsoletePacketBlock opb{};
+        CHECK(blockSize >= sizeof(ObsoletePacketBlock) + PCAPNG_BLOCK_TRAILER_SIZE, false, "");
+        CHECK(cache.Copy<ObsoletePacketBlock>(offset, opb), false, "");
+        if (swapped)
+        {
+            Swap(opb);
+        }
+        record.dataStart = sizeof(ObsoletePacketBlock);
+        record.inclLen   = opb.capturedLen;
+        record.origLen   = opb.originalLen;
+        interfaceId      = opb.interfaceId;
+        timestamp        = ((uint64) opb.tsHigh << 32) | opb.tsLow;
+    }
+    else
+    {
+        // no interface id (the first interface of the section) and no timestamp
+        SimplePacketBlock spb{};
+        CHECK(blockSize >= sizeof(SimplePacketBlock) + PCAPNG_BLOCK_TRAILER_SIZE, false, "");
+        CHECK(cache.Copy<SimplePacketBlock>(offset, spb), false, "");
+        record.dataStart = sizeof(SimplePacketBlock);
+        record.origLen   = swapped ? AppCUI::Endian::BigToNative(spb.originalLen) : spb.originalLen;
+        record.inclLen   = std::min<uint32>(record.origLen, blockSize - sizeof(SimplePacketBlock) - PCAPNG_BLOCK_TRAILER_SIZE);
+    }
+
+    CHECK(firstInterface + (uint64) interfaceId < interfaces.size(), false, "Unknown interface: %u", interfaceId);
+    const auto& iface  = interfaces[firstInterface + interfaceId];
+    record.interfaceId = (uint16) (firstInterface + interfaceId);
+    CHECK(record.interfaceId == firstInterface + interfaceId, false, "Too many interfaces");
+    if (type == BlockType::SimplePacket && iface.snapLen > 0)
+        record.inclLen = std::min<uint32>(record.inclLen, iface.snapLen);
+    CHECK(record.inclLen <= blockSize - record.dataStart - PCAPNG_BLOCK_TRAILER_SIZE, false, "Truncated packet");
+    SetTimestamp(record, timestamp, iface.tsUnitsPerSecond);
+
+    packets.push_back(record);
+    return true;
+}
+
+Buffer PCAPFile::GetPacket(uint32 index)
+{
+    CHECK(index < packets.size(), Buffer(), "");
+    const auto& record = packets[index];
+
+    // the bytes before the packet data are replaced by a PacketHeader (a pcapng simple packet block has only 12 bytes before its data,
+    // but it always follows at least a section header block => the read does not start before the file)
+    const auto dataOffset = record.offset + record.dataStart;
+    auto buffer           = obj->GetData().CopyToBuffer(dataOffset - sizeof(PacketHeader), sizeof(PacketHeader) + (uint64) record.inclLen);
+    CHECK(buffer.IsValid(), Buffer(), "Fail to read packet %u", index);
+
+    const PacketHeader packetHeader{ record.tsSec, record.tsUsec, record.inclLen, record.origLen };
+    memcpy(buffer.GetData(), &packetHeader, sizeof(PacketHeader));
+    return buffer;
+}
+
+void PCAPFile::AddPacketsToStreamManager()
+{
+    auto& cache = obj->GetData();
+    GView::Utils::DataCache::ReadAheadScope readAhead(cache);
+
+    Buffer largePacket;
+    for (uint32 index = 0; index < (uint32) packets.size(); index++)
+    {
+        const auto& record = packets[index];
+        if (record.inclLen == 0)
+            continue;
+
+        // the view is valid until the next read from the cache (the stream manager keeps only offsets)
+        const auto dataOffset = record.offset + record.dataStart;
+        auto data             = cache.Get(dataOffset, record.inclLen, true);
+        if (!data.IsValid())
+        {
+            // bigger than the cache
+            largePacket = cache.CopyToBuffer(dataOffset, record.inclLen);
+            CHECKBK(largePacket.IsValid(), "Fail to read packet %u", index);
+            data = largePacket;
+        }
+        streamManager.AddPacket(index, dataOffset, data, GetLinkType(record));
+    }
+    streamManager.FinishedAdding(cache);
+}
+
 constexpr uint64 ITEM_INVALID_VALUE = static_cast<uint64>(-1);
 
 bool PCAPFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
@@ -94,7 +354,7 @@ bool PCAPFile::PopulateItem(TreeViewItem item)
         item.SetData(currentItemIndex);
 
         item.SetText(tmp.Format("%s", n.ToString(streamIndex, NUMERIC_FORMAT).data()));
-        item.SetText(1, stream->name);
+        item.SetText(1, stream->GetName());
         item.SetText(2, stream->GetIpProtocolName());
         item.SetText(3, stream->GetTransportProtocolName());
         item.SetText(4, tmp.Format("%s", n.ToString(stream->totalPayload, NUMERIC_FORMAT).data()));
@@ -173,16 +433,37 @@ void PCAPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIt
 std::vector<std::pair<std::string, std::string>> PCAPFile::GetPropertiesForContainerView()
 {
     std::vector<std::pair<std::string, std::string>> result{};
-    result.reserve(4);
+    result.reserve(5);
 
     LocalString<32> tmp;
-    tmp.SetFormat("%hu.%hu", header.versionMajor, header.versionMinor);
-
     NumericFormatter n;
-    result.emplace_back("PCAP Version", tmp.GetText());
-    result.emplace_back("Total packets", n.ToString((uint32) packetHeaders.size(), NumericFormatFlags::None).data());
+    if (isPcapNG)
+    {
+        tmp.SetFormat("%hu.%hu", sectionHeader.versionMajor, sectionHeader.versionMinor);
+        result.emplace_back("PCAPNG Version", tmp.GetText());
+        result.emplace_back("Interfaces", n.ToString((uint32) interfaces.size(), NumericFormatFlags::None).data());
+    }
+    else
+    {
+        tmp.SetFormat("%hu.%hu", header.versionMajor, header.versionMinor);
+        result.emplace_back("PCAP Version", tmp.GetText());
+    }
+    result.emplace_back("Total packets", n.ToString((uint32) packets.size(), NumericFormatFlags::None).data());
     result.emplace_back("Total streams", n.ToString((uint32) streamManager.size(), NumericFormatFlags::None).data());
     result.emplace_back("Protocols", streamManager.GetProtocolsFound().data());
 
     return result;
 }
+
+bool PCAPFile::Analyze(std::vector<std::pair<std::string, std::string>>& properties)
+{
+    CHECK(Update(), false, "");
+
+    // no payload parsers are registered (they need a window to add their panels to)
+    AddPacketsToStreamManager();
+
+    for (auto& property : GetPropertiesForContainerView())
+        properties.emplace_back(std::move(property));
+
+    return true;
+}
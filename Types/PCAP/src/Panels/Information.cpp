@@ -27,9 +27,12 @@ void Information::UpdateGeneralInformation()
     AddDecAndHexElement("Size", "%-20s (%s)", pcap->obj->GetData().GetSize());
 
     general->AddItem("Header").SetType(ListViewItem::Type::Category);
-    UpdatePcapHeader();
+    if (pcap->isPcapNG)
+        UpdatePcapNGHeader();
+    else
+        UpdatePcapHeader();
 
-    AddDecAndHexElement("Packets #", "%-20s (%s)", (uint32) pcap->packetHeaders.size()).SetType(ListViewItem::Type::Emphasized_1);
+    AddDecAndHexElement("Packets #", "%-20s (%s)", (uint32) pcap->packets.size()).SetType(ListViewItem::Type::Emphasized_1);
 }
 
 void Information::UpdatePcapHeader()
@@ -55,6 +58,27 @@ void Information::UpdatePcapHeader()
           .SetType(ListViewItem::Type::Emphasized_2);
 }
 
+void Information::UpdatePcapNGHeader()
+{
+    LocalString<1024> ls;
+    NumericFormatter nf;
+
+    general->AddItem({ "Format", "pcapng" }).SetType(ListViewItem::Type::Emphasized_1);
+    AddDecAndHexElement("Version Major", "%-20s (%s)", pcap->sectionHeader.versionMajor);
+    AddDecAndHexElement("Version Minor", "%-20s (%s)", pcap->sectionHeader.versionMinor);
+    AddDecAndHexElement("Sections", "%-20s (%s)", pcap->sectionsCount);
+    AddDecAndHexElement("Interfaces", "%-20s (%s)", (uint32) pcap->interfaces.size());
+
+    LocalString<32> name;
+    for (uint32 i = 0; i < (uint32) pcap->interfaces.size(); i++)
+    {
+        const auto& iface   = pcap->interfaces[i];
+        const auto linkName = PCAP::GetLinkTypeName(iface.linkType);
+        const auto snapLen  = nf.ToString(iface.snapLen, dec);
+        general->AddItem({ name.Format("Interface #%u", i), ls.Format("%-20s (%u) Snaplen: %s", linkName.data(), (uint32) iface.linkType, snapLen.data()) });
+    }
+}
+
 void Information::UpdateIssues()
 {
 }
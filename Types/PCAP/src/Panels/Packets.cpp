@@ -8,6 +8,8 @@ using namespace AppCUI::Controls;
 using namespace AppCUI::Endian;
 using namespace AppCUI::Input;
 
+constexpr uint64 ITEM_INVALID_VALUE = static_cast<uint64>(-1);
+
 enum class ObjectAction : int32
 {
     GoTo       = 1,
@@ -48,17 +50,19 @@ std::string_view Packets::GetValue(NumericFormatter& n, uint64 value)
 
 void Panels::Packets::GoToSelectedSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
+    const auto index = list->GetCurrentItem().GetData(ITEM_INVALID_VALUE);
+    CHECKRET(index < pcap->packets.size(), "");
+    const auto offset = pcap->packets[index].offset;
 
     win->GetCurrentView()->GoTo(offset);
 }
 
 void Panels::Packets::SelectCurrentSection()
 {
-    auto record       = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto offset = record->second;
-    const auto size   = record->first->inclLen + sizeof(PacketHeader);
+    const auto index = list->GetCurrentItem().GetData(ITEM_INVALID_VALUE);
+    CHECKRET(index < pcap->packets.size(), "");
+    const auto offset = pcap->packets[index].offset;
+    const auto size   = pcap->packets[index].inclLen + sizeof(PacketHeader);
 
     win->GetCurrentView()->Select(offset, size);
 }
@@ -95,7 +99,7 @@ void Packets::PacketDialog::Add_PacketHeader(LinkType type, const PacketHeader*
     }
     list->AddItem({ "Original Length", tmp.Format("%s", GetValue(n, packet->origLen).data()) });
 
-    list->AddItem(LinkTypeNames.at(type).data()).SetType(ListViewItem::Type::Category);
+    list->AddItem(GetLinkTypeName(type).data()).SetType(ListViewItem::Type::Category);
 
     PacketData packetData = {};
     packetData.packet     = packet;
@@ -690,12 +694,17 @@ Panels::Packets::PacketDialog::PacketDialog(
 
 void Panels::Packets::OpenPacket()
 {
-    auto itemData      = list->GetCurrentItem().GetData<const std::pair<PacketHeader*, uint32>>();
-    const auto& packet = itemData->first;
+    const auto index = list->GetCurrentItem().GetData(ITEM_INVALID_VALUE);
+    CHECKRET(index < pcap->packets.size(), "");
+
+    // the packet bytes are read from the capture only now
+    const auto packet = pcap->GetPacket((uint32) index);
+    CHECKRET(packet.IsValid(), "");
 
     LocalString<128> ls;
     ls.Format("d:c,w:80,h:50", this->GetHeight());
-    PacketDialog dialog(nullptr, PCAP::LinkTypeNames.at(pcap->header.network).data(), ls.GetText(), pcap->header.network, packet, Base);
+    const auto linkType = pcap->GetLinkType(pcap->packets[index]);
+    PacketDialog dialog(nullptr, PCAP::GetLinkTypeName(linkType), ls.GetText(), linkType, (const PacketHeader*) packet.GetData(), Base);
     dialog.Show();
 }
 
@@ -706,10 +715,9 @@ void Panels::Packets::Update()
     LocalString<128> tmp;
     NumericFormatter n;
 
-    for (auto i = 0ULL; i < pcap->packetHeaders.size(); i++)
+    for (auto i = 0ULL; i < pcap->packets.size(); i++)
     {
-        auto& record                 = pcap->packetHeaders[i];
-        const auto& [header, offset] = record;
+        const auto header = &pcap->packets[i];
 
         auto timestamp = header->tsSec * (uint64) 1000000 + header->tsUsec;
         timestamp /= 1000000;
@@ -723,7 +731,7 @@ void Panels::Packets::Update()
         item.SetText(4, tmp.Format("%s", GetValue(n, header->inclLen).data()));
         item.SetText(5, tmp.Format("%s", GetValue(n, header->origLen).data()));
 
-        item.SetData<std::pair<PacketHeader*, uint32>>(&record);
+        item.SetData(i);
     }
 }
 
@@ -27,13 +27,17 @@ void GetFileExtracted(StreamTcpLayer& output)
 
 PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformation& payloadInformation, ConnectionCallbackInterface* callbackInterface)
 {
-    const auto connPayload = payloadInformation.payload;
-    if (payloadInformation.payload->size < 3)
+    uint8 signature[3];
+    if (payloadInformation.Peek(0, signature, sizeof(signature)) < sizeof(signature))
         return nullptr;
     for (int i = 0; i < 3; i++)
-        if (!isalpha(connPayload->location[i]))
+        if (!isalpha(signature[i]))
             return nullptr;
 
+    const auto connPayload = payloadInformation.GetPayload();
+    if (!connPayload)
+        return nullptr;
+
     auto& applicationLayers = callbackInterface->GetApplicationLayers();
 
     uint8 buffer[300]     = {};
@@ -55,6 +59,8 @@ PayloadDataParserInterface* HTTP::HTTPParser::ParsePayload(const PayloadInformat
             if (spaces >= 4) {
                 if (identified) {
                     if (layer.payload.size) {
+                        // the content of the last message may not be entirely captured
+                        layer.payload.size     = (uint32) std::min<uint64>(layer.payload.size, endPtr - startPtr);
                         layer.payload.location = (uint8*) startPtr;
                         // push
 
@@ -3,28 +3,158 @@
 
 using namespace GView::Type::PCAP;
 
-void StreamData::ComputeFinalPayload()
+void StreamData::Reassemble()
 {
-    if (totalPayload == 0)
-        return;
+    constexpr uint8 DIRECTIONS = 2;
+
+    // a piece of the payload of a direction; 'packet' (the arrival order) is used to interleave the two directions
+    struct Piece
+    {
+        StreamSegment segment;
+        uint32 packet;
+    };
+    std::vector<Piece> pieces[DIRECTIONS];
+    std::vector<uint32> order;
+
+    segments.clear();
+    gapsCount          = 0;
+    missingBytes       = 0;
+    retransmittedBytes = 0;
+
+    for (uint8 direction = 0; direction < DIRECTIONS; direction++)
+    {
+        order.clear();
+        for (uint32 index = 0; index < (uint32) packetsOffsets.size(); index++)
+            if (packetsOffsets[index].direction == direction && packetsOffsets[index].payloadSize > 0)
+                order.push_back(index);
+        if (order.empty())
+            continue;
 
-    uint8* payload = new uint8[totalPayload];
+        // positions relative to the first segment that arrived => the wrap around of the sequence numbers does not matter
+        const auto base     = packetsOffsets[order[0]].order.seqNumber;
+        const auto position = [&](uint32 index) { return (int64) (int32) (packetsOffsets[index].order.seqNumber - base); };
+        std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) { return position(a) < position(b); });
 
-    auto payloadPtr = payload;
-    for (const auto& packet : packetsOffsets)
-        if (packet.payload.location)
+        auto next = position(order[0]);
+        for (const auto index : order)
         {
-            memcpy(payloadPtr, packet.payload.location, packet.payload.size);
-            payloadPtr += packet.payload.size;
+            const auto& packet = packetsOffsets[index];
+            const auto start   = position(index);
+            const auto end     = start + packet.payloadSize;
+            if (end <= next)
+            {
+                // retransmission
+                retransmittedBytes += packet.payloadSize;
+                continue;
+            }
+            if (start > next)
+            {
+                gapsCount++;
+                missingBytes += start - next;
+                if (start - next <= STREAM_MAX_FILLED_GAP)
+                    pieces[direction].push_back({ { StreamSegment::NOT_CAPTURED, (uint32) (start - next), direction }, index });
+                next = start;
+            }
+            // overlap with the data that was already added
+            const auto skip = (uint32) (next - start);
+            retransmittedBytes += skip;
+            pieces[direction].push_back({ { packet.payloadOffset + skip, packet.payloadSize - skip, direction }, index });
+            next = end;
         }
+    }
+
+    // each direction stays in sequence order, the directions alternate in the order the data was sent
+    totalPayload = 0;
+    segments.reserve(pieces[0].size() + pieces[1].size());
+    size_t current[DIRECTIONS] = { 0, 0 };
+    while (current[0] < pieces[0].size() || current[1] < pieces[1].size())
+    {
+        uint8 direction = current[0] < pieces[0].size() ? 0 : 1;
+        if (direction == 0 && current[1] < pieces[1].size() && pieces[1][current[1]].packet < pieces[0][current[0]].packet)
+            direction = 1;
+        const auto& segment = pieces[direction][current[direction]++].segment;
+        segments.push_back(segment);
+        totalPayload += segment.size;
+    }
+}
+
+uint32 StreamData::CopyPayload(GView::Utils::DataCache& cache, uint64 position, uint8* buffer, uint32 size) const
+{
+    uint32 copied   = 0;
+    uint64 segStart = 0;
+    for (const auto& segment : segments)
+    {
+        if (copied == size)
+            break;
+        const auto segEnd = segStart + segment.size;
+        if (position + copied < segEnd)
+        {
+            const auto skip  = position + copied - segStart;
+            const auto count = (uint32) std::min<uint64>(segment.size - skip, size - copied);
+            auto destination = buffer + copied;
+            auto left        = count;
+            if (segment.offset != StreamSegment::NOT_CAPTURED)
+            {
+                cache.ForEachChunk(segment.offset + skip, count, [&destination, &left](uint64, BufferView chunk) {
+                    memcpy(destination, chunk.GetData(), chunk.GetLength());
+                    destination += chunk.GetLength();
+                    left -= (uint32) chunk.GetLength();
+                    return true;
+                });
+            }
+            // gaps (and bytes that can not be read) are 0
+            memset(destination, 0, left);
+            copied += count;
+        }
+        segStart = segEnd;
+    }
+    return copied;
+}
+
+const StreamPayload* StreamData::GetContiguousPayload(GView::Utils::DataCache& cache)
+{
+    if (connPayload.location)
+        return &connPayload;
+    CHECK(totalPayload > 0 && totalPayload <= 0xFFFFFFFF, nullptr, "Invalid payload size: %llu", totalPayload);
+
+    connPayloadBuffer = std::unique_ptr<uint8[]>(new uint8[totalPayload]);
+    const auto size   = (uint32) totalPayload;
+    CHECK(CopyPayload(cache, 0, connPayloadBuffer.get(), size) == size, nullptr, "");
+
+    connPayload.size     = size;
+    connPayload.location = connPayloadBuffer.get();
+    return &connPayload;
+}
 
-    connPayload.size     = (uint32) totalPayload;
-    connPayload.location = payload;
+std::string StreamData::GetName() const
+{
+    LocalString<64> ips[2], ports[2];
+    NumericFormatter n;
+    for (uint32 i = 0; i < 2; i++)
+    {
+        if (flow.ipProtocol == static_cast<uint16>(EtherType::IPv4))
+        {
+            uint32 ipv4;
+            memcpy(&ipv4, flow.addresses[i], sizeof(ipv4));
+            Utils::IPv4ElementToStringNoHex(AppCUI::Endian::BigToNative(ipv4), ips[i]);
+        }
+        else if (flow.ipProtocol == static_cast<uint16>(EtherType::IPv6))
+        {
+            uint16 ipv6[8];
+            memcpy(ipv6, flow.addresses[i], sizeof(ipv6));
+            for (auto& value : ipv6)
+                value = AppCUI::Endian::BigToNative(value);
+            Utils::IPv6ElementToString(ipv6, ips[i]);
+        }
+        ports[i].Format("%s", n.ToString(AppCUI::Endian::BigToNative(flow.ports[i]), { NumericFormatFlags::None, 10, 3, '.' }).data());
+    }
 
-    //CallTransportLayerPlugins();
+    LocalString<256> name;
+    name.Format("%s:%s -> %s:%s", ips[0].GetText(), ports[0].GetText(), ips[1].GetText(), ports[1].GetText());
+    return name.GetText();
 }
 
-void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketHeader* packet)
+void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Package_EthernetHeader* peh, uint32 length, const PacketSource& packet)
 {
     auto pehRef = *peh;
     Swap(pehRef);
@@ -44,7 +174,7 @@ void StreamManager::Add_Package_EthernetHeader(PacketData* packetData, const Pac
     }
 }
 
-void StreamManager::Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketHeader* packet)
+void StreamManager::Add_Package_NullHeader(PacketData* packetData, const Package_NullHeader* pnh, uint32 length, const PacketSource& packet)
 {
     if (pnh->family_ip == NULL_FAMILY_IP)
     {
@@ -54,7 +184,7 @@ void StreamManager::Add_Package_NullHeader(PacketData* packetData, const Package
     }
 }
 
-void StreamManager::Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketHeader* packet)
+void StreamManager::Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv4, size_t packetInclLen, const PacketSource& packet)
 {
     if (ipv4->protocol == IP_Protocol::TCP)
     {
@@ -70,11 +200,11 @@ void StreamManager::Add_IPv4Header(PacketData* packetData, const IPv4Header* ipv
     }*/
 }
 
-void StreamManager::Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketHeader* packet)
+void StreamManager::Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv6, size_t packetInclLen, const PacketSource& packet)
 {
     if (ipv6->nextHeader == IP_Protocol::TCP)
     {
-        auto tcp = (TCPHeader*) ((uint8*) ipv6 + sizeof(IPv4Header));
+        auto tcp = (TCPHeader*) ((uint8*) ipv6 + sizeof(IPv6Header));
         packetData->transportLayer = { IP_Protocol::TCP, tcp };
         Add_TCPHeader(packetData, tcp, packetInclLen - sizeof(IPv6Header), ipv6, static_cast<uint32>(EtherType::IPv6), packet);
     }
@@ -87,39 +217,34 @@ void StreamManager::Add_IPv6Header(PacketData* packetData, const IPv6Header* ipv
 }
 
 void StreamManager::Add_TCPHeader(
-      PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketHeader* packet)
+      PacketData* packetData, const TCPHeader* tcp, size_t packetInclLen, const void* ipHeader, uint32 ipProto, const PacketSource& packet)
 {
-    const auto etherProto = static_cast<EtherType>(ipProto);
-    LocalString<64> srcIp, dstIp, srcPort, dstPort;
-    NumericFormatter n;
-    switch (etherProto)
+    // the key is made of the raw header fields => nothing is formatted per packet
+    FlowKey key{};
+    switch (static_cast<EtherType>(ipProto))
     {
     case EtherType::IPv4:
     {
         auto* ip = (const IPv4Header*) ipHeader;
-
-        auto ipv4Ref = *ip;
-        Swap(ipv4Ref);
-
-        Utils::IPv4ElementToStringNoHex(ipv4Ref.sourceAddress, srcIp);
-        Utils::IPv4ElementToStringNoHex(ipv4Ref.destinationAddress, dstIp);
+        memcpy(key.addresses[0], &ip->sourceAddress, sizeof(ip->sourceAddress));
+        memcpy(key.addresses[1], &ip->destinationAddress, sizeof(ip->destinationAddress));
         break;
     }
     case EtherType::IPv6:
     {
         auto* ip = (const IPv6Header*) ipHeader;
-
-        auto ipv6Ref = *ip;
-        Swap(ipv6Ref);
-
-        Utils::IPv6ElementToString(ipv6Ref.sourceAddress, srcIp);
-        Utils::IPv6ElementToString(ipv6Ref.destinationAddress, dstIp);
+        memcpy(key.addresses[0], ip->sourceAddress, sizeof(ip->sourceAddress));
+        memcpy(key.addresses[1], ip->destinationAddress, sizeof(ip->destinationAddress));
         break;
     }
     default:
         // TODO: in the future add an error
         return;
     }
+    key.ports[0]          = tcp->sPort;
+    key.ports[1]          = tcp->dPort;
+    key.ipProtocol        = (uint16) ipProto;
+    key.transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
 
     const bool hasRstFlag = (tcp->flags & RST) > 0;
     const bool hasFinFlag = (tcp->flags & FIN) > 0;
@@ -134,53 +259,30 @@ void StreamManager::Add_TCPHeader(
     if (tcp_header_len < sizeof(TCPHeader))
         return; // err: TODO improve this later
 
-    StreamPayload payload{};
+    uint64 payloadOffset = 0;
+    uint32 payloadSize   = 0;
     if (packetInclLen > tcp_header_len)
     {
-        payload.size     = static_cast<uint32>(packetInclLen) - tcp_header_len;
-        payload.location = ((uint8*) tcp + sizeof(TCPHeader) + options_len);
+        payloadSize   = static_cast<uint32>(packetInclLen) - tcp_header_len;
+        payloadOffset = packet.dataOffset + ((const uint8*) tcp + sizeof(TCPHeader) + options_len - packet.data);
     }
 
-    srcPort.Format("%s", n.ToString(tcpRef.sPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
-    dstPort.Format("%s", n.ToString(tcpRef.dPort, { NumericFormatFlags::None, 10, 3, '.' }).data());
-
-    StreamData* streamToAddTo = nullptr;
+    // both directions of a connection share the same flow
+    auto canonicalKey = key;
+    canonicalKey.Canonicalize();
+    const auto [flowIndex, isNewFlow] = flowIndexes.try_emplace(canonicalKey, (uint32) flows.size());
+    if (isNewFlow)
+        flows.push_back({ key, {} });
 
-    LocalString<256> streamName;
-    streamName.Format("%s:%s -> %s:%s", dstIp.GetText(), dstPort.GetText(), srcIp.GetText(), srcPort.GetText());
-    auto revStream = streams.find(streamName.GetText());
-    if (revStream != streams.end())
+    auto& connections = flows[flowIndex->second].connections;
+    if (connections.empty() || connections.back().isFinished)
     {
-        if (!revStream->second.back().isFinished)
-            streamToAddTo = &revStream->second.back();
-        else
-        {
-            revStream->second.emplace_back();
-            streamToAddTo                    = &revStream->second.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
-    }
-    else
-    {
-        const auto name     = streamName.Format("%s:%s -> %s:%s", srcIp.GetText(), srcPort.GetText(), dstIp.GetText(), dstPort.GetText());
-        auto& currentStream = streams[name.data()];
-        if (currentStream.empty())
-        {
-            currentStream.emplace_back();
-            streamToAddTo                    = &currentStream.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
-        streamToAddTo = &currentStream.back();
-        if (streamToAddTo->isFinished)
-        {
-            currentStream.emplace_back();
-            streamToAddTo                    = &currentStream.back();
-            streamToAddTo->ipProtocol        = (uint16) ipProto;
-            streamToAddTo->transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
-        }
+        connections.emplace_back();
+        connections.back().ipProtocol        = (uint16) ipProto;
+        connections.back().transportProtocol = static_cast<uint16>(IP_Protocol::TCP);
     }
+    StreamData* streamToAddTo = &connections.back();
+    const uint8 direction     = key == flows[flowIndex->second].key ? 0 : 1;
 
     if (hasRstFlag)
         streamToAddTo->isFinished = true;
@@ -190,13 +292,13 @@ void StreamManager::Add_TCPHeader(
         streamToAddTo->isFinished = true;
 
     StreamTCPOrder order{};
-    order.seqNumber   = tcp->seq;
-    order.ackNumber   = tcp->ack;
-    order.maxNumber   = std::max(tcp->seq, tcp->ack);
+    order.seqNumber   = tcpRef.seq;
+    order.ackNumber   = tcpRef.ack;
+    order.maxNumber   = std::max(tcpRef.seq, tcpRef.ack);
     order.packetIndex = (uint32) streamToAddTo->packetsOffsets.size();
 
-    streamToAddTo->totalPayload += payload.size;
-    streamToAddTo->packetsOffsets.push_back({ packet, payload, order, *packetData });
+    streamToAddTo->totalPayload += payloadSize;
+    streamToAddTo->packetsOffsets.push_back({ packet.index, payloadOffset, payloadSize, order, direction });
 }
 
 void StreamManager::AddToKnownProtocols(const std::string& layerName)
@@ -209,21 +311,23 @@ void StreamManager::AddToKnownProtocols(const std::string& layerName)
     protocolsFound.push_back(layerName);
 }
 
-void StreamManager::AddPacket(const PacketHeader* packet, LinkType network)
+void StreamManager::AddPacket(uint32 packetIndex, uint64 dataOffset, BufferView data, LinkType network)
 {
+    const PacketSource packet{ packetIndex, dataOffset, data.GetData() };
+    const auto length = (uint32) data.GetLength();
+
     PacketData packetData = {};
-    packetData.packet     = packet;
     if (network == LinkType::ETHERNET)
     {
-        auto peh = (Package_EthernetHeader*) ((uint8*) packet + sizeof(PacketHeader));
+        auto peh = (Package_EthernetHeader*) data.GetData();
         packetData.physicalLayer = { LinkType::ETHERNET, peh };
-        Add_Package_EthernetHeader(&packetData, peh, packet->inclLen, packet);
+        Add_Package_EthernetHeader(&packetData, peh, length, packet);
     }
     if (network == LinkType::NULL_)
     {
-        auto pnh = (Package_NullHeader*) ((uint8*) packet + sizeof(PacketHeader));
+        auto pnh = (Package_NullHeader*) data.GetData();
         packetData.physicalLayer = { LinkType::NULL_, pnh };
-        Add_Package_NullHeader(&packetData, pnh, packet->inclLen, packet);
+        Add_Package_NullHeader(&packetData, pnh, length, packet);
     }
 }
 
@@ -847,6 +847,8 @@ namespace Type
             bool LoadIcon(const ResourceInformation& r, Image& img);
 
             bool GetColorForBuffer(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result) override;
+            bool GetColorsForRange(uint64 offset, uint64 size, BufferView buf, std::vector<GView::View::BufferViewer::BufferColor>& spans) override;
+            bool GetColorForOpcode(uint64 offset, BufferView buf, bool executable, GView::View::BufferViewer::BufferColor& result);
             bool GetColorForBufferIntel(uint64 offset, BufferView buf, GView::View::BufferViewer::BufferColor& result);
 
             std::string_view GetTypeName() override
@@ -854,6 +856,11 @@ namespace Type
                 return "PE";
             }
             void RunCommand(std::string_view) override;
+            bool Analyze(std::vector<std::pair<std::string, std::string>>& properties) override;
+            bool IsAnalyzeSupported() const override
+            {
+                return true;
+            }
 
             static std::string_view ResourceIDToName(ResourceType resType);
             static std::string_view LanguageIDToName(uint32 langID);
@@ -2110,6 +2110,47 @@ bool PEFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Buffe
     result.color = ColorPair{ Color::Transparent, Color::Transparent };
     CHECK(showOpcodesMask != 0, false, "");
 
+    auto executable = false;
+    for (const auto& [start, end] : executableZonesFAs)
+    {
+        if (offset >= start && offset < end)
+        {
+            executable = true;
+            break;
+        }
+    }
+    return GetColorForOpcode(offset, buf, executable, result);
+}
+
+bool PEFile::GetColorsForRange(uint64 offset, uint64 size, BufferView buf, std::vector<GView::View::BufferViewer::BufferColor>& spans)
+{
+    CHECK(buf.IsValid(), false, "");
+    CHECK(showOpcodesMask != 0, true, ""); // nothing to color
+
+    // code is only colored for x86 / x86-64 - for the other machines the headers are still checked
+    static const std::vector<std::pair<uint64, uint64>> noZones;
+    auto isIntel = false;
+    switch ((PE::MachineType) nth32.FileHeader.Machine)
+    {
+    case PE::MachineType::I386:
+    case PE::MachineType::IA64:
+    case PE::MachineType::AMD64:
+        isIntel = true;
+        break;
+    default:
+        break;
+    }
+
+    const auto checkHeaders = (showOpcodesMask & (uint32) GView::Dissasembly::Opcodes::Header) == (uint32) GView::Dissasembly::Opcodes::Header;
+    auto colorOpcode        = [this](uint64 pos, BufferView view, bool executable, GView::View::BufferViewer::BufferColor& color) {
+        return GetColorForOpcode(pos, view, executable, color);
+    };
+    GView::View::BufferViewer::ColorRangeByZones(offset, size, buf, isIntel ? executableZonesFAs : noZones, checkHeaders, colorOpcode, spans);
+    return true;
+}
+
+bool PEFile::GetColorForOpcode(uint64 offset, BufferView buf, bool executable, GView::View::BufferViewer::BufferColor& result)
+{
     auto* p = buf.begin();
     switch (*p)
     {
@@ -2149,12 +2190,9 @@ bool PEFile::GetColorForBuffer(uint64 offset, BufferView buf, GView::View::Buffe
         case PE::MachineType::I386:
         case PE::MachineType::IA64:
         case PE::MachineType::AMD64:
-            for (const auto& [start, end] : executableZonesFAs)
+            if (executable)
             {
-                if (offset >= start && offset < end)
-                {
-                    return GetColorForBufferIntel(offset, buf, result);
-                }
+                return GetColorForBufferIntel(offset, buf, result);
             }
             break;
         default:
@@ -2213,3 +2251,36 @@ void PEFile::RunCommand(std::string_view commandName)
         ah.Show();
     }
 }
+
+bool PEFile::Analyze(std::vector<std::pair<std::string, std::string>>& properties)
+{
+    CHECK(Update(), false, "");
+
+    LocalString<128> tmp;
+    std::string_view type = "EXE";
+    if (isMetroApp)
+        type = "Metro APP";
+    else if ((nth32.FileHeader.Characteristics & __IMAGE_FILE_DLL) != 0)
+        type = "DLL";
+
+    properties.emplace_back("Type", tmp.Format("%.*s (%s)", (int) type.size(), type.data(), GetSubsystem().data()));
+    properties.emplace_back("Machine", GetMachine());
+    properties.emplace_back("Format", hdr64 ? "PE32+" : "PE32");
+    properties.emplace_back("EntryPoint", tmp.Format("0x%llX", (uint64) rvaEntryPoint));
+    properties.emplace_back("Sections", tmp.Format("%u", nrSections));
+    properties.emplace_back("Computed", tmp.Format("%llu", computedSize));
+    properties.emplace_back("Memory", tmp.Format("%llu", virtualComputedSize));
+    if (computedSize < obj->GetData().GetSize())
+        properties.emplace_back("Overlay", tmp.Format("%llu", obj->GetData().GetSize() - computedSize));
+    properties.emplace_back("ImportedDlls", tmp.Format("%u", (uint32) impDLL.size()));
+    properties.emplace_back("ImportedFunctions", tmp.Format("%u", (uint32) impFunc.size()));
+    properties.emplace_back("Exports", tmp.Format("%u", (uint32) exp.size()));
+    properties.emplace_back("Resources", tmp.Format("%u", (uint32) res.size()));
+    if (dllName.Len() > 0)
+        properties.emplace_back("ExportName", dllName.ToStringView());
+    if (pdbName.Len() > 0)
+        properties.emplace_back("PDB File", pdbName.ToStringView());
+    properties.emplace_back("TLS", hasTLS ? "true" : "false");
+
+    return true;
+}
@@ -29,6 +29,11 @@ class ZIPFile : public TypeInterface, public View::ContainerViewer::EnumerateInt
     void RunCommand(std::string_view) override
     {
     }
+    bool Analyze(std::vector<std::pair<std::string, std::string>>& properties) override;
+    bool IsAnalyzeSupported() const override
+    {
+        return true;
+    }
 
     virtual bool BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent) override;
     virtual bool PopulateItem(TreeViewItem item) override;
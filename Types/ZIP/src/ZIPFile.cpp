@@ -28,6 +28,36 @@ bool ZIPFile::Update()
     return true;
 }
 
+bool ZIPFile::Analyze(std::vector<std::pair<std::string, std::string>>& properties)
+{
+    CHECK(Update(), false, "");
+
+    uint32 files = 0, directories = 0, encrypted = 0;
+    uint64 compressed = 0, uncompressed = 0;
+    for (uint32 i = 0; i < info.GetCount(); i++) {
+        GView::Decoding::ZIP::Entry entry{};
+        CHECKBK(info.GetEntry(i, entry), "");
+        if (entry.GetType() == GView::Decoding::ZIP::EntryType::Directory) {
+            directories++;
+            continue;
+        }
+        files++;
+        encrypted += entry.IsEncrypted() ? 1 : 0;
+        compressed += entry.GetCompressedSize();
+        uncompressed += entry.GetUncompressedSize();
+    }
+
+    LocalString<64> tmp;
+    properties.emplace_back("Entries", tmp.Format("%u", info.GetCount()));
+    properties.emplace_back("Files", tmp.Format("%u", files));
+    properties.emplace_back("Directories", tmp.Format("%u", directories));
+    properties.emplace_back("Encrypted", tmp.Format("%u", encrypted));
+    properties.emplace_back("CompressedSize", tmp.Format("%llu", compressed));
+    properties.emplace_back("UncompressedSize", tmp.Format("%llu", uncompressed));
+
+    return true;
+}
+
 bool ZIPFile::BeginIteration(std::u16string_view path, AppCUI::Controls::TreeViewItem parent)
 {
     const auto count = this->info.GetCount();
@@ -237,10 +267,7 @@ void ZIPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
         if (isTopContainer) {
             decompressed = this->info.Decompress(buffer, (uint32) index, password);
         } else {
-            const auto cache = obj->GetData().GetEntireFile();
-            if (cache.IsValid()) {
-                decompressed = this->info.Decompress(cache, buffer, (uint32) index, password);
-            }
+            decompressed = this->info.Decompress(obj->GetData(), buffer, (uint32) index, password);
         }
 
         if (decompressed) {
@@ -276,10 +303,7 @@ void ZIPFile::OnOpenItem(std::u16string_view path, AppCUI::Controls::TreeViewIte
         if (isTopContainer) {
             decompressed = this->info.Decompress(buffer, (uint32) index, pd.GetPassword());
         } else {
-            const auto cache = obj->GetData().GetEntireFile();
-            if (cache.IsValid()) {
-                decompressed = this->info.Decompress(cache, buffer, (uint32) index, pd.GetPassword());
-            }
+            decompressed = this->info.Decompress(obj->GetData(), buffer, (uint32) index, pd.GetPassword());
         }
 
         if (decompressed) {